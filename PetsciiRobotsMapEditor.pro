@@ -1,6 +1,6 @@
 TEMPLATE = subdirs
 
-SUBDIRS = src
+SUBDIRS = src bench
 
 OTHER_FILES += \
     src/res/NimbusSansNarrow-Bold.otf \
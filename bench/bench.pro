@@ -0,0 +1,30 @@
+TEMPLATE = app
+QT       += concurrent core gui svg testlib widgets
+CONFIG += c++17 testcase no_testcase_installs
+CONFIG -= debug_and_release_target app_bundle
+TARGET = bench
+
+# the benchmarks build the editor's sources, except its main()
+INCLUDEPATH += ../src
+SOURCES += $$files(../src/*.cpp)
+SOURCES -= ../src/main.cpp
+HEADERS += $$files(../src/*.h)
+FORMS += $$files(../src/*.ui)
+SOURCES += benchmarks.cpp
+
+RESOURCES += \
+    ../res/res.qrc
+
+tracing {
+    DEFINES += ENABLE_TRACING
+}
+DEFINES += APP_VERSION=bench GITREV=bench RES_DIR=\\\"$$PWD/../res\\\"
+
+win32:contains(QMAKE_CXX, cl) {
+	QMAKE_CXXFLAGS += -permissive- -wd4715 -wd4267
+}
+
+# "make benchmark" writes the results to benchmarks.xml, for tracking them over time
+benchmark.commands = ./$$TARGET -o benchmarks.xml,xml -o -,txt
+benchmark.depends = $$TARGET
+QMAKE_EXTRA_TARGETS += benchmark
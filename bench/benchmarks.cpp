@@ -0,0 +1,585 @@
+#include <QAction>
+#include <QApplication>
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QtTest>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include "constants.h"
+#include "map.h"
+#include "mapcheck.h"
+#include "mapclipboard.h"
+#include "mapcompositor.h"
+#include "mapcontroller.h"
+#include "mapwidget.h"
+#include "tile.h"
+#include "tileblitter.h"
+#include "tileset.h"
+#include "wallengine.h"
+
+
+/** @class Benchmarks
+ * Benchmarks for the hot paths of the editor: loading and saving maps, tile
+ * operations, tilesets, rendering and validation.
+ *
+ * They run on the sample maps created by #makeSampleMap(), which range from
+ * open terrain to a dense maze. If the environment variable
+ * `PETMAP_BENCH_MAPS` names a directory, the maps in it are used instead.
+ *
+ * Run `make benchmark` to write the results to `benchmarks.xml`, or pass
+ * QtTest's options such as `-o results.csv,csv` to the `bench` executable.
+ * The offscreen platform is used unless `QT_QPA_PLATFORM` says otherwise.
+ */
+class Benchmarks : public QObject {
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+
+	void mapLoad_data();
+	void mapLoad();
+	void mapSave_data();
+	void mapSave();
+	void mapFloodFill_data();
+	void mapFloodFill();
+	void wallDraw_data();
+	void wallDraw();
+	void wallRewall_data();
+	void wallRewall();
+
+	void tilesetConstruct();
+	void tilesetLoad_data();
+	void tilesetLoad();
+	void tilesetSetPalette();
+
+	void widgetMakeTilesImage_data();
+	void widgetMakeTilesImage();
+	void widgetPaint_data();
+	void widgetPaint();
+	void widgetFloatingSelectionOnLoad();
+	void blitTiles_data();
+	void blitTiles();
+	void composeMap_data();
+	void composeMap();
+
+	void mapCheckCheck_data();
+	void mapCheckCheck();
+	void mapCheckFixAll_data();
+	void mapCheckFixAll();
+	void objectsBulk_data();
+	void objectsBulk();
+
+private:
+	void addMapRows();
+	static void makeSampleMap(Map &map, int wallPercent, quint32 seed);
+	static void blitPerTile(QImage *target, const Map &map, const Tileset &tileset);
+
+	QTemporaryDir _directory;
+	QStringList _mapPaths;
+	Tileset _tileset;
+};
+
+
+static constexpr uint8_t TILE_FLOOR = 0x09;
+static constexpr uint8_t TILE_DIRT = 0xce;
+static constexpr uint8_t TILE_GRASS = 0xd0;
+
+
+void Benchmarks::initTestCase() {
+	const QString directory = qEnvironmentVariable("PETMAP_BENCH_MAPS");
+	if (not directory.isEmpty()) {
+		const QDir dir(directory);
+		for (const QString &fileName : dir.entryList({ "*.petmap", "level-*" }, QDir::Files, QDir::Name)) {
+			_mapPaths.append(dir.filePath(fileName));
+		}
+		QVERIFY2(not _mapPaths.isEmpty(), "PETMAP_BENCH_MAPS contains no maps");
+	} else {
+		QVERIFY(_directory.isValid());
+		const std::pair<const char*, int> samples[] = { { "open", 5 }, { "rooms", 20 }, { "maze", 45 } };
+		for (const auto &sample : samples) {
+			Map map;
+			makeSampleMap(map, sample.second, qHash(QByteArray(sample.first)));
+			const QString path = _directory.filePath(QString("%1.petmap").arg(sample.first));
+			QCOMPARE(map.save(path), QString());
+			_mapPaths.append(path);
+		}
+	}
+	QCOMPARE(_tileset.load(RES_DIR "/tileset.pet"), QString());
+}
+
+
+void Benchmarks::mapLoad_data() {
+	addMapRows();
+}
+
+
+void Benchmarks::mapLoad() {
+	QFETCH(QString, path);
+	Map map;
+	QBENCHMARK {
+		map.load(path);
+	}
+}
+
+
+void Benchmarks::mapSave_data() {
+	addMapRows();
+}
+
+
+void Benchmarks::mapSave() {
+	QFETCH(QString, path);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	const QString outputPath = _directory.filePath("saved.petmap");
+	QBENCHMARK {
+		map.save(outputPath);
+	}
+}
+
+
+void Benchmarks::mapFloodFill_data() {
+	addMapRows();
+}
+
+
+/** Fills the area the player stands on and back again. */
+void Benchmarks::mapFloodFill() {
+	QFETCH(QString, path);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	const QPoint position = map.object(MapObject::IdPlayer).pos();
+	const uint8_t tileNo = map.tileNo(position);
+	const uint8_t otherTileNo = tileNo == TILE_GRASS ? TILE_DIRT : TILE_GRASS;
+	QBENCHMARK {
+		map.floodFill(position, otherTileNo);
+		map.floodFill(position, tileNo);
+	}
+}
+
+
+void Benchmarks::wallDraw_data() {
+	addMapRows();
+}
+
+
+/** Draws a wall along the map's diagonal. */
+void Benchmarks::wallDraw() {
+	QFETCH(QString, path);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	std::vector<uint8_t> tiles(map.tiles(), map.tiles() + map.width() * map.height());
+	WallEngine engine(tiles.data(), map.width(), map.height());
+	QBENCHMARK {
+		for (int i = 0; i < map.height(); ++i) {
+			engine.drawWall(QPoint(i * 2, i));
+		}
+	}
+}
+
+
+void Benchmarks::wallRewall_data() {
+	addMapRows();
+}
+
+
+void Benchmarks::wallRewall() {
+	QFETCH(QString, path);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	std::vector<uint8_t> tiles(map.tiles(), map.tiles() + map.width() * map.height());
+	WallEngine engine(tiles.data(), map.width(), map.height());
+	QBENCHMARK {
+		engine.rewall(map.rect());
+	}
+}
+
+
+/** Creating a tileset is part of the editor's startup. */
+void Benchmarks::tilesetConstruct() {
+	QBENCHMARK {
+		Tileset tileset;
+	}
+}
+
+
+void Benchmarks::tilesetLoad_data() {
+	QTest::addColumn<QString>("path");
+	QTest::newRow("pet") << QString(RES_DIR "/tileset.pet");
+	QTest::newRow("c64") << QString(RES_DIR "/tileset.c64");
+}
+
+
+void Benchmarks::tilesetLoad() {
+	QFETCH(QString, path);
+	Tileset tileset;
+	QBENCHMARK {
+		tileset.load(path);
+	}
+}
+
+
+void Benchmarks::tilesetSetPalette() {
+	Tileset tileset;
+	QCOMPARE(tileset.load(RES_DIR "/tileset.c64"), QString());
+	QBENCHMARK {
+		for (Tileset::Palette palette : Tileset::palettes()) {
+			tileset.setPalette(palette);
+		}
+	}
+}
+
+
+void Benchmarks::widgetMakeTilesImage_data() {
+	addMapRows();
+}
+
+
+/** Renders the map after changing a tile, including redrawing the tiles
+ * image in the background and waiting for it. #composeMap() measures the
+ * drawing alone.
+ */
+void Benchmarks::widgetMakeTilesImage() {
+	QFETCH(QString, path);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	MapWidget widget;
+	widget.setTileset(&_tileset);
+	widget.setMap(&map);
+	widget.resize(widget.sizeHint());
+	QImage image(widget.size(), QImage::Format_ARGB32_Premultiplied);
+	const uint8_t tileNo = map.tileNo(QPoint(0, 0));
+	bool toggle = false;
+	QBENCHMARK {
+		toggle = not toggle;
+		map.setTile(QPoint(0, 0), toggle ? TILE_DIRT : tileNo);
+		widget.waitForTilesImage();
+		widget.render(&image);
+	}
+}
+
+
+void Benchmarks::widgetPaint_data() {
+	addMapRows();
+}
+
+
+/** Renders the map with all images up to date. */
+void Benchmarks::widgetPaint() {
+	QFETCH(QString, path);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	MapWidget widget;
+	widget.setTileset(&_tileset);
+	widget.setMap(&map);
+	widget.setShowGridLines(true);
+	widget.resize(widget.sizeHint());
+	QImage image(widget.size(), QImage::Format_ARGB32_Premultiplied);
+	widget.render(&image);
+	QBENCHMARK {
+		widget.render(&image);
+	}
+}
+
+
+/** Not a benchmark: a floating selection lifted from one map must not end
+ * up in the next one loaded.
+ */
+void Benchmarks::widgetFloatingSelectionOnLoad() {
+	QVERIFY(_mapPaths.size() >= 2);
+	Map map;
+	QCOMPARE(map.load(_mapPaths[0]), QString());
+	MapWidget widget;
+	widget.setTileset(&_tileset);
+	widget.setMap(&map);
+	widget.resize(widget.sizeHint());
+	const QRect rect(2, 2, 16, 8);
+	widget.setFloatingSelection(MapClipboard::fromMap(map, rect, true, true), QPoint(20, 20));
+	QVERIFY(widget.hasFloatingSelection());
+	
+	QCOMPARE(map.load(_mapPaths[1]), QString());
+	QVERIFY(not widget.hasFloatingSelection());
+	bool dropped = false;
+	connect(&widget, &MapWidget::floatingSelectionDropped, this, [&dropped]() { dropped = true; });
+	QTest::mouseClick(&widget, Qt::LeftButton, Qt::NoModifier, QPoint(4, 4));
+	QVERIFY(not dropped);
+	
+	QFile file(_mapPaths[1]);
+	QVERIFY(file.open(QFile::ReadOnly));
+	QCOMPARE(map.data(), file.readAll());
+	QVERIFY(not map.isModified());
+}
+
+
+void Benchmarks::blitTiles_data() {
+	QTest::addColumn<QString>("path");
+	QTest::addColumn<int>("implementation");
+	for (const QString &path : _mapPaths) {
+		const QString name = QFileInfo(path).completeBaseName();
+		QTest::newRow(qPrintable(name + "/per-tile")) << path << -1;
+		for (TileBlitter::Implementation implementation : TileBlitter::implementations()) {
+			if (not TileBlitter::isSupported(implementation)) { continue; }
+			QTest::newRow(qPrintable(name + "/" + TileBlitter::toString(implementation)))
+			        << path << int(implementation);
+		}
+	}
+}
+
+
+/** Composes the whole tiles image of a map, either with a TileBlitter or
+ * with a row memcpy() per tile as MapWidget used to. The result must match
+ * the latter.
+ */
+void Benchmarks::blitTiles() {
+	QFETCH(QString, path);
+	QFETCH(int, implementation);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	const QSize size(map.width() * _tileset.tileSize().width(), map.height() * _tileset.tileSize().height());
+	QImage expected(size, IMAGE_FORMAT);
+	blitPerTile(&expected, map, _tileset);
+	QImage image(size, IMAGE_FORMAT);
+	if (implementation < 0) {
+		QBENCHMARK {
+			blitPerTile(&image, map, _tileset);
+		}
+	} else {
+		const TileBlitter blitter(static_cast<TileBlitter::Implementation>(implementation));
+		QBENCHMARK {
+			blitter.blit(&image, map, _tileset);
+		}
+	}
+	QCOMPARE(image, expected);
+}
+
+
+void Benchmarks::composeMap_data() {
+	QTest::addColumn<QString>("path");
+	QTest::addColumn<int>("threads");
+	for (const QString &path : _mapPaths) {
+		for (int threads : { 1, 2, 4, 8 }) {
+			QTest::newRow(qPrintable(QString("%1/%2 threads").arg(QFileInfo(path).completeBaseName()).arg(threads)))
+			        << path << threads;
+		}
+	}
+}
+
+
+/** Draws the tiles image with MapCompositor, limiting the thread pool to
+ * \a threads threads, to see how well it scales. Rows with more threads
+ * than the CPU has cores show the overhead of oversubscription.
+ */
+void Benchmarks::composeMap() {
+	QFETCH(QString, path);
+	QFETCH(int, threads);
+	Map map;
+	QCOMPARE(map.load(path), QString());
+	QThreadPool *pool = QThreadPool::globalInstance();
+	const int maxThreadCount = pool->maxThreadCount();
+	pool->setMaxThreadCount(threads);
+	MapCompositor compositor;
+	QBENCHMARK {
+		compositor.compose(map, _tileset);
+		compositor.waitForFinished();
+	}
+	pool->setMaxThreadCount(maxThreadCount);
+	
+	QImage expected(compositor.image()->size(), IMAGE_FORMAT);
+	blitPerTile(&expected, map, _tileset);
+	QCOMPARE(*compositor.image(), expected);
+}
+
+
+void Benchmarks::mapCheckCheck_data() {
+	addMapRows();
+}
+
+
+void Benchmarks::mapCheckCheck() {
+	QFETCH(QString, path);
+	MapController controller;
+	QCOMPARE(controller.load(path), QString());
+	MapCheck check(controller, _tileset);
+	QBENCHMARK {
+		check.check();
+	}
+}
+
+
+void Benchmarks::mapCheckFixAll_data() {
+	addMapRows();
+}
+
+
+/** Checks and fixes the map. As fixing modifies it, each iteration starts by
+ * reloading it from memory, which is cheap compared to the rest.
+ */
+void Benchmarks::mapCheckFixAll() {
+	QFETCH(QString, path);
+	QFile file(path);
+	QVERIFY(file.open(QFile::ReadOnly));
+	const QByteArray data = file.readAll();
+	MapController controller;
+	QBENCHMARK {
+		controller.loadData(data);
+		MapCheck check(controller, _tileset);
+		check.check();
+		check.fixAll();
+	}
+}
+
+
+void Benchmarks::objectsBulk_data() {
+	addMapRows();
+}
+
+
+/** Deletes all objects in the left half of the map as a single undo step.
+ * Each iteration starts by reloading the map from memory, as the deletion
+ * modifies it.
+ */
+void Benchmarks::objectsBulk() {
+	QFETCH(QString, path);
+	QFile file(path);
+	QVERIFY(file.open(QFile::ReadOnly));
+	const QByteArray data = file.readAll();
+	MapController controller;
+	const Map &map = *controller.map();
+	const QRect rect(0, 0, map.width() / 2, map.height());
+	
+	QCOMPARE(controller.loadData(data), QString());
+	const std::vector<MapObject::id_t> inRect = map.objectIndex().objectsIn(rect);
+	controller.deleteObjects(rect);
+	QVERIFY(map.objectIndex().objectsIn(rect).empty());
+	controller.undoAction()->trigger();
+	QCOMPARE(map.objectIndex().objectsIn(rect), inRect);
+	
+	QBENCHMARK {
+		controller.loadData(data);
+		controller.deleteObjects(rect);
+	}
+}
+
+
+void Benchmarks::addMapRows() {
+	QTest::addColumn<QString>("path");
+	for (const QString &path : _mapPaths) {
+		QTest::newRow(qPrintable(QFileInfo(path).completeBaseName())) << path;
+	}
+}
+
+
+/** The baseline for #blitTiles(): copies each tile in turn, one pixel row at
+ * a time.
+ */
+void Benchmarks::blitPerTile(QImage *target, const Map &map, const Tileset &tileset) {
+	const QSize tileSize = tileset.tileSize();
+	uchar *dst = target->bits();
+	for (int y = 0; y < map.height(); ++y) {
+		for (int x = 0; x < map.width(); ++x) {
+			const QImage tileImage = tileset.tile(map.tileNo(QPoint(x, y))).image();
+			const uchar *src = tileImage.bits();
+			for (int py = 0; py < tileSize.height(); ++py) {
+				memcpy(&dst[(y * tileSize.height() + py) * target->bytesPerLine() + x * tileImage.bytesPerLine()],
+				       &src[py * tileImage.bytesPerLine()],
+				       tileImage.bytesPerLine());
+			}
+		}
+	}
+}
+
+
+/** Creates a map that resembles a real one: rooms separated by walls with
+ * gaps in them, patches of dirt and grass, and a player, robots and items.
+ * About \a wallPercent of the walls of a grid of rooms are present.
+ */
+void Benchmarks::makeSampleMap(Map &map, int wallPercent, quint32 seed) {
+	QRandomGenerator random(seed);
+	const int width = map.width();
+	const int height = map.height();
+	std::vector<uint8_t> tiles(width * height, TILE_FLOOR);
+	for (int i = 0; i < 40; ++i) {
+		const int x = random.bounded(width - 8);
+		const int y = random.bounded(height - 6);
+		const uint8_t tileNo = random.bounded(2) ? TILE_DIRT : TILE_GRASS;
+		for (int dy = 0; dy < 6; ++dy) {
+			std::fill_n(&tiles[x + width * (y + dy)], 8, uint8_t(tileNo + random.bounded(2)));
+		}
+	}
+
+	WallEngine engine(tiles.data(), width, height);
+	for (int x = 0; x < width; ++x) {
+		engine.drawWall(QPoint(x, 0));
+		engine.drawWall(QPoint(x, height - 1));
+	}
+	for (int y = 0; y < height; ++y) {
+		engine.drawWall(QPoint(0, y));
+		engine.drawWall(QPoint(width - 1, y));
+	}
+	static constexpr int ROOM = 8;
+	for (int y = ROOM; y < height - 1; y += ROOM) {
+		for (int x = ROOM; x < width - 1; x += ROOM) {
+			// a wall to the left and one upwards of the corner, each with a gap
+			if (int(random.bounded(100)) < wallPercent) {
+				for (int i = 0; i < ROOM; ++i) {
+					if (i != ROOM / 2) { engine.drawWall(QPoint(x - i, y)); }
+				}
+			}
+			if (int(random.bounded(100)) < wallPercent) {
+				for (int i = 0; i < ROOM; ++i) {
+					if (i != ROOM / 2) { engine.drawWall(QPoint(x, y - i)); }
+				}
+			}
+		}
+	}
+	map.setTiles(map.rect(), tiles.data());
+
+	const auto placeOnFloor = [&](MapObject &object) {
+		do {
+			object.x = random.bounded(width);
+			object.y = random.bounded(height);
+		} while (tiles[object.x + width * object.y] != TILE_FLOOR);
+	};
+	MapObject player(MapObject::UnitType::Player);
+	player.health = 12;
+	placeOnFloor(player);
+	map.setObject(MapObject::IdPlayer, player);
+	for (MapObject::id_t id = MapObject::IdRobotMin; id <= MapObject::IdRobotMax; ++id) {
+		static const MapObject::UnitType robots[] = {
+			MapObject::UnitType::HoverbotLR, MapObject::UnitType::HoverbotUD,
+			MapObject::UnitType::HoverbotAttack, MapObject::UnitType::RollerbotLR,
+			MapObject::UnitType::RollerbotUD, MapObject::UnitType::Evilbot
+		};
+		MapObject robot(robots[random.bounded(int(std::size(robots)))]);
+		robot.health = 10;
+		placeOnFloor(robot);
+		map.setObject(id, robot);
+	}
+	for (MapObject::id_t id = MapObject::IdHiddenMin; id < MapObject::IdHiddenMin + 8; ++id) {
+		MapObject item(MapObject::UnitType::Medkit);
+		item.a = 20;
+		item.c = 1;
+		item.d = 1;
+		placeOnFloor(item);
+		map.setObject(id, item);
+	}
+}
+
+
+int main(int argc, char *argv[]) {
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication app(argc, argv);
+	Benchmarks benchmarks;
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "benchmarks.moc"
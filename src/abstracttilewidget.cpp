@@ -25,6 +25,9 @@ void AbstractTileWidget::setTileset(const Tileset *tileset) {
 	if (_tileset) { disconnect(_tileset); }
 	_tileset = tileset;
 	connect(_tileset, &Tileset::changed, [&]() { tilesetChanged(); });
+	connect(_tileset, &Tileset::tilesChanged, [&](const std::vector<uint8_t> &tileNos) {
+		tilesChanged(tileNos);
+	});
 	tilesetChanged();
 }
 
@@ -104,6 +107,31 @@ bool AbstractTileWidget::showSelected() const {
 /// @}
 
 
+/** Called when only the tiles \a tileNos of the tileset have changed,
+ * because the tileset file was reloaded. Redraws everything by default.
+ */
+void AbstractTileWidget::tilesChanged(const std::vector<uint8_t> &tileNos) {
+	Q_UNUSED(tileNos);
+	tilesetChanged();
+}
+
+
+/** While there is no valid tileset, fills the visible part of the widget with
+ * a placeholder saying why. Returns whether it did, in which case there's
+ * nothing else to draw.
+ */
+bool AbstractTileWidget::drawPlaceholder() {
+	if (_tileset and _tileset->isValid()) { return false; }
+	QPainter painter(this);
+	painter.fillRect(rect(), C::colorPlaceholder);
+	painter.setPen(C::colorPlaceholderText);
+	const bool loading = _tileset and _tileset->isLoading();
+	painter.drawText(visibleRegion().boundingRect(), Qt::AlignCenter | Qt::TextWordWrap,
+	                 loading ? "Loading tileset..." : "No tileset loaded");
+	return true;
+}
+
+
 void AbstractTileWidget::drawMargin(QPainter &painter, const QRect &rect, int margin) {
 	Q_ASSERT(painter.pen().style() == Qt::NoPen);
 	QRect oRect = rect.adjusted(-margin, -margin, margin, margin);
@@ -4,6 +4,8 @@
 #include <QColor>
 #include <QFlags>
 #include <QWidget>
+#include <cstdint>
+#include <vector>
 #include "tile.h"
 
 class Tileset;
@@ -30,6 +32,7 @@ protected:
 	virtual void highlightAttributeChanged() = 0;
 	virtual void scaleChanged() = 0;
 	virtual void tilesetChanged() = 0;
+	virtual void tilesChanged(const std::vector<uint8_t> &tileNos);
 	bool showSelected() const;
 	
 	QColor highlightColor() const;
@@ -37,6 +40,7 @@ protected:
 	Tile::Attribute highlightAttribute() const;
 	double scale() const;
 	
+	bool drawPlaceholder();
 	static void drawMargin(QPainter &painter, const QRect &rect, int margin);
 	
 private:
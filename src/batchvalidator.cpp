@@ -0,0 +1,108 @@
+#include "batchvalidator.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <cstdio>
+#include "map.h"
+#include "mapcheck.h"
+#include "mapcontroller.h"
+#include "progressionsolver.h"
+#include "tileset.h"
+
+
+/** @class BatchValidator
+ * Validates map files from the command line, without opening the main
+ * window:
+ *
+ *     PetsciiRobotsMapEditor --validate [--tileset PATH] [--route] MAP...
+ *
+ * For every map, the problems found by MapCheck are listed, followed by
+ * whether the level can be completed and how long the ProgressionSolver took.
+ * With `--route`, the route to the exit is listed too.
+ *
+ * The exit code is 0 if no map has any errors, 1 if at least one does, and 2
+ * if the tileset or a map couldn't be loaded.
+ */
+
+
+static QString toString(MapCheck::Severity severity) {
+	switch (severity) {
+	case MapCheck::Severity::Silent: return "silent";
+	case MapCheck::Severity::Info: return "info";
+	case MapCheck::Severity::Warning: return "warning";
+	case MapCheck::Severity::Error: return "error";
+	}
+	return QString();
+}
+
+
+/** Run the validator with the command line \a arguments. Returns the exit
+ * code.
+ */
+int BatchValidator::run(const QStringList &arguments) {
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Validate PETSCII Robots maps.");
+	parser.addHelpOption();
+	const QCommandLineOption validateOption("validate", "Validate the maps and exit.");
+	const QCommandLineOption tilesetOption("tileset", "Load the tileset from <path>.", "path");
+	const QCommandLineOption routeOption("route", "List the route from the player to the exit.");
+	parser.addOption(validateOption);
+	parser.addOption(tilesetOption);
+	parser.addOption(routeOption);
+	parser.addPositionalArgument("maps", "The map files to validate.", "MAP...");
+	parser.process(arguments);
+	
+	QTextStream out(stdout);
+	QTextStream err(stderr);
+	
+	const QString tilesetPath = parser.isSet(tilesetOption) ? parser.value(tilesetOption)
+	                                                        : Tileset::bundledPath(false);
+	if (tilesetPath.isEmpty()) {
+		err << "cannot find the tileset (file \"tileset.pet\"), use --tileset" << '\n';
+		return 2;
+	}
+	Tileset tileset;
+	QString error = tileset.load(tilesetPath);
+	if (not error.isNull()) {
+		err << "could not load the tileset: " << error << '\n';
+		return 2;
+	}
+	
+	int result = 0;
+	for (const QString &path : parser.positionalArguments()) {
+		MapController mapController;
+		error = mapController.load(path);
+		if (not error.isNull()) {
+			err << path << ": " << error << '\n';
+			result = 2;
+			continue;
+		}
+		
+		MapCheck mapCheck(mapController, tileset);
+		for (const MapCheck::Problem &problem : mapCheck.problems()) {
+			out << path << ": " << toString(problem.severity);
+			if (problem.objectId != MapObject::IdNone) {
+				out << ": object " << problem.objectId;
+			}
+			out << ": " << problem.text << '\n';
+			if (problem.severity == MapCheck::Severity::Error and result == 0) {
+				result = 1;
+			}
+		}
+		
+		QElapsedTimer timer;
+		timer.start();
+		ProgressionSolver solver(*mapController.map(), tileset);
+		const bool solvable = solver.solve();
+		const qint64 nsecs = timer.nsecsElapsed();
+		out << path << ": " << (solvable ? "completable" : "not completable") << ", "
+		    << solver.regionCount() << " regions, solved in " << nsecs / 1000 << " us" << '\n';
+		if (solvable and parser.isSet(routeOption)) {
+			for (const QString &step : solver.describeSteps()) {
+				out << path << ":     " << step << '\n';
+			}
+		}
+	}
+	
+	return result;
+}
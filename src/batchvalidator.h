@@ -0,0 +1,12 @@
+#ifndef BATCHVALIDATOR_H
+#define BATCHVALIDATOR_H
+
+#include <QStringList>
+
+
+class BatchValidator {
+public:
+	static int run(const QStringList &arguments);
+};
+
+#endif // BATCHVALIDATOR_H
@@ -0,0 +1,537 @@
+#ifndef CHARACTERROM_H
+#define CHARACTERROM_H
+
+// generated by tools/make-character-rom.py, do not edit
+
+#include <cstdint>
+
+/** The glyphs of the PETSCII character sets, indexed by screen code. Each
+ * glyph has eight rows of eight pixels, the most significant bit being the
+ * leftmost pixel. A set bit is a foreground pixel.
+ */
+namespace CharacterRom {
+
+enum CharacterSet { Upper, Lower };
+
+static constexpr uint8_t GLYPHS[2][256][8] = {
+	{ // Upper
+		{ 0x1c, 0x22, 0x4a, 0x56, 0x4c, 0x20, 0x1e, 0x00 }, // 0x00
+		{ 0x18, 0x24, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00 }, // 0x01
+		{ 0x7c, 0x22, 0x22, 0x3c, 0x22, 0x22, 0x7c, 0x00 }, // 0x02
+		{ 0x1c, 0x22, 0x40, 0x40, 0x40, 0x22, 0x1c, 0x00 }, // 0x03
+		{ 0x78, 0x24, 0x22, 0x22, 0x22, 0x24, 0x78, 0x00 }, // 0x04
+		{ 0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x7e, 0x00 }, // 0x05
+		{ 0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x40, 0x00 }, // 0x06
+		{ 0x1c, 0x22, 0x40, 0x4e, 0x42, 0x22, 0x1c, 0x00 }, // 0x07
+		{ 0x42, 0x42, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00 }, // 0x08
+		{ 0x1c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00 }, // 0x09
+		{ 0x0e, 0x04, 0x04, 0x04, 0x04, 0x44, 0x38, 0x00 }, // 0x0a
+		{ 0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00 }, // 0x0b
+		{ 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7e, 0x00 }, // 0x0c
+		{ 0x42, 0x66, 0x5a, 0x5a, 0x42, 0x42, 0x42, 0x00 }, // 0x0d
+		{ 0x42, 0x62, 0x52, 0x4a, 0x46, 0x42, 0x42, 0x00 }, // 0x0e
+		{ 0x18, 0x24, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00 }, // 0x0f
+		{ 0x7c, 0x42, 0x42, 0x7c, 0x40, 0x40, 0x40, 0x00 }, // 0x10
+		{ 0x18, 0x24, 0x42, 0x42, 0x4a, 0x24, 0x1a, 0x00 }, // 0x11
+		{ 0x7c, 0x42, 0x42, 0x7c, 0x48, 0x44, 0x42, 0x00 }, // 0x12
+		{ 0x3c, 0x42, 0x40, 0x3c, 0x02, 0x42, 0x3c, 0x00 }, // 0x13
+		{ 0x3e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00 }, // 0x14
+		{ 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00 }, // 0x15
+		{ 0x42, 0x42, 0x42, 0x24, 0x24, 0x18, 0x18, 0x00 }, // 0x16
+		{ 0x42, 0x42, 0x42, 0x5a, 0x5a, 0x66, 0x42, 0x00 }, // 0x17
+		{ 0x42, 0x42, 0x24, 0x18, 0x24, 0x42, 0x42, 0x00 }, // 0x18
+		{ 0x22, 0x22, 0x22, 0x1c, 0x08, 0x08, 0x08, 0x00 }, // 0x19
+		{ 0x7e, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7e, 0x00 }, // 0x1a
+		{ 0x3c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x00 }, // 0x1b
+		{ 0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00 }, // 0x1c
+		{ 0x3c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x3c, 0x00 }, // 0x1d
+		{ 0x00, 0x08, 0x1c, 0x2a, 0x08, 0x08, 0x08, 0x08 }, // 0x1e
+		{ 0x00, 0x00, 0x10, 0x20, 0x7f, 0x20, 0x10, 0x00 }, // 0x1f
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x20
+		{ 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x00 }, // 0x21
+		{ 0x24, 0x24, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x22
+		{ 0x24, 0x24, 0x7e, 0x24, 0x7e, 0x24, 0x24, 0x00 }, // 0x23
+		{ 0x08, 0x1e, 0x28, 0x1c, 0x0a, 0x3c, 0x08, 0x00 }, // 0x24
+		{ 0x00, 0x62, 0x64, 0x08, 0x10, 0x26, 0x46, 0x00 }, // 0x25
+		{ 0x30, 0x48, 0x48, 0x30, 0x4a, 0x44, 0x3a, 0x00 }, // 0x26
+		{ 0x04, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x27
+		{ 0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00 }, // 0x28
+		{ 0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00 }, // 0x29
+		{ 0x08, 0x2a, 0x1c, 0x3e, 0x1c, 0x2a, 0x08, 0x00 }, // 0x2a
+		{ 0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00 }, // 0x2b
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x10 }, // 0x2c
+		{ 0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00 }, // 0x2d
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00 }, // 0x2e
+		{ 0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x00 }, // 0x2f
+		{ 0x3c, 0x42, 0x46, 0x5a, 0x62, 0x42, 0x3c, 0x00 }, // 0x30
+		{ 0x08, 0x18, 0x28, 0x08, 0x08, 0x08, 0x3e, 0x00 }, // 0x31
+		{ 0x3c, 0x42, 0x02, 0x0c, 0x30, 0x40, 0x7e, 0x00 }, // 0x32
+		{ 0x3c, 0x42, 0x02, 0x1c, 0x02, 0x42, 0x3c, 0x00 }, // 0x33
+		{ 0x04, 0x0c, 0x14, 0x24, 0x7e, 0x04, 0x04, 0x00 }, // 0x34
+		{ 0x7e, 0x40, 0x78, 0x04, 0x02, 0x44, 0x38, 0x00 }, // 0x35
+		{ 0x1c, 0x20, 0x40, 0x7c, 0x42, 0x42, 0x3c, 0x00 }, // 0x36
+		{ 0x7e, 0x42, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00 }, // 0x37
+		{ 0x3c, 0x42, 0x42, 0x3c, 0x42, 0x42, 0x3c, 0x00 }, // 0x38
+		{ 0x3c, 0x42, 0x42, 0x3e, 0x02, 0x04, 0x38, 0x00 }, // 0x39
+		{ 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00 }, // 0x3a
+		{ 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x10 }, // 0x3b
+		{ 0x0e, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0e, 0x00 }, // 0x3c
+		{ 0x00, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x00 }, // 0x3d
+		{ 0x70, 0x18, 0x0c, 0x06, 0x0c, 0x18, 0x70, 0x00 }, // 0x3e
+		{ 0x3c, 0x42, 0x02, 0x0c, 0x10, 0x00, 0x10, 0x00 }, // 0x3f
+		{ 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00 }, // 0x40
+		{ 0x08, 0x1c, 0x3e, 0x7f, 0x7f, 0x1c, 0x3e, 0x00 }, // 0x41
+		{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 }, // 0x42
+		{ 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00 }, // 0x43
+		{ 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x44
+		{ 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x45
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00 }, // 0x46
+		{ 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 }, // 0x47
+		{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 0x48
+		{ 0x00, 0x00, 0x00, 0x00, 0xe0, 0x10, 0x08, 0x08 }, // 0x49
+		{ 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0x00 }, // 0x4a
+		{ 0x08, 0x08, 0x08, 0x10, 0xe0, 0x00, 0x00, 0x00 }, // 0x4b
+		{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xff }, // 0x4c
+		{ 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 }, // 0x4d
+		{ 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 }, // 0x4e
+		{ 0xff, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // 0x4f
+		{ 0xff, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 }, // 0x50
+		{ 0x00, 0x3c, 0x7e, 0x7e, 0x7e, 0x7e, 0x3c, 0x00 }, // 0x51
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00 }, // 0x52
+		{ 0x36, 0x7f, 0x7f, 0x7f, 0x3e, 0x1c, 0x08, 0x00 }, // 0x53
+		{ 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40 }, // 0x54
+		{ 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x08, 0x08 }, // 0x55
+		{ 0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81 }, // 0x56
+		{ 0x00, 0x3c, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00 }, // 0x57
+		{ 0x08, 0x1c, 0x2a, 0x77, 0x2a, 0x08, 0x08, 0x00 }, // 0x58
+		{ 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02 }, // 0x59
+		{ 0x08, 0x1c, 0x3e, 0x7f, 0x3e, 0x1c, 0x08, 0x00 }, // 0x5a
+		{ 0x08, 0x08, 0x08, 0x08, 0xff, 0x08, 0x08, 0x08 }, // 0x5b
+		{ 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50 }, // 0x5c
+		{ 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08 }, // 0x5d
+		{ 0x00, 0x00, 0x01, 0x3e, 0x54, 0x14, 0x14, 0x00 }, // 0x5e
+		{ 0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01 }, // 0x5f
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x60
+		{ 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0 }, // 0x61
+		{ 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff }, // 0x62
+		{ 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x63
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff }, // 0x64
+		{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // 0x65
+		{ 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55 }, // 0x66
+		{ 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 }, // 0x67
+		{ 0x00, 0x00, 0x00, 0x00, 0xaa, 0x55, 0xaa, 0x55 }, // 0x68
+		{ 0xff, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80 }, // 0x69
+		{ 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03 }, // 0x6a
+		{ 0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08 }, // 0x6b
+		{ 0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f }, // 0x6c
+		{ 0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00 }, // 0x6d
+		{ 0x00, 0x00, 0x00, 0x00, 0xf8, 0x08, 0x08, 0x08 }, // 0x6e
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff }, // 0x6f
+		{ 0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08 }, // 0x70
+		{ 0x08, 0x08, 0x08, 0x08, 0xff, 0x00, 0x00, 0x00 }, // 0x71
+		{ 0x00, 0x00, 0x00, 0x00, 0xff, 0x08, 0x08, 0x08 }, // 0x72
+		{ 0x08, 0x08, 0x08, 0x08, 0xf8, 0x08, 0x08, 0x08 }, // 0x73
+		{ 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0 }, // 0x74
+		{ 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0 }, // 0x75
+		{ 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07 }, // 0x76
+		{ 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x77
+		{ 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x78
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff }, // 0x79
+		{ 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff }, // 0x7a
+		{ 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xf0 }, // 0x7b
+		{ 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00 }, // 0x7c
+		{ 0x08, 0x08, 0x08, 0x08, 0xf8, 0x00, 0x00, 0x00 }, // 0x7d
+		{ 0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00 }, // 0x7e
+		{ 0x00, 0x00, 0x01, 0x3e, 0x54, 0x14, 0x14, 0x00 }, // 0x7f
+		{ 0xe3, 0xdd, 0xb5, 0xa9, 0xb3, 0xdf, 0xe1, 0xff }, // 0x80
+		{ 0xe7, 0xdb, 0xbd, 0x81, 0xbd, 0xbd, 0xbd, 0xff }, // 0x81
+		{ 0x83, 0xdd, 0xdd, 0xc3, 0xdd, 0xdd, 0x83, 0xff }, // 0x82
+		{ 0xe3, 0xdd, 0xbf, 0xbf, 0xbf, 0xdd, 0xe3, 0xff }, // 0x83
+		{ 0x87, 0xdb, 0xdd, 0xdd, 0xdd, 0xdb, 0x87, 0xff }, // 0x84
+		{ 0x81, 0xbf, 0xbf, 0x87, 0xbf, 0xbf, 0x81, 0xff }, // 0x85
+		{ 0x81, 0xbf, 0xbf, 0x87, 0xbf, 0xbf, 0xbf, 0xff }, // 0x86
+		{ 0xe3, 0xdd, 0xbf, 0xb1, 0xbd, 0xdd, 0xe3, 0xff }, // 0x87
+		{ 0xbd, 0xbd, 0xbd, 0x81, 0xbd, 0xbd, 0xbd, 0xff }, // 0x88
+		{ 0xe3, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xe3, 0xff }, // 0x89
+		{ 0xf1, 0xfb, 0xfb, 0xfb, 0xfb, 0xbb, 0xc7, 0xff }, // 0x8a
+		{ 0xbd, 0xbb, 0xb7, 0x8f, 0xb7, 0xbb, 0xbd, 0xff }, // 0x8b
+		{ 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0x81, 0xff }, // 0x8c
+		{ 0xbd, 0x99, 0xa5, 0xa5, 0xbd, 0xbd, 0xbd, 0xff }, // 0x8d
+		{ 0xbd, 0x9d, 0xad, 0xb5, 0xb9, 0xbd, 0xbd, 0xff }, // 0x8e
+		{ 0xe7, 0xdb, 0xbd, 0xbd, 0xbd, 0xdb, 0xe7, 0xff }, // 0x8f
+		{ 0x83, 0xbd, 0xbd, 0x83, 0xbf, 0xbf, 0xbf, 0xff }, // 0x90
+		{ 0xe7, 0xdb, 0xbd, 0xbd, 0xb5, 0xdb, 0xe5, 0xff }, // 0x91
+		{ 0x83, 0xbd, 0xbd, 0x83, 0xb7, 0xbb, 0xbd, 0xff }, // 0x92
+		{ 0xc3, 0xbd, 0xbf, 0xc3, 0xfd, 0xbd, 0xc3, 0xff }, // 0x93
+		{ 0xc1, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xff }, // 0x94
+		{ 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xc3, 0xff }, // 0x95
+		{ 0xbd, 0xbd, 0xbd, 0xdb, 0xdb, 0xe7, 0xe7, 0xff }, // 0x96
+		{ 0xbd, 0xbd, 0xbd, 0xa5, 0xa5, 0x99, 0xbd, 0xff }, // 0x97
+		{ 0xbd, 0xbd, 0xdb, 0xe7, 0xdb, 0xbd, 0xbd, 0xff }, // 0x98
+		{ 0xdd, 0xdd, 0xdd, 0xe3, 0xf7, 0xf7, 0xf7, 0xff }, // 0x99
+		{ 0x81, 0xfd, 0xfb, 0xe7, 0xdf, 0xbf, 0x81, 0xff }, // 0x9a
+		{ 0xc3, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xc3, 0xff }, // 0x9b
+		{ 0xff, 0xbf, 0xdf, 0xef, 0xf7, 0xfb, 0xfd, 0xff }, // 0x9c
+		{ 0xc3, 0xfb, 0xfb, 0xfb, 0xfb, 0xfb, 0xc3, 0xff }, // 0x9d
+		{ 0xff, 0xf7, 0xe3, 0xd5, 0xf7, 0xf7, 0xf7, 0xf7 }, // 0x9e
+		{ 0xff, 0xff, 0xef, 0xdf, 0x80, 0xdf, 0xef, 0xff }, // 0x9f
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xa0
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xff, 0xff, 0xf7, 0xff }, // 0xa1
+		{ 0xdb, 0xdb, 0xdb, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xa2
+		{ 0xdb, 0xdb, 0x81, 0xdb, 0x81, 0xdb, 0xdb, 0xff }, // 0xa3
+		{ 0xf7, 0xe1, 0xd7, 0xe3, 0xf5, 0xc3, 0xf7, 0xff }, // 0xa4
+		{ 0xff, 0x9d, 0x9b, 0xf7, 0xef, 0xd9, 0xb9, 0xff }, // 0xa5
+		{ 0xcf, 0xb7, 0xb7, 0xcf, 0xb5, 0xbb, 0xc5, 0xff }, // 0xa6
+		{ 0xfb, 0xf7, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xa7
+		{ 0xfb, 0xf7, 0xef, 0xef, 0xef, 0xf7, 0xfb, 0xff }, // 0xa8
+		{ 0xdf, 0xef, 0xf7, 0xf7, 0xf7, 0xef, 0xdf, 0xff }, // 0xa9
+		{ 0xf7, 0xd5, 0xe3, 0xc1, 0xe3, 0xd5, 0xf7, 0xff }, // 0xaa
+		{ 0xff, 0xf7, 0xf7, 0xc1, 0xf7, 0xf7, 0xff, 0xff }, // 0xab
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xf7, 0xef }, // 0xac
+		{ 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0xff }, // 0xad
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xe7, 0xff }, // 0xae
+		{ 0xff, 0xfd, 0xfb, 0xf7, 0xef, 0xdf, 0xbf, 0xff }, // 0xaf
+		{ 0xc3, 0xbd, 0xb9, 0xa5, 0x9d, 0xbd, 0xc3, 0xff }, // 0xb0
+		{ 0xf7, 0xe7, 0xd7, 0xf7, 0xf7, 0xf7, 0xc1, 0xff }, // 0xb1
+		{ 0xc3, 0xbd, 0xfd, 0xf3, 0xcf, 0xbf, 0x81, 0xff }, // 0xb2
+		{ 0xc3, 0xbd, 0xfd, 0xe3, 0xfd, 0xbd, 0xc3, 0xff }, // 0xb3
+		{ 0xfb, 0xf3, 0xeb, 0xdb, 0x81, 0xfb, 0xfb, 0xff }, // 0xb4
+		{ 0x81, 0xbf, 0x87, 0xfb, 0xfd, 0xbb, 0xc7, 0xff }, // 0xb5
+		{ 0xe3, 0xdf, 0xbf, 0x83, 0xbd, 0xbd, 0xc3, 0xff }, // 0xb6
+		{ 0x81, 0xbd, 0xfb, 0xf7, 0xef, 0xef, 0xef, 0xff }, // 0xb7
+		{ 0xc3, 0xbd, 0xbd, 0xc3, 0xbd, 0xbd, 0xc3, 0xff }, // 0xb8
+		{ 0xc3, 0xbd, 0xbd, 0xc1, 0xfd, 0xfb, 0xc7, 0xff }, // 0xb9
+		{ 0xff, 0xff, 0xf7, 0xff, 0xff, 0xf7, 0xff, 0xff }, // 0xba
+		{ 0xff, 0xff, 0xf7, 0xff, 0xff, 0xf7, 0xf7, 0xef }, // 0xbb
+		{ 0xf1, 0xe7, 0xcf, 0x9f, 0xcf, 0xe7, 0xf1, 0xff }, // 0xbc
+		{ 0xff, 0xff, 0x81, 0xff, 0x81, 0xff, 0xff, 0xff }, // 0xbd
+		{ 0x8f, 0xe7, 0xf3, 0xf9, 0xf3, 0xe7, 0x8f, 0xff }, // 0xbe
+		{ 0xc3, 0xbd, 0xfd, 0xf3, 0xef, 0xff, 0xef, 0xff }, // 0xbf
+		{ 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff }, // 0xc0
+		{ 0xf7, 0xe3, 0xc1, 0x80, 0x80, 0xe3, 0xc1, 0xff }, // 0xc1
+		{ 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef }, // 0xc2
+		{ 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff }, // 0xc3
+		{ 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xc4
+		{ 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xc5
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff }, // 0xc6
+		{ 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf }, // 0xc7
+		{ 0xfb, 0xfb, 0xfb, 0xfb, 0xfb, 0xfb, 0xfb, 0xfb }, // 0xc8
+		{ 0xff, 0xff, 0xff, 0xff, 0x1f, 0xef, 0xf7, 0xf7 }, // 0xc9
+		{ 0xf7, 0xf7, 0xf7, 0xfb, 0xfc, 0xff, 0xff, 0xff }, // 0xca
+		{ 0xf7, 0xf7, 0xf7, 0xef, 0x1f, 0xff, 0xff, 0xff }, // 0xcb
+		{ 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x00 }, // 0xcc
+		{ 0x7f, 0xbf, 0xdf, 0xef, 0xf7, 0xfb, 0xfd, 0xfe }, // 0xcd
+		{ 0xfe, 0xfd, 0xfb, 0xf7, 0xef, 0xdf, 0xbf, 0x7f }, // 0xce
+		{ 0x00, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f }, // 0xcf
+		{ 0x00, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe }, // 0xd0
+		{ 0xff, 0xc3, 0x81, 0x81, 0x81, 0x81, 0xc3, 0xff }, // 0xd1
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff }, // 0xd2
+		{ 0xc9, 0x80, 0x80, 0x80, 0xc1, 0xe3, 0xf7, 0xff }, // 0xd3
+		{ 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf }, // 0xd4
+		{ 0xff, 0xff, 0xff, 0xff, 0xfc, 0xfb, 0xf7, 0xf7 }, // 0xd5
+		{ 0x7e, 0xbd, 0xdb, 0xe7, 0xe7, 0xdb, 0xbd, 0x7e }, // 0xd6
+		{ 0xff, 0xc3, 0xbd, 0xbd, 0xbd, 0xbd, 0xc3, 0xff }, // 0xd7
+		{ 0xf7, 0xe3, 0xd5, 0x88, 0xd5, 0xf7, 0xf7, 0xff }, // 0xd8
+		{ 0xfd, 0xfd, 0xfd, 0xfd, 0xfd, 0xfd, 0xfd, 0xfd }, // 0xd9
+		{ 0xf7, 0xe3, 0xc1, 0x80, 0xc1, 0xe3, 0xf7, 0xff }, // 0xda
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x00, 0xf7, 0xf7, 0xf7 }, // 0xdb
+		{ 0x5f, 0xaf, 0x5f, 0xaf, 0x5f, 0xaf, 0x5f, 0xaf }, // 0xdc
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7 }, // 0xdd
+		{ 0xff, 0xff, 0xfe, 0xc1, 0xab, 0xeb, 0xeb, 0xff }, // 0xde
+		{ 0x00, 0x80, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe }, // 0xdf
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xe0
+		{ 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f }, // 0xe1
+		{ 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00 }, // 0xe2
+		{ 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xe3
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00 }, // 0xe4
+		{ 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f }, // 0xe5
+		{ 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa }, // 0xe6
+		{ 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe }, // 0xe7
+		{ 0xff, 0xff, 0xff, 0xff, 0x55, 0xaa, 0x55, 0xaa }, // 0xe8
+		{ 0x00, 0x01, 0x03, 0x07, 0x0f, 0x1f, 0x3f, 0x7f }, // 0xe9
+		{ 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc }, // 0xea
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xf0, 0xf7, 0xf7, 0xf7 }, // 0xeb
+		{ 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf0, 0xf0, 0xf0 }, // 0xec
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xf0, 0xff, 0xff, 0xff }, // 0xed
+		{ 0xff, 0xff, 0xff, 0xff, 0x07, 0xf7, 0xf7, 0xf7 }, // 0xee
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00 }, // 0xef
+		{ 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf7, 0xf7, 0xf7 }, // 0xf0
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x00, 0xff, 0xff, 0xff }, // 0xf1
+		{ 0xff, 0xff, 0xff, 0xff, 0x00, 0xf7, 0xf7, 0xf7 }, // 0xf2
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x07, 0xf7, 0xf7, 0xf7 }, // 0xf3
+		{ 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f }, // 0xf4
+		{ 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f }, // 0xf5
+		{ 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8 }, // 0xf6
+		{ 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xf7
+		{ 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xf8
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00 }, // 0xf9
+		{ 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0x00 }, // 0xfa
+		{ 0xff, 0xff, 0xff, 0xff, 0x0f, 0x0f, 0x0f, 0x0f }, // 0xfb
+		{ 0xf0, 0xf0, 0xf0, 0xf0, 0xff, 0xff, 0xff, 0xff }, // 0xfc
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x07, 0xff, 0xff, 0xff }, // 0xfd
+		{ 0x0f, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0xff, 0xff }, // 0xfe
+		{ 0xff, 0xff, 0xfe, 0xc1, 0xab, 0xeb, 0xeb, 0xff }, // 0xff
+	},
+	{ // Lower
+		{ 0x1c, 0x22, 0x4a, 0x56, 0x4c, 0x20, 0x1e, 0x00 }, // 0x00
+		{ 0x00, 0x00, 0x38, 0x04, 0x3c, 0x44, 0x3a, 0x00 }, // 0x01
+		{ 0x40, 0x40, 0x5c, 0x62, 0x42, 0x62, 0x5c, 0x00 }, // 0x02
+		{ 0x00, 0x00, 0x3c, 0x42, 0x40, 0x42, 0x3c, 0x00 }, // 0x03
+		{ 0x02, 0x02, 0x3a, 0x46, 0x42, 0x46, 0x3a, 0x00 }, // 0x04
+		{ 0x00, 0x00, 0x3c, 0x42, 0x7e, 0x40, 0x3c, 0x00 }, // 0x05
+		{ 0x0c, 0x12, 0x10, 0x7c, 0x10, 0x10, 0x10, 0x00 }, // 0x06
+		{ 0x00, 0x00, 0x3a, 0x46, 0x46, 0x3a, 0x02, 0x3c }, // 0x07
+		{ 0x40, 0x40, 0x5c, 0x62, 0x42, 0x42, 0x42, 0x00 }, // 0x08
+		{ 0x08, 0x00, 0x18, 0x08, 0x08, 0x08, 0x1c, 0x00 }, // 0x09
+		{ 0x04, 0x00, 0x0c, 0x04, 0x04, 0x04, 0x44, 0x38 }, // 0x0a
+		{ 0x40, 0x40, 0x44, 0x48, 0x50, 0x68, 0x44, 0x00 }, // 0x0b
+		{ 0x18, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00 }, // 0x0c
+		{ 0x00, 0x00, 0x76, 0x49, 0x49, 0x49, 0x49, 0x00 }, // 0x0d
+		{ 0x00, 0x00, 0x5c, 0x62, 0x42, 0x42, 0x42, 0x00 }, // 0x0e
+		{ 0x00, 0x00, 0x3c, 0x42, 0x42, 0x42, 0x3c, 0x00 }, // 0x0f
+		{ 0x00, 0x00, 0x5c, 0x62, 0x62, 0x5c, 0x40, 0x40 }, // 0x10
+		{ 0x00, 0x00, 0x3a, 0x46, 0x46, 0x3a, 0x02, 0x02 }, // 0x11
+		{ 0x00, 0x00, 0x5c, 0x62, 0x40, 0x40, 0x40, 0x00 }, // 0x12
+		{ 0x00, 0x00, 0x3e, 0x40, 0x3c, 0x02, 0x7c, 0x00 }, // 0x13
+		{ 0x10, 0x10, 0x7c, 0x10, 0x10, 0x12, 0x0c, 0x00 }, // 0x14
+		{ 0x00, 0x00, 0x42, 0x42, 0x42, 0x46, 0x3a, 0x00 }, // 0x15
+		{ 0x00, 0x00, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00 }, // 0x16
+		{ 0x00, 0x00, 0x41, 0x49, 0x49, 0x49, 0x36, 0x00 }, // 0x17
+		{ 0x00, 0x00, 0x42, 0x24, 0x18, 0x24, 0x42, 0x00 }, // 0x18
+		{ 0x00, 0x00, 0x42, 0x42, 0x46, 0x3a, 0x02, 0x3c }, // 0x19
+		{ 0x00, 0x00, 0x7e, 0x04, 0x18, 0x20, 0x7e, 0x00 }, // 0x1a
+		{ 0x3c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x00 }, // 0x1b
+		{ 0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00 }, // 0x1c
+		{ 0x3c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x3c, 0x00 }, // 0x1d
+		{ 0x00, 0x08, 0x1c, 0x2a, 0x08, 0x08, 0x08, 0x08 }, // 0x1e
+		{ 0x00, 0x00, 0x10, 0x20, 0x7f, 0x20, 0x10, 0x00 }, // 0x1f
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x20
+		{ 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x00 }, // 0x21
+		{ 0x24, 0x24, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x22
+		{ 0x24, 0x24, 0x7e, 0x24, 0x7e, 0x24, 0x24, 0x00 }, // 0x23
+		{ 0x08, 0x1e, 0x28, 0x1c, 0x0a, 0x3c, 0x08, 0x00 }, // 0x24
+		{ 0x00, 0x62, 0x64, 0x08, 0x10, 0x26, 0x46, 0x00 }, // 0x25
+		{ 0x30, 0x48, 0x48, 0x30, 0x4a, 0x44, 0x3a, 0x00 }, // 0x26
+		{ 0x04, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x27
+		{ 0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00 }, // 0x28
+		{ 0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00 }, // 0x29
+		{ 0x08, 0x2a, 0x1c, 0x3e, 0x1c, 0x2a, 0x08, 0x00 }, // 0x2a
+		{ 0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00 }, // 0x2b
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x10 }, // 0x2c
+		{ 0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00 }, // 0x2d
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00 }, // 0x2e
+		{ 0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x00 }, // 0x2f
+		{ 0x3c, 0x42, 0x46, 0x5a, 0x62, 0x42, 0x3c, 0x00 }, // 0x30
+		{ 0x08, 0x18, 0x28, 0x08, 0x08, 0x08, 0x3e, 0x00 }, // 0x31
+		{ 0x3c, 0x42, 0x02, 0x0c, 0x30, 0x40, 0x7e, 0x00 }, // 0x32
+		{ 0x3c, 0x42, 0x02, 0x1c, 0x02, 0x42, 0x3c, 0x00 }, // 0x33
+		{ 0x04, 0x0c, 0x14, 0x24, 0x7e, 0x04, 0x04, 0x00 }, // 0x34
+		{ 0x7e, 0x40, 0x78, 0x04, 0x02, 0x44, 0x38, 0x00 }, // 0x35
+		{ 0x1c, 0x20, 0x40, 0x7c, 0x42, 0x42, 0x3c, 0x00 }, // 0x36
+		{ 0x7e, 0x42, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00 }, // 0x37
+		{ 0x3c, 0x42, 0x42, 0x3c, 0x42, 0x42, 0x3c, 0x00 }, // 0x38
+		{ 0x3c, 0x42, 0x42, 0x3e, 0x02, 0x04, 0x38, 0x00 }, // 0x39
+		{ 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00 }, // 0x3a
+		{ 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x10 }, // 0x3b
+		{ 0x0e, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0e, 0x00 }, // 0x3c
+		{ 0x00, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x00 }, // 0x3d
+		{ 0x70, 0x18, 0x0c, 0x06, 0x0c, 0x18, 0x70, 0x00 }, // 0x3e
+		{ 0x3c, 0x42, 0x02, 0x0c, 0x10, 0x00, 0x10, 0x00 }, // 0x3f
+		{ 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00 }, // 0x40
+		{ 0x18, 0x24, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00 }, // 0x41
+		{ 0x7c, 0x22, 0x22, 0x3c, 0x22, 0x22, 0x7c, 0x00 }, // 0x42
+		{ 0x1c, 0x22, 0x40, 0x40, 0x40, 0x22, 0x1c, 0x00 }, // 0x43
+		{ 0x78, 0x24, 0x22, 0x22, 0x22, 0x24, 0x78, 0x00 }, // 0x44
+		{ 0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x7e, 0x00 }, // 0x45
+		{ 0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x40, 0x00 }, // 0x46
+		{ 0x1c, 0x22, 0x40, 0x4e, 0x42, 0x22, 0x1c, 0x00 }, // 0x47
+		{ 0x42, 0x42, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00 }, // 0x48
+		{ 0x1c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00 }, // 0x49
+		{ 0x0e, 0x04, 0x04, 0x04, 0x04, 0x44, 0x38, 0x00 }, // 0x4a
+		{ 0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00 }, // 0x4b
+		{ 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7e, 0x00 }, // 0x4c
+		{ 0x42, 0x66, 0x5a, 0x5a, 0x42, 0x42, 0x42, 0x00 }, // 0x4d
+		{ 0x42, 0x62, 0x52, 0x4a, 0x46, 0x42, 0x42, 0x00 }, // 0x4e
+		{ 0x18, 0x24, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00 }, // 0x4f
+		{ 0x7c, 0x42, 0x42, 0x7c, 0x40, 0x40, 0x40, 0x00 }, // 0x50
+		{ 0x18, 0x24, 0x42, 0x42, 0x4a, 0x24, 0x1a, 0x00 }, // 0x51
+		{ 0x7c, 0x42, 0x42, 0x7c, 0x48, 0x44, 0x42, 0x00 }, // 0x52
+		{ 0x3c, 0x42, 0x40, 0x3c, 0x02, 0x42, 0x3c, 0x00 }, // 0x53
+		{ 0x3e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00 }, // 0x54
+		{ 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00 }, // 0x55
+		{ 0x42, 0x42, 0x42, 0x24, 0x24, 0x18, 0x18, 0x00 }, // 0x56
+		{ 0x42, 0x42, 0x42, 0x5a, 0x5a, 0x66, 0x42, 0x00 }, // 0x57
+		{ 0x42, 0x42, 0x24, 0x18, 0x24, 0x42, 0x42, 0x00 }, // 0x58
+		{ 0x22, 0x22, 0x22, 0x1c, 0x08, 0x08, 0x08, 0x00 }, // 0x59
+		{ 0x7e, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7e, 0x00 }, // 0x5a
+		{ 0x08, 0x08, 0x08, 0x08, 0xff, 0x08, 0x08, 0x08 }, // 0x5b
+		{ 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50 }, // 0x5c
+		{ 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08 }, // 0x5d
+		{ 0xcc, 0xcc, 0x33, 0x33, 0xcc, 0xcc, 0x33, 0x33 }, // 0x5e
+		{ 0xcc, 0x66, 0x33, 0x99, 0xcc, 0x66, 0x33, 0x99 }, // 0x5f
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x60
+		{ 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0 }, // 0x61
+		{ 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff }, // 0x62
+		{ 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x63
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff }, // 0x64
+		{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // 0x65
+		{ 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55 }, // 0x66
+		{ 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 }, // 0x67
+		{ 0x00, 0x00, 0x00, 0x00, 0xaa, 0x55, 0xaa, 0x55 }, // 0x68
+		{ 0x99, 0x33, 0x66, 0xcc, 0x99, 0x33, 0x66, 0xcc }, // 0x69
+		{ 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03 }, // 0x6a
+		{ 0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08 }, // 0x6b
+		{ 0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f }, // 0x6c
+		{ 0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00 }, // 0x6d
+		{ 0x00, 0x00, 0x00, 0x00, 0xf8, 0x08, 0x08, 0x08 }, // 0x6e
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff }, // 0x6f
+		{ 0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08 }, // 0x70
+		{ 0x08, 0x08, 0x08, 0x08, 0xff, 0x00, 0x00, 0x00 }, // 0x71
+		{ 0x00, 0x00, 0x00, 0x00, 0xff, 0x08, 0x08, 0x08 }, // 0x72
+		{ 0x08, 0x08, 0x08, 0x08, 0xf8, 0x08, 0x08, 0x08 }, // 0x73
+		{ 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0 }, // 0x74
+		{ 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0 }, // 0x75
+		{ 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07 }, // 0x76
+		{ 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x77
+		{ 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x78
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff }, // 0x79
+		{ 0x01, 0x02, 0x44, 0x48, 0x50, 0x60, 0x40, 0x00 }, // 0x7a
+		{ 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xf0 }, // 0x7b
+		{ 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00 }, // 0x7c
+		{ 0x08, 0x08, 0x08, 0x08, 0xf8, 0x00, 0x00, 0x00 }, // 0x7d
+		{ 0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00 }, // 0x7e
+		{ 0xcc, 0xcc, 0x33, 0x33, 0xcc, 0xcc, 0x33, 0x33 }, // 0x7f
+		{ 0xe3, 0xdd, 0xb5, 0xa9, 0xb3, 0xdf, 0xe1, 0xff }, // 0x80
+		{ 0xff, 0xff, 0xc7, 0xfb, 0xc3, 0xbb, 0xc5, 0xff }, // 0x81
+		{ 0xbf, 0xbf, 0xa3, 0x9d, 0xbd, 0x9d, 0xa3, 0xff }, // 0x82
+		{ 0xff, 0xff, 0xc3, 0xbd, 0xbf, 0xbd, 0xc3, 0xff }, // 0x83
+		{ 0xfd, 0xfd, 0xc5, 0xb9, 0xbd, 0xb9, 0xc5, 0xff }, // 0x84
+		{ 0xff, 0xff, 0xc3, 0xbd, 0x81, 0xbf, 0xc3, 0xff }, // 0x85
+		{ 0xf3, 0xed, 0xef, 0x83, 0xef, 0xef, 0xef, 0xff }, // 0x86
+		{ 0xff, 0xff, 0xc5, 0xb9, 0xb9, 0xc5, 0xfd, 0xc3 }, // 0x87
+		{ 0xbf, 0xbf, 0xa3, 0x9d, 0xbd, 0xbd, 0xbd, 0xff }, // 0x88
+		{ 0xf7, 0xff, 0xe7, 0xf7, 0xf7, 0xf7, 0xe3, 0xff }, // 0x89
+		{ 0xfb, 0xff, 0xf3, 0xfb, 0xfb, 0xfb, 0xbb, 0xc7 }, // 0x8a
+		{ 0xbf, 0xbf, 0xbb, 0xb7, 0xaf, 0x97, 0xbb, 0xff }, // 0x8b
+		{ 0xe7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xe3, 0xff }, // 0x8c
+		{ 0xff, 0xff, 0x89, 0xb6, 0xb6, 0xb6, 0xb6, 0xff }, // 0x8d
+		{ 0xff, 0xff, 0xa3, 0x9d, 0xbd, 0xbd, 0xbd, 0xff }, // 0x8e
+		{ 0xff, 0xff, 0xc3, 0xbd, 0xbd, 0xbd, 0xc3, 0xff }, // 0x8f
+		{ 0xff, 0xff, 0xa3, 0x9d, 0x9d, 0xa3, 0xbf, 0xbf }, // 0x90
+		{ 0xff, 0xff, 0xc5, 0xb9, 0xb9, 0xc5, 0xfd, 0xfd }, // 0x91
+		{ 0xff, 0xff, 0xa3, 0x9d, 0xbf, 0xbf, 0xbf, 0xff }, // 0x92
+		{ 0xff, 0xff, 0xc1, 0xbf, 0xc3, 0xfd, 0x83, 0xff }, // 0x93
+		{ 0xef, 0xef, 0x83, 0xef, 0xef, 0xed, 0xf3, 0xff }, // 0x94
+		{ 0xff, 0xff, 0xbd, 0xbd, 0xbd, 0xb9, 0xc5, 0xff }, // 0x95
+		{ 0xff, 0xff, 0xbd, 0xbd, 0xbd, 0xdb, 0xe7, 0xff }, // 0x96
+		{ 0xff, 0xff, 0xbe, 0xb6, 0xb6, 0xb6, 0xc9, 0xff }, // 0x97
+		{ 0xff, 0xff, 0xbd, 0xdb, 0xe7, 0xdb, 0xbd, 0xff }, // 0x98
+		{ 0xff, 0xff, 0xbd, 0xbd, 0xb9, 0xc5, 0xfd, 0xc3 }, // 0x99
+		{ 0xff, 0xff, 0x81, 0xfb, 0xe7, 0xdf, 0x81, 0xff }, // 0x9a
+		{ 0xc3, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xc3, 0xff }, // 0x9b
+		{ 0xff, 0xbf, 0xdf, 0xef, 0xf7, 0xfb, 0xfd, 0xff }, // 0x9c
+		{ 0xc3, 0xfb, 0xfb, 0xfb, 0xfb, 0xfb, 0xc3, 0xff }, // 0x9d
+		{ 0xff, 0xf7, 0xe3, 0xd5, 0xf7, 0xf7, 0xf7, 0xf7 }, // 0x9e
+		{ 0xff, 0xff, 0xef, 0xdf, 0x80, 0xdf, 0xef, 0xff }, // 0x9f
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xa0
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xff, 0xff, 0xf7, 0xff }, // 0xa1
+		{ 0xdb, 0xdb, 0xdb, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xa2
+		{ 0xdb, 0xdb, 0x81, 0xdb, 0x81, 0xdb, 0xdb, 0xff }, // 0xa3
+		{ 0xf7, 0xe1, 0xd7, 0xe3, 0xf5, 0xc3, 0xf7, 0xff }, // 0xa4
+		{ 0xff, 0x9d, 0x9b, 0xf7, 0xef, 0xd9, 0xb9, 0xff }, // 0xa5
+		{ 0xcf, 0xb7, 0xb7, 0xcf, 0xb5, 0xbb, 0xc5, 0xff }, // 0xa6
+		{ 0xfb, 0xf7, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xa7
+		{ 0xfb, 0xf7, 0xef, 0xef, 0xef, 0xf7, 0xfb, 0xff }, // 0xa8
+		{ 0xdf, 0xef, 0xf7, 0xf7, 0xf7, 0xef, 0xdf, 0xff }, // 0xa9
+		{ 0xf7, 0xd5, 0xe3, 0xc1, 0xe3, 0xd5, 0xf7, 0xff }, // 0xaa
+		{ 0xff, 0xf7, 0xf7, 0xc1, 0xf7, 0xf7, 0xff, 0xff }, // 0xab
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xf7, 0xef }, // 0xac
+		{ 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0xff }, // 0xad
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xe7, 0xff }, // 0xae
+		{ 0xff, 0xfd, 0xfb, 0xf7, 0xef, 0xdf, 0xbf, 0xff }, // 0xaf
+		{ 0xc3, 0xbd, 0xb9, 0xa5, 0x9d, 0xbd, 0xc3, 0xff }, // 0xb0
+		{ 0xf7, 0xe7, 0xd7, 0xf7, 0xf7, 0xf7, 0xc1, 0xff }, // 0xb1
+		{ 0xc3, 0xbd, 0xfd, 0xf3, 0xcf, 0xbf, 0x81, 0xff }, // 0xb2
+		{ 0xc3, 0xbd, 0xfd, 0xe3, 0xfd, 0xbd, 0xc3, 0xff }, // 0xb3
+		{ 0xfb, 0xf3, 0xeb, 0xdb, 0x81, 0xfb, 0xfb, 0xff }, // 0xb4
+		{ 0x81, 0xbf, 0x87, 0xfb, 0xfd, 0xbb, 0xc7, 0xff }, // 0xb5
+		{ 0xe3, 0xdf, 0xbf, 0x83, 0xbd, 0xbd, 0xc3, 0xff }, // 0xb6
+		{ 0x81, 0xbd, 0xfb, 0xf7, 0xef, 0xef, 0xef, 0xff }, // 0xb7
+		{ 0xc3, 0xbd, 0xbd, 0xc3, 0xbd, 0xbd, 0xc3, 0xff }, // 0xb8
+		{ 0xc3, 0xbd, 0xbd, 0xc1, 0xfd, 0xfb, 0xc7, 0xff }, // 0xb9
+		{ 0xff, 0xff, 0xf7, 0xff, 0xff, 0xf7, 0xff, 0xff }, // 0xba
+		{ 0xff, 0xff, 0xf7, 0xff, 0xff, 0xf7, 0xf7, 0xef }, // 0xbb
+		{ 0xf1, 0xe7, 0xcf, 0x9f, 0xcf, 0xe7, 0xf1, 0xff }, // 0xbc
+		{ 0xff, 0xff, 0x81, 0xff, 0x81, 0xff, 0xff, 0xff }, // 0xbd
+		{ 0x8f, 0xe7, 0xf3, 0xf9, 0xf3, 0xe7, 0x8f, 0xff }, // 0xbe
+		{ 0xc3, 0xbd, 0xfd, 0xf3, 0xef, 0xff, 0xef, 0xff }, // 0xbf
+		{ 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff }, // 0xc0
+		{ 0xe7, 0xdb, 0xbd, 0x81, 0xbd, 0xbd, 0xbd, 0xff }, // 0xc1
+		{ 0x83, 0xdd, 0xdd, 0xc3, 0xdd, 0xdd, 0x83, 0xff }, // 0xc2
+		{ 0xe3, 0xdd, 0xbf, 0xbf, 0xbf, 0xdd, 0xe3, 0xff }, // 0xc3
+		{ 0x87, 0xdb, 0xdd, 0xdd, 0xdd, 0xdb, 0x87, 0xff }, // 0xc4
+		{ 0x81, 0xbf, 0xbf, 0x87, 0xbf, 0xbf, 0x81, 0xff }, // 0xc5
+		{ 0x81, 0xbf, 0xbf, 0x87, 0xbf, 0xbf, 0xbf, 0xff }, // 0xc6
+		{ 0xe3, 0xdd, 0xbf, 0xb1, 0xbd, 0xdd, 0xe3, 0xff }, // 0xc7
+		{ 0xbd, 0xbd, 0xbd, 0x81, 0xbd, 0xbd, 0xbd, 0xff }, // 0xc8
+		{ 0xe3, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xe3, 0xff }, // 0xc9
+		{ 0xf1, 0xfb, 0xfb, 0xfb, 0xfb, 0xbb, 0xc7, 0xff }, // 0xca
+		{ 0xbd, 0xbb, 0xb7, 0x8f, 0xb7, 0xbb, 0xbd, 0xff }, // 0xcb
+		{ 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0x81, 0xff }, // 0xcc
+		{ 0xbd, 0x99, 0xa5, 0xa5, 0xbd, 0xbd, 0xbd, 0xff }, // 0xcd
+		{ 0xbd, 0x9d, 0xad, 0xb5, 0xb9, 0xbd, 0xbd, 0xff }, // 0xce
+		{ 0xe7, 0xdb, 0xbd, 0xbd, 0xbd, 0xdb, 0xe7, 0xff }, // 0xcf
+		{ 0x83, 0xbd, 0xbd, 0x83, 0xbf, 0xbf, 0xbf, 0xff }, // 0xd0
+		{ 0xe7, 0xdb, 0xbd, 0xbd, 0xb5, 0xdb, 0xe5, 0xff }, // 0xd1
+		{ 0x83, 0xbd, 0xbd, 0x83, 0xb7, 0xbb, 0xbd, 0xff }, // 0xd2
+		{ 0xc3, 0xbd, 0xbf, 0xc3, 0xfd, 0xbd, 0xc3, 0xff }, // 0xd3
+		{ 0xc1, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xff }, // 0xd4
+		{ 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xc3, 0xff }, // 0xd5
+		{ 0xbd, 0xbd, 0xbd, 0xdb, 0xdb, 0xe7, 0xe7, 0xff }, // 0xd6
+		{ 0xbd, 0xbd, 0xbd, 0xa5, 0xa5, 0x99, 0xbd, 0xff }, // 0xd7
+		{ 0xbd, 0xbd, 0xdb, 0xe7, 0xdb, 0xbd, 0xbd, 0xff }, // 0xd8
+		{ 0xdd, 0xdd, 0xdd, 0xe3, 0xf7, 0xf7, 0xf7, 0xff }, // 0xd9
+		{ 0x81, 0xfd, 0xfb, 0xe7, 0xdf, 0xbf, 0x81, 0xff }, // 0xda
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x00, 0xf7, 0xf7, 0xf7 }, // 0xdb
+		{ 0x5f, 0xaf, 0x5f, 0xaf, 0x5f, 0xaf, 0x5f, 0xaf }, // 0xdc
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7 }, // 0xdd
+		{ 0x33, 0x33, 0xcc, 0xcc, 0x33, 0x33, 0xcc, 0xcc }, // 0xde
+		{ 0x33, 0x99, 0xcc, 0x66, 0x33, 0x99, 0xcc, 0x66 }, // 0xdf
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xe0
+		{ 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f }, // 0xe1
+		{ 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00 }, // 0xe2
+		{ 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xe3
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00 }, // 0xe4
+		{ 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f }, // 0xe5
+		{ 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa }, // 0xe6
+		{ 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe }, // 0xe7
+		{ 0xff, 0xff, 0xff, 0xff, 0x55, 0xaa, 0x55, 0xaa }, // 0xe8
+		{ 0x66, 0xcc, 0x99, 0x33, 0x66, 0xcc, 0x99, 0x33 }, // 0xe9
+		{ 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc }, // 0xea
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xf0, 0xf7, 0xf7, 0xf7 }, // 0xeb
+		{ 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf0, 0xf0, 0xf0 }, // 0xec
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0xf0, 0xff, 0xff, 0xff }, // 0xed
+		{ 0xff, 0xff, 0xff, 0xff, 0x07, 0xf7, 0xf7, 0xf7 }, // 0xee
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00 }, // 0xef
+		{ 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf7, 0xf7, 0xf7 }, // 0xf0
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x00, 0xff, 0xff, 0xff }, // 0xf1
+		{ 0xff, 0xff, 0xff, 0xff, 0x00, 0xf7, 0xf7, 0xf7 }, // 0xf2
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x07, 0xf7, 0xf7, 0xf7 }, // 0xf3
+		{ 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f }, // 0xf4
+		{ 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f }, // 0xf5
+		{ 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8 }, // 0xf6
+		{ 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xf7
+		{ 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff }, // 0xf8
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00 }, // 0xf9
+		{ 0xfe, 0xfd, 0xbb, 0xb7, 0xaf, 0x9f, 0xbf, 0xff }, // 0xfa
+		{ 0xff, 0xff, 0xff, 0xff, 0x0f, 0x0f, 0x0f, 0x0f }, // 0xfb
+		{ 0xf0, 0xf0, 0xf0, 0xf0, 0xff, 0xff, 0xff, 0xff }, // 0xfc
+		{ 0xf7, 0xf7, 0xf7, 0xf7, 0x07, 0xff, 0xff, 0xff }, // 0xfd
+		{ 0x0f, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0xff, 0xff }, // 0xfe
+		{ 0x33, 0x33, 0xcc, 0xcc, 0x33, 0x33, 0xcc, 0xcc }, // 0xff
+	},
+};
+
+} // namespace CharacterRom
+
+#endif // CHARACTERROM_H
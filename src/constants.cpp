@@ -26,4 +26,19 @@ const QColor colorKey(80, 130, 255);
 const QColor colorWeapon(255, 150, 0);
 const QColor colorTool(255, 255, 100);
 const QColor colorMedkit(100, 255, 100);
+const QColor colorUnreachable(0, 0, 0, 160);
+const QColor colorHeatmap(255, 60, 0);
+const QColor colorTrajectory(255, 200, 0);
+const QColor colorDanger(255, 170, 0, 70);
+const QColor colorDangerAttacker(255, 0, 0, 110);
+const QColor colorMarkedTile(255, 0, 255);
+const QColor colorPatternMatch(0, 255, 255);
+const QColor colorDiffTiles(0, 160, 255, 110);
+const QColor colorDiffAdded(0, 255, 0);
+const QColor colorDiffRemoved(255, 0, 0);
+const QColor colorDiffModified(255, 255, 0);
+const QColor colorOverlayBackground(0, 0, 0, 160);
+const QColor colorOverlayText(255, 255, 255);
+const QColor colorPlaceholder(32, 32, 32);
+const QColor colorPlaceholderText(160, 160, 160);
 }
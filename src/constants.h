@@ -30,6 +30,21 @@ extern const QColor colorKey;
 extern const QColor colorWeapon;
 extern const QColor colorTool;
 extern const QColor colorMedkit;
+extern const QColor colorUnreachable;
+extern const QColor colorHeatmap;
+extern const QColor colorTrajectory;
+extern const QColor colorDanger;
+extern const QColor colorDangerAttacker;
+extern const QColor colorMarkedTile;
+extern const QColor colorPatternMatch;
+extern const QColor colorDiffTiles;
+extern const QColor colorDiffAdded;
+extern const QColor colorDiffRemoved;
+extern const QColor colorDiffModified;
+extern const QColor colorOverlayBackground;
+extern const QColor colorOverlayText;
+extern const QColor colorPlaceholder;
+extern const QColor colorPlaceholderText;
 }
 
 #endif // CONSTANTS_H
@@ -0,0 +1,409 @@
+#include "gamesimulator.h"
+#include <QRect>
+#include <QtGlobal>
+#include <algorithm>
+#include "map.h"
+#include "tile.h"
+#include "tileset.h"
+
+
+/** @class GameSimulator
+ * A headless approximation of how the units on a map behave over time.
+ *
+ * The simulation advances in fixed ticks and is deterministic: units are
+ * updated in the order of their ids, and nothing is random. It follows the
+ * rules of the game closely enough to show where robots go, but doesn't
+ * attempt to be exact:
+ *
+ * * The player stands still. Hoverbots and rollerbots patrol back and forth
+ *   along their axis and turn around when blocked, attack hoverbots and
+ *   evilbots head straight for the player.
+ * * Water rafts go back and forth between their turnaround points.
+ * * Doors and elevators open when a unit is next to them and close again
+ *   afterwards. Locked doors only open for the player.
+ * * Trash compactors close when a robot stands on them, destroying it.
+ *
+ * The map itself is never modified, the simulator works on a copy of the
+ * objects. Optionally, the position of every moving unit is recorded for
+ * every tick (#trajectory()), and the number of ticks a robot or raft spent
+ * on each tile is always counted (#heatmap()).
+ */
+
+
+static constexpr int HOVERBOT_DELAY = 8;
+static constexpr int ROLLERBOT_DELAY = 5;
+static constexpr int ATTACKER_DELAY = 6;
+static constexpr int RAFT_DELAY = 6;
+static constexpr int DOOR_DELAY = 4;
+static constexpr int COMPACTOR_DELAY = 20;
+static constexpr uint8_t DOOR_OPEN = 2;
+static constexpr uint8_t DOOR_CLOSED = 5;
+static constexpr int NEAR_ROBOT = 1;
+static constexpr int NEAR_PLAYER = 2;
+
+
+GameSimulator::GameSimulator(const Map &map, const Tileset &tileset)
+    : _map(map), _width(map.width()), _height(map.height()), _passable(_width * _height),
+      _doors(_width * _height), _occupant(_width * _height), _trajectories(MapObject::IdMax + 1),
+      _heatmap(_width * _height) {
+	uint8_t passableTile[256];
+	for (int tileNo = 0; tileNo < 256; ++tileNo) {
+		const QFlags<Tile::Attribute> attributes = tileset.tile(tileNo).attributes();
+		passableTile[tileNo] = (attributes.testFlag(Tile::Walkable) ? Walkable : 0)
+		        | (attributes.testFlag(Tile::Hoverable) ? Hoverable : 0);
+	}
+	const uint8_t *tiles = map.tiles();
+	for (int i = 0; i < _width * _height; ++i) {
+		_passable[i] = passableTile[tiles[i]];
+	}
+
+	reset();
+}
+
+
+/** Restore the state of the map's objects and clear the trajectories and the
+ * heatmap.
+ */
+void GameSimulator::reset() {
+	_tick = 0;
+	_units.clear();
+	_compactors.clear();
+	std::fill(_doors.begin(), _doors.end(), -1);
+	std::fill(_occupant.begin(), _occupant.end(), -1);
+	std::fill(_heatmap.begin(), _heatmap.end(), 0);
+	_heatmapMax = 0;
+	for (std::vector<QPoint> &trajectory : _trajectories) {
+		trajectory.clear();
+	}
+
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		MapObject &object = _objects[id];
+		object = _map.object(id);
+		_destroyed[id] = false;
+		if (object.unitType == MapObject::UnitType::None or not _map.rect().contains(object.pos())) {
+			continue;
+		}
+
+		switch (object.unitType) {
+		case MapObject::UnitType::Player:
+			_occupant[index(object.x, object.y)] = id;
+			break;
+		case MapObject::UnitType::HoverbotLR: _units.push_back({ id, HOVERBOT_DELAY, 1, 1, 0 }); break;
+		case MapObject::UnitType::HoverbotUD: _units.push_back({ id, HOVERBOT_DELAY, 1, 0, 1 }); break;
+		case MapObject::UnitType::RollerbotLR: _units.push_back({ id, ROLLERBOT_DELAY, 1, 1, 0 }); break;
+		case MapObject::UnitType::RollerbotUD: _units.push_back({ id, ROLLERBOT_DELAY, 1, 0, 1 }); break;
+		case MapObject::UnitType::HoverbotAttack:
+		case MapObject::UnitType::Evilbot: _units.push_back({ id, ATTACKER_DELAY, 1, 0, 0 }); break;
+		case MapObject::UnitType::WaterRaft:
+			_units.push_back({ id, RAFT_DELAY, 1, int8_t(object.a == 1 ? 1 : -1), 0 });
+			break;
+		case MapObject::UnitType::Door:
+		case MapObject::UnitType::Elevator:
+			_doors[index(object.x, object.y)] = id;
+			break;
+		case MapObject::UnitType::TrashCompactor:
+			_compactors.push_back({ id, CompactorState::Idle, 0 });
+			break;
+		default:;
+		}
+
+		if (object.group() == MapObject::Group::Robots) {
+			_occupant[index(object.x, object.y)] = id;
+		}
+	}
+}
+
+
+/** Advance the simulation by one tick. */
+void GameSimulator::step() {
+	++_tick;
+
+	for (Unit &unit : _units) {
+		if (_destroyed[unit.id]) { continue; }
+		if (--unit.countdown <= 0) {
+			unit.countdown = unit.delay;
+			moveUnit(unit);
+		}
+
+		const MapObject &object = _objects[unit.id];
+		uint32_t &heat = _heatmap[index(object.x, object.y)];
+		_heatmapMax = qMax(_heatmapMax, ++heat);
+		if (_recordTrajectories) {
+			_trajectories[unit.id].push_back(object.pos());
+		}
+	}
+
+	if (_tick % DOOR_DELAY == 0) {
+		for (MapObject::id_t id = MapObject::IdMapFeatureMin; id <= MapObject::IdMapFeatureMax; ++id) {
+			const MapObject::UnitType unitType = _objects[id].unitType;
+			if (unitType == MapObject::UnitType::Door or unitType == MapObject::UnitType::Elevator) {
+				updateDoor(id);
+			}
+		}
+	}
+
+	for (Compactor &compactor : _compactors) {
+		updateCompactor(compactor);
+	}
+}
+
+
+void GameSimulator::run(int ticks) {
+	for (int i = 0; i < ticks; ++i) {
+		step();
+	}
+}
+
+
+/** The number of ticks simulated since the last #reset(). */
+int GameSimulator::tick() const {
+	return _tick;
+}
+
+
+/** The current state of the object \a id. */
+const MapObject &GameSimulator::object(MapObject::id_t id) const {
+	Q_ASSERT(MapObject::IdMin <= id and id <= MapObject::IdMax);
+	return _objects[id];
+}
+
+
+/** Whether the robot \a id has been destroyed by a trash compactor. */
+bool GameSimulator::isDestroyed(MapObject::id_t id) const {
+	Q_ASSERT(MapObject::IdMin <= id and id <= MapObject::IdMax);
+	return _destroyed[id];
+}
+
+
+bool GameSimulator::recordTrajectories() const {
+	return _recordTrajectories;
+}
+
+
+/** Whether to record the position of every moving unit at every tick. This
+ * is off by default.
+ */
+void GameSimulator::setRecordTrajectories(bool record) {
+	_recordTrajectories = record;
+}
+
+
+/** The positions of unit \a id, one per tick. Empty unless trajectories are
+ * recorded, or if \a id isn't a moving unit.
+ */
+const std::vector<QPoint> &GameSimulator::trajectory(MapObject::id_t id) const {
+	Q_ASSERT(MapObject::IdMin <= id and id <= MapObject::IdMax);
+	return _trajectories[id];
+}
+
+
+/** For every tile, row by row, the number of ticks that robots and rafts
+ * spent on it.
+ */
+const std::vector<uint32_t> &GameSimulator::heatmap() const {
+	return _heatmap;
+}
+
+
+/** The largest value in #heatmap(). */
+uint32_t GameSimulator::heatmapMax() const {
+	return _heatmapMax;
+}
+
+
+/** Whether units of type \a unitType move on their own. */
+bool GameSimulator::isSimulated(MapObject::UnitType unitType) {
+	return MapObject::group(unitType) == MapObject::Group::Robots
+	        or unitType == MapObject::UnitType::WaterRaft;
+}
+
+
+void GameSimulator::moveUnit(Unit &unit) {
+	const MapObject &object = _objects[unit.id];
+	switch (object.unitType) {
+	case MapObject::UnitType::WaterRaft: moveRaft(unit); return;
+	case MapObject::UnitType::HoverbotAttack: moveAttacker(unit, Hoverable); return;
+	case MapObject::UnitType::Evilbot: moveAttacker(unit, Walkable); return;
+	default:;
+	}
+
+	const uint8_t passable = object.unitType == MapObject::UnitType::HoverbotLR
+	        or object.unitType == MapObject::UnitType::HoverbotUD ? Hoverable : Walkable;
+	const int x = object.x + unit.dx;
+	const int y = object.y + unit.dy;
+	if (canEnter(x, y, passable)) {
+		setPosition(unit.id, x, y);
+	} else if (not isOpeningDoor(x, y)) {
+		unit.dx = -unit.dx;
+		unit.dy = -unit.dy;
+	}
+}
+
+
+/** Take a step towards the player, along the axis on which the player is
+ * further away first.
+ */
+void GameSimulator::moveAttacker(Unit &unit, uint8_t passable) {
+	const MapObject &player = _objects[MapObject::IdPlayer];
+	if (player.unitType != MapObject::UnitType::Player) { return; }
+	const MapObject &object = _objects[unit.id];
+	const int dx = player.x - object.x;
+	const int dy = player.y - object.y;
+	const QPoint horizontal(dx > 0 ? 1 : dx < 0 ? -1 : 0, 0);
+	const QPoint vertical(0, dy > 0 ? 1 : dy < 0 ? -1 : 0);
+	const bool horizontalFirst = qAbs(dx) >= qAbs(dy);
+
+	for (const QPoint &direction : { horizontalFirst ? horizontal : vertical,
+	                                 horizontalFirst ? vertical : horizontal }) {
+		if (direction.isNull()) { continue; }
+		const QPoint target = object.pos() + direction;
+		if (canEnter(target.x(), target.y(), passable)) {
+			setPosition(unit.id, target.x(), target.y());
+			return;
+		}
+	}
+}
+
+
+/** Rafts move horizontally between their left (B) and right (C) turnaround
+ * points.
+ */
+void GameSimulator::moveRaft(Unit &unit) {
+	MapObject &raft = _objects[unit.id];
+	const int x = raft.x + unit.dx;
+	if (x < 0 or x >= _width) {
+		unit.dx = -unit.dx;
+		return;
+	}
+	raft.x = x;
+	if ((unit.dx < 0 and x <= raft.b) or (unit.dx > 0 and x >= raft.c)) {
+		unit.dx = -unit.dx;
+	}
+	raft.a = unit.dx > 0 ? 1 : 0;
+}
+
+
+/** Advance the door or elevator \a id by one animation step. Its state (B)
+ * goes from closed (5) through opening (0, 1) to open (2) while a unit is
+ * close, and back through closing (3, 4) once nobody is.
+ */
+void GameSimulator::updateDoor(MapObject::id_t id) {
+	MapObject &door = _objects[id];
+	const int near = unitsNear(door.pos());
+	const bool locked = door.unitType == MapObject::UnitType::Door and door.c != 0;
+	const bool open = (near & NEAR_PLAYER) or ((near & NEAR_ROBOT) and not locked);
+
+	if (open) {
+		switch (door.b) {
+		case 0: case 3: door.b = 1; break;
+		case 1: door.b = DOOR_OPEN; break;
+		case 4: case DOOR_CLOSED: door.b = 0; break;
+		default:;
+		}
+	} else if (_occupant[index(door.x, door.y)] == -1) {
+		switch (door.b) {
+		case 0: case DOOR_OPEN: door.b = 3; break;
+		case 1: case 3: door.b = 4; break;
+		case 4: door.b = DOOR_CLOSED; break;
+		default:;
+		}
+	}
+}
+
+
+void GameSimulator::updateCompactor(Compactor &compactor) {
+	const MapObject &object = _objects[compactor.id];
+	const int left = index(object.x, object.y);
+	const int right = object.x + 1 < _width ? left + 1 : left;
+
+	switch (compactor.state) {
+	case CompactorState::Idle:
+		for (int i : { left, right }) {
+			if (_occupant[i] > MapObject::IdPlayer) {
+				compactor.state = CompactorState::Closing;
+				compactor.countdown = COMPACTOR_DELAY;
+			}
+		}
+		break;
+	case CompactorState::Closing:
+		if (--compactor.countdown == 0) {
+			for (int i : { left, right }) {
+				if (_occupant[i] > MapObject::IdPlayer) {
+					_destroyed[_occupant[i]] = true;
+					_occupant[i] = -1;
+				}
+			}
+			compactor.state = CompactorState::Closed;
+			compactor.countdown = COMPACTOR_DELAY;
+		}
+		break;
+	case CompactorState::Closed:
+		if (--compactor.countdown == 0) {
+			compactor.state = CompactorState::Opening;
+			compactor.countdown = COMPACTOR_DELAY;
+		}
+		break;
+	case CompactorState::Opening:
+		if (--compactor.countdown == 0) {
+			compactor.state = CompactorState::Idle;
+		}
+		break;
+	}
+}
+
+
+/** Whether a unit that can move on tiles with the \a passable attribute can
+ * move to (\a x, \a y) now.
+ */
+bool GameSimulator::canEnter(int x, int y, uint8_t passable) const {
+	if (x < 0 or x >= _width or y < 0 or y >= _height) { return false; }
+	const int i = index(x, y);
+	if (_occupant[i] != -1) { return false; }
+	if (_doors[i] != -1) { return _objects[_doors[i]].b == DOOR_OPEN; }
+	return _passable[i] & passable;
+}
+
+
+/** Whether there's a door at (\a x, \a y) that will open for a robot, so
+ * that it's worth waiting for it.
+ */
+bool GameSimulator::isOpeningDoor(int x, int y) const {
+	if (x < 0 or x >= _width or y < 0 or y >= _height) { return false; }
+	const int8_t id = _doors[index(x, y)];
+	if (id == -1) { return false; }
+	const MapObject &door = _objects[id];
+	return door.unitType == MapObject::UnitType::Elevator or door.c == 0;
+}
+
+
+void GameSimulator::setPosition(MapObject::id_t id, int x, int y) {
+	MapObject &object = _objects[id];
+	_occupant[index(object.x, object.y)] = -1;
+	object.x = x;
+	object.y = y;
+	_occupant[index(x, y)] = id;
+}
+
+
+/** Which kinds of units are on \a position or one of the eight tiles around
+ * it, as a combination of NEAR_ROBOT and NEAR_PLAYER.
+ */
+int GameSimulator::unitsNear(const QPoint &position) const {
+	int result = 0;
+	for (int y = qMax(0, position.y() - 1); y <= qMin(_height - 1, position.y() + 1); ++y) {
+		for (int x = qMax(0, position.x() - 1); x <= qMin(_width - 1, position.x() + 1); ++x) {
+			const int8_t occupant = _occupant[index(x, y)];
+			if (occupant == MapObject::IdPlayer) {
+				result |= NEAR_PLAYER;
+			} else if (occupant != -1) {
+				result |= NEAR_ROBOT;
+			}
+		}
+	}
+	return result;
+}
+
+
+int GameSimulator::index(int x, int y) const {
+	return x + _width * y;
+}
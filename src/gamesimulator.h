@@ -0,0 +1,81 @@
+#ifndef GAMESIMULATOR_H
+#define GAMESIMULATOR_H
+
+#include <QPoint>
+#include <cstdint>
+#include <vector>
+#include "mapobject.h"
+
+class Map;
+class Tileset;
+
+
+class GameSimulator {
+public:
+	GameSimulator(const Map &map, const Tileset &tileset);
+
+	void reset();
+	void step();
+	void run(int ticks);
+
+	int tick() const;
+	const MapObject &object(MapObject::id_t id) const;
+	bool isDestroyed(MapObject::id_t id) const;
+
+	bool recordTrajectories() const;
+	void setRecordTrajectories(bool record);
+	const std::vector<QPoint> &trajectory(MapObject::id_t id) const;
+
+	const std::vector<uint32_t> &heatmap() const;
+	uint32_t heatmapMax() const;
+
+	static bool isSimulated(MapObject::UnitType unitType);
+
+private:
+	enum Passable : uint8_t { Walkable = 1, Hoverable = 2 };
+	enum class CompactorState { Idle, Closing, Closed, Opening };
+
+	struct Unit {
+		MapObject::id_t id;
+		int delay;
+		int countdown;
+		int8_t dx;
+		int8_t dy;
+	};
+
+	struct Compactor {
+		MapObject::id_t id;
+		CompactorState state;
+		int countdown;
+	};
+
+	void moveUnit(Unit &unit);
+	void moveAttacker(Unit &unit, uint8_t passable);
+	void moveRaft(Unit &unit);
+	void updateDoor(MapObject::id_t id);
+	void updateCompactor(Compactor &compactor);
+	bool canEnter(int x, int y, uint8_t passable) const;
+	bool isOpeningDoor(int x, int y) const;
+	void setPosition(MapObject::id_t id, int x, int y);
+	int unitsNear(const QPoint &position) const;
+	int index(int x, int y) const;
+
+	const Map &_map;
+	const int _width;
+	const int _height;
+	std::vector<uint8_t> _passable;
+	std::vector<int8_t> _doors;
+	std::vector<int8_t> _occupant;
+	MapObject _objects[MapObject::IdMax + 1];
+	bool _destroyed[MapObject::IdMax + 1];
+	std::vector<Unit> _units;
+	std::vector<Compactor> _compactors;
+	int _tick = 0;
+
+	bool _recordTrajectories = false;
+	std::vector<std::vector<QPoint>> _trajectories;
+	std::vector<uint32_t> _heatmap;
+	uint32_t _heatmapMax = 0;
+};
+
+#endif // GAMESIMULATOR_H
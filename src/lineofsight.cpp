@@ -0,0 +1,243 @@
+#include "lineofsight.h"
+#include <QRect>
+#include <algorithm>
+#include <cstring>
+#include "constants.h"
+#include "map.h"
+#include "tile.h"
+#include "tileset.h"
+
+
+/** @class LineOfSight
+ * Computes the danger zones of the robots on a map: the tiles each robot has
+ * a clear line of sight to along its row and its column. A line of sight
+ * extends over tiles with the #Tile::ShootThrough attribute and ends at the
+ * first tile without it.
+ *
+ * For every tile, the extent of the run of shoot-through tiles it belongs to
+ * is stored for its row and for its column. These run tables are built in a
+ * single pass over the map, after which a robot's sight lines are a few
+ * lookups. The number of robots watching each tile is counted, so robots can
+ * be added and removed individually.
+ *
+ * #update() is incremental: it compares the map to the state it saw last
+ * time, rebuilds the run tables only for rows and columns whose tiles
+ * changed, and only touches the robots whose sight lines changed. The overlay
+ * #image() is updated along with the counts.
+ */
+
+
+bool LineOfSight::Sight::operator==(const LineOfSight::Sight &other) const {
+	return valid == other.valid and attacker == other.attacker and x == other.x and y == other.y
+	        and left == other.left and right == other.right and top == other.top
+	        and bottom == other.bottom;
+}
+
+
+LineOfSight::LineOfSight(const Tileset &tileset) {
+	for (int tileNo = 0; tileNo < 256; ++tileNo) {
+		_shootThroughTile[tileNo] = tileset.tile(tileNo).attributes().testFlag(Tile::ShootThrough);
+	}
+}
+
+
+/** Bring the danger zones up to date with \a map. */
+void LineOfSight::update(const Map &map) {
+	if (not _valid or _width != map.width() or _height != map.height()) {
+		rebuild(map);
+	} else {
+		updateTiles(map);
+	}
+
+	for (MapObject::id_t id = MapObject::IdRobotMin; id <= MapObject::IdRobotMax; ++id) {
+		const Sight sight = computeSight(map.object(id));
+		if (sight != _sights[id]) {
+			apply(_sights[id], -1);
+			apply(sight, 1);
+			_sights[id] = sight;
+		}
+	}
+}
+
+
+/** Discard all state, so that the next #update() starts from scratch. */
+void LineOfSight::invalidate() {
+	_valid = false;
+}
+
+
+/** The sight lines of the robot \a robotId, as of the last #update(). */
+const LineOfSight::Sight &LineOfSight::sight(MapObject::id_t robotId) const {
+	Q_ASSERT(MapObject::IdRobotMin <= robotId and robotId <= MapObject::IdRobotMax);
+	return _sights[robotId];
+}
+
+
+/** The number of robots that can see \a position. */
+int LineOfSight::watcherCount(const QPoint &position) const {
+	return _robotCount.at(index(position.x(), position.y()));
+}
+
+
+/** Whether an attack hoverbot or an evilbot can see \a position. */
+bool LineOfSight::isSeenByAttacker(const QPoint &position) const {
+	return _attackerCount.at(index(position.x(), position.y())) > 0;
+}
+
+
+/** An overlay with one pixel per tile, shading the tiles seen by robots. */
+const QImage &LineOfSight::image() const {
+	return _image;
+}
+
+
+/** Whether \a unitType is one of the robots that actively hunt the player. */
+bool LineOfSight::isAttacker(MapObject::UnitType unitType) {
+	return unitType == MapObject::UnitType::HoverbotAttack or unitType == MapObject::UnitType::Evilbot;
+}
+
+
+void LineOfSight::rebuild(const Map &map) {
+	_width = map.width();
+	_height = map.height();
+	const int size = _width * _height;
+	_tiles.assign(map.tiles(), map.tiles() + size);
+	_shootThrough.resize(size);
+	for (int i = 0; i < size; ++i) {
+		_shootThrough[i] = _shootThroughTile[_tiles[i]];
+	}
+	_runLeft.resize(size);
+	_runRight.resize(size);
+	_runTop.resize(size);
+	_runBottom.resize(size);
+	for (int y = 0; y < _height; ++y) { makeRowRuns(y); }
+	for (int x = 0; x < _width; ++x) { makeColumnRuns(x); }
+
+	_robotCount.assign(size, 0);
+	_attackerCount.assign(size, 0);
+	std::fill(std::begin(_sights), std::end(_sights), Sight());
+	_image = QImage(_width, _height, IMAGE_FORMAT);
+	_image.fill(Qt::transparent);
+	_valid = true;
+}
+
+
+/** Find the rows and columns in which tiles changed since the last update,
+ * and rebuild their run tables.
+ */
+void LineOfSight::updateTiles(const Map &map) {
+	const uint8_t *tiles = map.tiles();
+	std::vector<bool> changedColumns(_width, false);
+	for (int y = 0; y < _height; ++y) {
+		const int offset = index(0, y);
+		if (memcmp(&_tiles[offset], tiles + offset, _width) == 0) { continue; }
+		for (int x = 0; x < _width; ++x) {
+			const int i = offset + x;
+			if (_tiles[i] != tiles[i]) {
+				_tiles[i] = tiles[i];
+				_shootThrough[i] = _shootThroughTile[tiles[i]];
+				changedColumns[x] = true;
+			}
+		}
+		makeRowRuns(y);
+	}
+	for (int x = 0; x < _width; ++x) {
+		if (changedColumns[x]) { makeColumnRuns(x); }
+	}
+}
+
+
+void LineOfSight::makeRowRuns(int y) {
+	int start = 0;
+	for (int x = 0; x <= _width; ++x) {
+		if (x < _width and _shootThrough[index(x, y)]) { continue; }
+		// the run from start to x - 1 ends here
+		for (int i = start; i < x; ++i) {
+			_runLeft[index(i, y)] = start;
+			_runRight[index(i, y)] = x - 1;
+		}
+		if (x < _width) {
+			_runLeft[index(x, y)] = x;
+			_runRight[index(x, y)] = x;
+		}
+		start = x + 1;
+	}
+}
+
+
+void LineOfSight::makeColumnRuns(int x) {
+	int start = 0;
+	for (int y = 0; y <= _height; ++y) {
+		if (y < _height and _shootThrough[index(x, y)]) { continue; }
+		for (int i = start; i < y; ++i) {
+			_runTop[index(x, i)] = start;
+			_runBottom[index(x, i)] = y - 1;
+		}
+		if (y < _height) {
+			_runTop[index(x, y)] = y;
+			_runBottom[index(x, y)] = y;
+		}
+		start = y + 1;
+	}
+}
+
+
+/** A robot sees along the runs of shoot-through tiles next to it. Its own
+ * tile doesn't need to be shoot-through.
+ */
+LineOfSight::Sight LineOfSight::computeSight(const MapObject &robot) const {
+	Sight sight;
+	if (robot.group() != MapObject::Group::Robots or robot.x >= _width or robot.y >= _height) {
+		return sight;
+	}
+	const int x = robot.x;
+	const int y = robot.y;
+	sight.valid = true;
+	sight.attacker = isAttacker(robot.unitType);
+	sight.x = x;
+	sight.y = y;
+	sight.left = x > 0 and _shootThrough[index(x - 1, y)] ? _runLeft[index(x - 1, y)] : x;
+	sight.right = x < _width - 1 and _shootThrough[index(x + 1, y)] ? _runRight[index(x + 1, y)] : x;
+	sight.top = y > 0 and _shootThrough[index(x, y - 1)] ? _runTop[index(x, y - 1)] : y;
+	sight.bottom = y < _height - 1 and _shootThrough[index(x, y + 1)] ? _runBottom[index(x, y + 1)] : y;
+	return sight;
+}
+
+
+void LineOfSight::apply(const Sight &sight, int delta) {
+	if (not sight.valid) { return; }
+	for (int x = sight.left; x <= sight.right; ++x) {
+		changeCount(index(x, sight.y), sight.attacker, delta);
+	}
+	for (int y = sight.top; y <= sight.bottom; ++y) {
+		if (y != sight.y) {
+			changeCount(index(sight.x, y), sight.attacker, delta);
+		}
+	}
+}
+
+
+void LineOfSight::changeCount(int i, bool attacker, int delta) {
+	const bool wasSeen = _robotCount[i] > 0;
+	const bool wasSeenByAttacker = _attackerCount[i] > 0;
+	_robotCount[i] += delta;
+	if (attacker) { _attackerCount[i] += delta; }
+
+	const bool seen = _robotCount[i] > 0;
+	const bool seenByAttacker = _attackerCount[i] > 0;
+	if (seen != wasSeen or seenByAttacker != wasSeenByAttacker) {
+		QRgb *pixel = reinterpret_cast<QRgb*>(_image.scanLine(i / _width)) + i % _width;
+		if (seenByAttacker) {
+			*pixel = qPremultiply(C::colorDangerAttacker.rgba());
+		} else if (seen) {
+			*pixel = qPremultiply(C::colorDanger.rgba());
+		} else {
+			*pixel = 0;
+		}
+	}
+}
+
+
+int LineOfSight::index(int x, int y) const {
+	return x + _width * y;
+}
@@ -0,0 +1,71 @@
+#ifndef LINEOFSIGHT_H
+#define LINEOFSIGHT_H
+
+#include <QImage>
+#include <QPoint>
+#include <cstdint>
+#include <vector>
+#include "mapobject.h"
+
+class Map;
+class Tileset;
+
+
+class LineOfSight {
+public:
+	/** The tiles a robot can see: a row segment and a column segment through
+	 * its position.
+	 */
+	struct Sight {
+		bool valid = false;
+		bool attacker = false;
+		uint8_t x = 0;
+		uint8_t y = 0;
+		uint8_t left = 0;
+		uint8_t right = 0;
+		uint8_t top = 0;
+		uint8_t bottom = 0;
+
+		bool operator==(const Sight &other) const;
+		bool operator!=(const Sight &other) const { return not (*this == other); }
+	};
+
+	LineOfSight(const Tileset &tileset);
+
+	void update(const Map &map);
+	void invalidate();
+
+	const Sight &sight(MapObject::id_t robotId) const;
+	int watcherCount(const QPoint &position) const;
+	bool isSeenByAttacker(const QPoint &position) const;
+	const QImage &image() const;
+
+	static bool isAttacker(MapObject::UnitType unitType);
+
+private:
+	void rebuild(const Map &map);
+	void updateTiles(const Map &map);
+	void makeRowRuns(int y);
+	void makeColumnRuns(int x);
+	Sight computeSight(const MapObject &robot) const;
+	void apply(const Sight &sight, int delta);
+	void changeCount(int i, bool attacker, int delta);
+	int index(int x, int y) const;
+
+	bool _shootThroughTile[256];
+	bool _valid = false;
+	int _width = 0;
+	int _height = 0;
+	std::vector<uint8_t> _tiles;
+	std::vector<bool> _shootThrough;
+	std::vector<uint8_t> _runLeft;
+	std::vector<uint8_t> _runRight;
+	std::vector<uint8_t> _runTop;
+	std::vector<uint8_t> _runBottom;
+	std::vector<uint8_t> _robotCount;
+	std::vector<uint8_t> _attackerCount;
+	Sight _sights[MapObject::IdRobotMax + 1];
+	QImage _image;
+};
+
+#endif // LINEOFSIGHT_H
@@ -1,17 +1,51 @@
 #include "mainwindow.h"
 #include <QApplication>
+#include <QCoreApplication>
 #include <QFile>
 #include <QFontDatabase>
 #include <QIcon>
+#include <cstring>
+#include "batchvalidator.h"
+#include "maparchivetool.h"
+#include "mapdifftool.h"
+#include "mapindextool.h"
 
 #define STR(x) _STR(x)
 #define _STR(x) #x
 
+static bool hasArgument(int argc, char *argv[], const char *argument) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], argument) == 0) { return true; }
+	}
+	return false;
+}
+
+
 int main(int argc, char *argv[]) {
 	QApplication::setApplicationName("PETSCII Robots Map Editor");
 	QApplication::setApplicationVersion(STR(APP_VERSION));
 	QApplication::setOrganizationDomain("maxlor.com");
 	QApplication::setOrganizationName("Benjamin Lutz");
+	
+	// the command line tools run without a GUI, so they work without a display
+	if (hasArgument(argc, argv, "--validate")) {
+		QCoreApplication a(argc, argv);
+		return BatchValidator::run(a.arguments());
+	}
+	if (hasArgument(argc, argv, "--diff") or hasArgument(argc, argv, "--merge")) {
+		QCoreApplication a(argc, argv);
+		return MapDiffTool::run(a.arguments());
+	}
+	if (hasArgument(argc, argv, "--index")) {
+		QCoreApplication a(argc, argv);
+		return MapIndexTool::run(a.arguments());
+	}
+	if (hasArgument(argc, argv, "--pack") or hasArgument(argc, argv, "--unpack")
+	        or hasArgument(argc, argv, "--archive-info")) {
+		QCoreApplication a(argc, argv);
+		return MapArchiveTool::run(a.arguments());
+	}
+	
 	QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 	QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
 	
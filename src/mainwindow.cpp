@@ -1,21 +1,33 @@
 #include "mainwindow.h"
 #include <QApplication>
+#include <QClipboard>
 #include <QDialogButtonBox>
 #include <QDir>
+#include <QDockWidget>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFontMetrics>
+#include <QInputDialog>
 #include <QKeyEvent>
 #include <QMessageBox>
 #include <QSettings>
+#include <QSignalBlocker>
 #include <QStringList>
 #include <QTextBrowser>
 #include <QVBoxLayout>
+#include <vector>
 #include "iconfactory.h"
 #include "map.h"
+#include "maparchive.h"
 #include "mapcheck.h"
+#include "mapclipboard.h"
+#include "mapdiff.h"
+#include "mapindexwidget.h"
 #include "multisignalblocker.h"
+#include "patternsearch.h"
+#include "statisticswidget.h"
 #include "tileset.h"
+#include "trace.h"
 #include "util.h"
 #include "validationdialog.h"
 
@@ -31,6 +43,7 @@ static constexpr char SETTINGS_MAP_PATH[] = "General/MapPath";
 
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
+	TRACE_SCOPE("MainWindow::MainWindow");
 	const QSettings settings;
 	
 	_ui.setupUi(this);
@@ -68,6 +81,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 	QMenu *randomizeMenu = _ui.menuEdit->addMenu("Randomize");
 	randomizeMenu->addAction(_ui.actionRandomizeDirt);
 	randomizeMenu->addAction(_ui.actionRandomizeGrass);
+	_ui.menuEdit->addAction(_ui.actionRewall);
+	_ui.menuEdit->addSeparator();
+	_ui.menuEdit->addAction(_ui.actionFindPattern);
+	_ui.menuEdit->addAction(_ui.actionReplacePattern);
 	
 	_paletteMenu = new QMenu("&Color Palette", _ui.menuView);
 	_ui.menuView->insertSeparator(nullptr);
@@ -120,6 +137,42 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 	_ui.mapWidget->setMap(_mapController->map());
 	_ui.objectEditor->setMapController(_mapController);
 	updateMapCountLabels();
+	
+	connect(_mapController->map(), &Map::tilesChanged, this, &MainWindow::updatePatternMatches);
+	
+	_statisticsWidget = new StatisticsWidget();
+	_statisticsWidget->setTileset(_tileset);
+	_statisticsWidget->setMap(_mapController->map());
+	QDockWidget *statisticsDock = new QDockWidget("Statistics", this);
+	statisticsDock->setObjectName("statisticsDock");
+	statisticsDock->setWidget(_statisticsWidget);
+	addDockWidget(Qt::RightDockWidgetArea, statisticsDock);
+	statisticsDock->hide();
+	_ui.menuView->insertAction(_paletteMenu->menuAction(), statisticsDock->toggleViewAction());
+	connect(_statisticsWidget, &StatisticsWidget::markedTileChanged, _ui.mapWidget, &MapWidget::setMarkedTile);
+	connect(_statisticsWidget, &StatisticsWidget::replaceTileRequested, this, [this](uint8_t tileNo) {
+		_mapController->replaceTile(tileNo, _ui.tileWidget->selectedTile());
+	});
+	
+	MapIndexWidget *mapIndexWidget = new MapIndexWidget();
+	QDockWidget *mapIndexDock = new QDockWidget("Map Search", this);
+	mapIndexDock->setObjectName("mapIndexDock");
+	mapIndexDock->setWidget(mapIndexWidget);
+	addDockWidget(Qt::RightDockWidgetArea, mapIndexDock);
+	mapIndexDock->hide();
+	_ui.menuView->insertAction(_paletteMenu->menuAction(), mapIndexDock->toggleViewAction());
+	_ui.menuView->insertSeparator(_paletteMenu->menuAction());
+	connect(mapIndexWidget, &MapIndexWidget::openMapRequested, this, &MainWindow::openMap);
+#ifdef ENABLE_TRACING
+	QAction *performanceOverlayAction = new QAction("Performance &Overlay", this);
+	performanceOverlayAction->setCheckable(true);
+	connect(performanceOverlayAction, &QAction::toggled, _ui.mapWidget, &MapWidget::setShowPerformanceOverlay);
+	QAction *saveTraceAction = new QAction("Save Performance &Trace...", this);
+	connect(saveTraceAction, &QAction::triggered, this, &MainWindow::onSaveTrace);
+	_ui.menuView->insertAction(_paletteMenu->menuAction(), performanceOverlayAction);
+	_ui.menuView->insertAction(_paletteMenu->menuAction(), saveTraceAction);
+	_ui.menuView->insertSeparator(_paletteMenu->menuAction());
+#endif
 	_ui.menuEdit->insertSeparator(_ui.menuEdit->actions().at(0));
 	_ui.menuEdit->insertAction(_ui.menuEdit->actions().at(0), _mapController->redoAction());
 	_ui.menuEdit->insertAction(_ui.menuEdit->actions().at(0), _mapController->undoAction());
@@ -155,6 +208,9 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 	connect(_ui.actionFill, &QAction::triggered, this, &MainWindow::onFillTriggered);
 	connect(_ui.actionRandomizeDirt, &QAction::triggered, this, &MainWindow::onRandomizeDirt);
 	connect(_ui.actionRandomizeGrass, &QAction::triggered, this, &MainWindow::onRandomizeGrass);
+	connect(_ui.actionRewall, &QAction::triggered, this, &MainWindow::onRewall);
+	connect(_ui.actionFindPattern, &QAction::toggled, this, &MainWindow::onFindPatternToggled);
+	connect(_ui.actionReplacePattern, &QAction::triggered, this, &MainWindow::onReplacePattern);
 	
 	for (QAction *action : _viewFilterActions) {
 		connect(action, &QAction::triggered, this, &MainWindow::onViewFilterChanged);
@@ -167,6 +223,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 	connect(_ui.actionShowObjects, &QAction::toggled, this, &MainWindow::onShowObjectsToggled);
 	connect(_ui.actionShowObjects, &QAction::toggled, _ui.mapWidget, &MapWidget::setObjectsVisible);
 	connect(_ui.actionShowGrid, &QAction::toggled, _ui.mapWidget, &MapWidget::setShowGridLines);
+	connect(_ui.actionShowReachability, &QAction::toggled, _ui.mapWidget, &MapWidget::setShowReachability);
+	connect(_ui.actionShowSimulation, &QAction::toggled, _ui.mapWidget, &MapWidget::setShowSimulation);
+	connect(_ui.actionShowDangerZones, &QAction::toggled, _ui.mapWidget, &MapWidget::setShowDangerZones);
+	connect(_ui.actionCompareMap, &QAction::toggled, this, &MainWindow::onCompareMapToggled);
 	
 	for (QAction *action : _toolActions) {
 		connect(action, &QAction::triggered, this, &MainWindow::onToolActionTriggered);
@@ -183,11 +243,19 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 	connect(_ui.mapWidget, &MapWidget::tilePressed, this, &MainWindow::onTilePressed);
 	connect(_ui.mapWidget, &MapWidget::tileDragged, this, &MainWindow::onTileDragged);
 	connect(_ui.mapWidget, &MapWidget::released, this, &MainWindow::onReleased);
+	connect(_ui.mapWidget, &MapWidget::floatingSelectionDropped, this, &MainWindow::commitFloatingSelection);
 	connect(_ui.tileWidget, &TileWidget::tileSelected, this, &MainWindow::onTileWidgetTileSelected);
 	connect(_ui.objectEditor, &ObjectEditWidget::mapClickRequested, this, &MainWindow::onObjectEditMapClickRequested);
 	
 	connect(_tileset, &Tileset::changed, this, &MainWindow::onTilesetChanged);
-	connect(_mapController->map(), &Map::objectsChanged, this, &MainWindow::updateMapCountLabels);
+	connect(_tileset, &Tileset::loaded, this, &MainWindow::onTilesetLoaded);
+	connect(_mapController->map(), &Map::objectsChanged, this,
+	        [this](quint64, Map::ObjectChanges changes) {
+		// moving or editing objects leaves the counts unchanged
+		if (changes & (Map::ObjectChange::Added | Map::ObjectChange::Removed)) {
+			updateMapCountLabels();
+		}
+	});
 	
 	const QRect geometry = settings.value(SETTINGS_WINDOW_GEOMETRY).toRect();
 	if (geometry.isValid()) { setGeometry(geometry); }
@@ -244,7 +312,7 @@ void MainWindow::onAbout() {
 
 
 void MainWindow::onLoadPetTileset() {
-	const QString path = tilesetPetPath(false);
+	const QString path = Tileset::bundledPath(false);
 	
 	if (path.isEmpty()) {
 		QMessageBox::critical(this, "Error Loading Tileset",
@@ -265,7 +333,7 @@ void MainWindow::onLoadPetTileset() {
 
 
 void MainWindow::onLoadColorPetsciiTileset() {
-	const QString path = tilesetPetPath(true);
+	const QString path = Tileset::bundledPath(true);
 	
 	if (path.isEmpty()) {
 		QMessageBox::critical(this, "Error Loading Tileset",
@@ -328,6 +396,7 @@ void MainWindow::onObjectEditMapClickRequested(const QString &label) {
 
 
 void MainWindow::onNewTriggered() {
+	commitFloatingSelection();
 	if (not _mapController->map()->isModified() or askSaveChanges()) {
 		_mapController->clear();
 	}
@@ -335,18 +404,25 @@ void MainWindow::onNewTriggered() {
 
 
 void MainWindow::onOpenTriggered() {
+	commitFloatingSelection();
 	if (not _mapController->map()->isModified() or askSaveChanges()) {
 		QSettings settings;
 		QString directory = settings.value(SETTINGS_MAP_DIRECTORY, QDir::homePath()).toString();		
 		QFileDialog dialog(this, "Open Map...", directory);
 		dialog.setAcceptMode(QFileDialog::AcceptOpen);
 		dialog.setFileMode(QFileDialog::ExistingFile);
-		dialog.setNameFilters({"PETSCII Robot Maps (*.petmap)", "All Files (*)"});
+		dialog.setNameFilters({"PETSCII Robot Maps (*.petmap)",
+		                       QString("Episode Archives (*.%1)").arg(MapArchive::fileExtension()),
+		                       "All Files (*)"});
 		int result = dialog.exec();
 		if (result == QFileDialog::Accepted) {
 			if (dialog.selectedFiles().size() > 0) {
 				QString path = dialog.selectedFiles().at(0);
 				settings.setValue(SETTINGS_MAP_DIRECTORY, dialog.directory().canonicalPath());
+				if (QFileInfo(path).suffix() == MapArchive::fileExtension()) {
+					openArchive(path);
+					return;
+				}
 				QString error = _mapController->load(path);
 				if (error.isNull()) {
 					settings.setValue(SETTINGS_MAP_PATH, path);
@@ -360,6 +436,24 @@ void MainWindow::onOpenTriggered() {
 }
 
 
+/** Opens the map at \a path, after asking to save the current one, and
+ * selects the object \a objectId in it.
+ */
+void MainWindow::openMap(const QString &path, MapObject::id_t objectId) {
+	if (path != _mapController->map()->path()) {
+		commitFloatingSelection();
+		if (_mapController->map()->isModified() and not askSaveChanges()) { return; }
+		const QString error = _mapController->load(path);
+		if (not error.isNull()) {
+			QMessageBox::critical(this, "Error Opening Map", QString("Cannot open map: %1").arg(error));
+			return;
+		}
+		QSettings().setValue(SETTINGS_MAP_PATH, path);
+	}
+	if (objectId != MapObject::IdNone) { onObjectClicked(objectId); }
+}
+
+
 void MainWindow::onSaveTriggered() {
 	save();
 }
@@ -405,29 +499,30 @@ void MainWindow::onPasteTriggered() {
 		return;
 	}
 	
-	if (_clipboardTilesValid) {
-		auto it = _clipboardTiles.begin();
-		for (int y = 0; y < _clipboardSize.height(); ++y) {
-			for (int x = 0; x < _clipboardSize.width(); ++x) {
-				Q_ASSERT(it != _clipboardTiles.end());
-				_mapController->setTile(rect.topLeft() + QPoint(x, y), *it++);
-			}
-		}
-	}
-	bool addedAllObjects = true;
-	for (auto it = _clipboardObjects.begin(); it != _clipboardObjects.end(); ++it) {
-		MapObject object = *it;
-		if (object.group() == MapObject::Group::Invalid) { continue; }
-		MapObject::id_t objectId = _mapController->map()->nextAvailableObjectId(object.group());
-		if (objectId != MapObject::IdNone) {
-			object.x += rect.left();
-			object.y += rect.top();
-			_mapController->setObject(objectId, object);
-		} else {
-			addedAllObjects = false;
-		}
+	const MapClipboard clipboard = MapClipboard::fromMimeData(QApplication::clipboard()->mimeData());
+	if (clipboard.isNull()) {
+		QMessageBox::warning(this, "Cannot Paste",
+		                     "Cannot paste, because the clipboard doesn't contain any map data.");
+		return;
 	}
 	
+	commitFloatingSelection();
+	_ui.mapWidget->setFloatingSelection(clipboard, rect.topLeft());
+}
+
+
+/** Apply the map widget's floating selection to the map, as a single undo
+ * action.
+ */
+void MainWindow::commitFloatingSelection() {
+	MapWidget *mapWidget = _ui.mapWidget;
+	if (not mapWidget->hasFloatingSelection()) { return; }
+	
+	const bool addedAllObjects = _mapController->pasteArea(
+	            mapWidget->floatingSelection(), mapWidget->floatingSelectionPosition(),
+	            mapWidget->floatingSelectionSource(), mapWidget->floatingSelectionMovesObjects());
+	mapWidget->clearFloatingSelection();
+	
 	if (not addedAllObjects) {
 		QMessageBox::information(this, "Not All Objects Were Pasted",
 		                         "Not all objects were pasted because not enough unused object "
@@ -459,6 +554,107 @@ void MainWindow::onRandomizeGrass() {
 }
 
 
+void MainWindow::onRewall() {
+	_mapController->rewall(workRect());
+}
+
+
+void MainWindow::onFindPatternToggled(bool checked) {
+	_patternSearch.reset();
+	if (checked) {
+		const MapClipboard clipboard = MapClipboard::fromMimeData(QApplication::clipboard()->mimeData());
+		if (clipboard.isNull() or not clipboard.hasTiles()) {
+			QMessageBox::warning(this, "Cannot Find Pattern",
+			                     "Cannot find a pattern, because the clipboard doesn't contain any tiles. "
+			                     "Please copy an area of the map first.");
+			const QSignalBlocker blocker(_ui.actionFindPattern);
+			_ui.actionFindPattern->setChecked(false);
+			return;
+		}
+		_patternSearch = std::make_unique<PatternSearch>(clipboard.tiles(), clipboard.size());
+	}
+	updatePatternMatches();
+}
+
+
+void MainWindow::onReplacePattern() {
+	if (not _patternSearch or _patternMatches.empty()) { return; }
+	const MapClipboard clipboard = MapClipboard::fromMimeData(QApplication::clipboard()->mimeData());
+	if (clipboard.isNull() or not clipboard.hasTiles() or clipboard.size() != _patternSearch->size()) {
+		QMessageBox::warning(this, "Cannot Replace Pattern",
+		                     QString("Cannot replace the pattern, because the clipboard doesn't contain "
+		                             "an area of the same size (%1×%2). Please copy the replacement first.")
+		                     .arg(_patternSearch->size().width()).arg(_patternSearch->size().height()));
+		return;
+	}
+	const std::vector<QPoint> matches = PatternSearch::nonOverlapping(_patternMatches, clipboard.size());
+	_mapController->replacePattern(matches, clipboard.size(), clipboard.tiles());
+}
+
+
+/** Searches the map for the current pattern again, and highlights the
+ * matches. Called whenever the map's tiles change.
+ */
+void MainWindow::updatePatternMatches() {
+	if (not _patternSearch) {
+		if (not _patternMatches.empty()) { _ui.statusbar->clearMessage(); }
+		_patternMatches.clear();
+		_ui.mapWidget->setPatternMatches(_patternMatches, QSize());
+		_ui.actionReplacePattern->setEnabled(false);
+		return;
+	}
+	const Map *map = _mapController->map();
+	_patternMatches = _patternSearch->find(map->tiles(), map->width(), map->height());
+	_ui.mapWidget->setPatternMatches(_patternMatches, _patternSearch->size());
+	_ui.actionReplacePattern->setEnabled(not _patternMatches.empty());
+	const int count = _patternMatches.size();
+	_ui.statusbar->showMessage(QString("%1 pattern match%2").arg(count).arg(count == 1 ? "" : "es"));
+}
+
+
+void MainWindow::onCompareMapToggled(bool checked) {
+	_ui.mapWidget->setCompareMap(nullptr);
+	_compareMap.reset();
+	if (not checked) { return; }
+	
+	QSettings settings;
+	const QString directory = settings.value(SETTINGS_MAP_DIRECTORY, QDir::homePath()).toString();
+	const QString path = QFileDialog::getOpenFileName(this, "Compare with Map...", directory,
+	                                                  "PETSCII Robot Maps (*.petmap);;All Files (*)");
+	std::unique_ptr<Map> map = std::make_unique<Map>();
+	const QString error = path.isEmpty() ? QString() : map->load(path);
+	if (path.isEmpty() or not error.isNull()) {
+		if (not error.isNull()) {
+			QMessageBox::critical(this, "Error Opening Map", QString("Cannot open map: %1").arg(error));
+		}
+		const QSignalBlocker blocker(_ui.actionCompareMap);
+		_ui.actionCompareMap->setChecked(false);
+		return;
+	}
+	
+	_compareMap = std::move(map);
+	_ui.mapWidget->setCompareMap(_compareMap.get());
+	const MapDiff diff(*_compareMap, *_mapController->map());
+	_ui.statusbar->showMessage(QString("%1 tiles and %2 objects differ from %3")
+	                           .arg(diff.changedTileCount()).arg(diff.objectDeltas().size())
+	                           .arg(QFileInfo(path).fileName()));
+}
+
+
+#ifdef ENABLE_TRACING
+void MainWindow::onSaveTrace() {
+	const QString path = QFileDialog::getSaveFileName(this, "Save Performance Trace...",
+	                                                  QDir::homePath() + "/petmap-trace.json",
+	                                                  "Trace Files (*.json);;All Files (*)");
+	if (path.isEmpty()) { return; }
+	const QString error = Trace::write(path);
+	if (not error.isNull()) {
+		QMessageBox::critical(this, "Error Saving Trace", QString("Cannot save trace: %1").arg(error));
+	}
+}
+#endif
+
+
 void MainWindow::onShowObjectsToggled(bool checked) {
 	if (_ui.actionSelectArea->isChecked()) {
 		_ui.actionCopyObjects->setEnabled(checked);
@@ -591,6 +787,14 @@ void MainWindow::onTilesetChanged() {
 }
 
 
+void MainWindow::onTilesetLoaded(const QString &path, const QString &error) {
+	Q_UNUSED(path);
+	if (not error.isNull()) {
+		QMessageBox::critical(this, "Error Loading Tileset", "Could not load the tileset: " + error);
+	}
+}
+
+
 void MainWindow::showHowToUse() {
 	if (_howToUseDialog == nullptr) {
 		_howToUseDialog = new QDialog(this);
@@ -660,6 +864,50 @@ void MainWindow::updateMapCountLabels() {
 }
 
 
+/** Lets the user pick one of the maps in the archive at \a path and opens it.
+ * The map isn't associated with a file afterwards.
+ */
+void MainWindow::openArchive(const QString &path) {
+	commitFloatingSelection();
+	MapArchive archive;
+	QString error = archive.open(path);
+	if (error.isNull() and archive.mapCount() == 0) {
+		error = "the archive contains no maps";
+	}
+	if (not error.isNull()) {
+		QMessageBox::critical(this, "Error Opening Map", QString("Cannot open map: %1").arg(error));
+		return;
+	}
+	
+	QStringList names;
+	for (int i = 0; i < archive.mapCount(); ++i) {
+		names.append(archive.mapName(i));
+	}
+	bool ok = false;
+	const QString name = QInputDialog::getItem(this, "Open Map...", "Map:", names, 0, false, &ok);
+	const int index = names.indexOf(name);
+	if (not ok or index < 0) { return; }
+	
+	QByteArray data;
+	error = archive.mapData(index, &data);
+	if (error.isNull()) {
+		error = _mapController->loadData(data);
+	}
+	if (not error.isNull()) {
+		QMessageBox::critical(this, "Error Opening Map", QString("Cannot open map: %1").arg(error));
+		return;
+	}
+	
+	if (archive.hasTileset()) {
+		error = _tileset->loadData(archive.tilesetData());
+		if (not error.isNull()) {
+			QMessageBox::critical(this, "Error Loading Tileset",
+			                      "Could not load the tileset from the archive: " + error);
+		}
+	}
+}
+
+
 bool MainWindow::askSaveChanges() {
 	static const auto buttons = QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel;
 	const auto button =  QMessageBox::question(this, "New Map", "There are unsaved changes. Do you "
@@ -680,7 +928,7 @@ void MainWindow::autoLoadTileset() {
 	if (settings.contains(SETTINGS_TILESET_PATH)) {
 		path = settings.value(SETTINGS_TILESET_PATH).toString();
 	} else {
-		path = tilesetPetPath(settings.value(SETTINGS_COLOR_PETSCII_TILESET).toBool());
+		path = Tileset::bundledPath(settings.value(SETTINGS_COLOR_PETSCII_TILESET).toBool());
 	}
 	
 	if (path.isEmpty()) {
@@ -692,13 +940,8 @@ void MainWindow::autoLoadTileset() {
 		return;
 	}
 	
-	QString error = _tileset->load(path);
-	if (not error.isNull()) {
-		QMetaObject::invokeMethod(this, [=]() {
-			QMessageBox::critical(this, "Error Loading Tileset",
-								  "Could not load the tileset: " + error);
-		}, Qt::QueuedConnection);
-	}
+	// the window appears while the tileset loads, with a placeholder instead of tiles
+	_tileset->loadAsync(path);
 }
 
 
@@ -721,26 +964,9 @@ QString MainWindow::pickTileset() {
 }
 
 
-QString MainWindow::tilesetPetPath(bool color) const {
-	QStringList directories = {
-#ifdef Q_OS_UNIX
-		QString("%1/../share/%2").arg(QApplication::applicationDirPath(),
-		                              QFileInfo(QApplication::applicationFilePath()).baseName()),
-	    QString("%1/../share").arg(QApplication::applicationDirPath()),
-#endif
-		QApplication::applicationDirPath(),
-	};
-	for (const QString &dir : directories) {
-		const QString path = dir + "/tileset." + (color ? "c64" : "pet");
-		if (QFile::exists(path)) {
-			return path;
-		}
-	}
-	return QString();
-}
-
-
 void MainWindow::activateTool(QAction *const action) {
+	commitFloatingSelection();
+	
 	for (QAction *toolAction : _toolActions) {
 		toolAction->setChecked(action == toolAction);
 	}
@@ -777,38 +1003,30 @@ void MainWindow::activateTool(QAction *const action) {
 
 
 void MainWindow::copyMap(bool copyTiles, bool copyObjects, bool clear) {
+	commitFloatingSelection();
 	const QRect &rect = _ui.mapWidget->selectedArea();
 	if (rect.isNull()) { return; }
 	
-	_clipboardSize = rect.size();
-	_clipboardTiles.clear();
-	_clipboardTilesValid = false;
-	_clipboardObjects.clear();
+	const Map &map = *_mapController->map();
+	const MapClipboard clipboard = MapClipboard::fromMap(map, rect, copyTiles, copyObjects);
+	QApplication::clipboard()->setMimeData(clipboard.toMimeData());
 	
-	if (copyTiles) {
-		for (int y = rect.bottom(); y >= rect.top(); --y) {
-			for (int x = rect.right(); x >= rect.left(); --x) {
-				_clipboardTiles.push_front(_mapController->map()->tileNo({x, y}));
-				if (clear) { _mapController->setTile({x, y}, 0); }
-			}
+	if (clear) {
+		_mapController->beginUndoGroup("Cut");
+		if (copyTiles) {
+			const std::vector<uint8_t> emptyTiles(rect.width() * rect.height(), 0);
+			_mapController->setTiles(rect, emptyTiles.data(), "Cut Tiles");
 		}
-		_clipboardTilesValid = true;
-	}
-	if (copyObjects) {
-		for (MapObject::id_t objectId = MapObject::IdMax; objectId >= MapObject::IdMin; --objectId) {
-			MapObject object = _mapController->map()->object(objectId);
-			if (rect.contains(object.pos())) {
-				object.x -= rect.left();
-				object.y -= rect.top();
-				_clipboardObjects.push_front(object);
-				if (clear) { _mapController->deleteObject(objectId); }
-			}
+		if (copyObjects) {
+			_mapController->deleteObjects(rect);
 		}
+		_mapController->endUndoGroup();
 	}
 }
 
 
 bool MainWindow::doSave(const QString &path) {
+	commitFloatingSelection();
 	QString error = _mapController->save(path);
 	if (not error.isNull()) {
 		QMessageBox::critical(this, "Cannot Save", "Saving failed: " + error);
@@ -9,11 +9,15 @@
 #include <QSignalMapper>
 #include <QSize>
 #include <forward_list>
+#include <memory>
+#include <vector>
 #include "iconfactory.h"
 #include "mapcontroller.h"
 #include "mapobject.h"
 
 class Map;
+class PatternSearch;
+class StatisticsWidget;
 class Tileset;
 
 
@@ -39,6 +43,7 @@ private slots:
 	
 	void onNewTriggered();
 	void onOpenTriggered();
+	void openMap(const QString &path, MapObject::id_t objectId);
 	void onSaveTriggered();
 	void onSaveAsTriggered();
 	
@@ -48,10 +53,19 @@ private slots:
 	void onCutAreaTriggered();
 	void onCutObjectsTriggered();
 	void onPasteTriggered();
+	void commitFloatingSelection();
 	void onFillTriggered();
 	void onRandomizeDirt();
 	void onRandomizeGrass();
+	void onRewall();
+	void onFindPatternToggled(bool checked);
+	void onReplacePattern();
+	void updatePatternMatches();
 	
+	void onCompareMapToggled(bool checked);
+#ifdef ENABLE_TRACING
+	void onSaveTrace();
+#endif
 	void onShowObjectsToggled(bool checked);
 	
 	void onTileCopied(uint8_t tileNo);
@@ -65,6 +79,7 @@ private slots:
 	void onPaletteActionTriggered();
 	
 	void onTilesetChanged();
+	void onTilesetLoaded(const QString &path, const QString &error);
 	
 	void showHowToUse();
 	void validateMap();
@@ -75,11 +90,11 @@ private:
 	
 	void autoLoadTileset();
 	QString pickTileset();
-	QString tilesetPetPath(bool color) const;
 	
 	void activateTool(QAction *const action);
 	void copyMap(bool copyTiles, bool copyObjects, bool clear=false);
 	bool doSave(const QString &path);
+	void openArchive(const QString &path);
 	void placeObject(MapObject::UnitType unitType, const QPoint &position);
 	bool save();
 	bool saveAs();
@@ -101,11 +116,10 @@ private:
 	MapObject::id_t _currentObject = MapObject::IdNone;
 	bool _objectEditMapClickRequested = false;
 	IconFactory _iconFactory;
-	
-	QSize _clipboardSize;
-	std::forward_list<uint8_t> _clipboardTiles;
-	bool _clipboardTilesValid;
-	std::forward_list<MapObject> _clipboardObjects;
+	StatisticsWidget *_statisticsWidget;
+	std::unique_ptr<PatternSearch> _patternSearch;
+	std::vector<QPoint> _patternMatches;
+	std::unique_ptr<Map> _compareMap;
 	
 	MapController *_mapController;
 };
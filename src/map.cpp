@@ -2,9 +2,16 @@
 #include <QFile>
 #include <QLoggingCategory>
 #include <QRect>
+#include <QtAlgorithms>
 #include <cstring>
 #include <forward_list>
 #include <utility>
+#include "trace.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MAP_SSE2
+#endif
 
 
 Q_LOGGING_CATEGORY(lcMap, "map");
@@ -15,13 +22,42 @@ static constexpr int MAP_WIDTH(128);
 static constexpr int MAP_HEIGHT(64);
 static constexpr size_t OBJECT_COUNT(64);
 static constexpr size_t TILE_COUNT(MAP_WIDTH * MAP_HEIGHT);
+static constexpr size_t OBJECTS_OFFSET(0x002);
+static constexpr size_t TILES_OFFSET(0x302);
+
+/** The objects are stored as in the map file: one plane of 64 bytes per
+ * attribute, indexed by object id.
+ */
+enum ObjectPlane { PlaneUnitType, PlaneX, PlaneY, PlaneA, PlaneB, PlaneC, PlaneD, PlaneHealth, PlaneCount };
+static constexpr size_t OBJECT_BYTES(OBJECT_COUNT * PlaneCount);
+
+
+static constexpr uint64_t idMask(MapObject::id_t min, MapObject::id_t max) {
+	return (~uint64_t(0) >> (63 - max)) & (~uint64_t(0) << min);
+}
+
+
+/** @fn Map::replaced
+ * 
+ * @brief Emitted when the whole map was replaced by #clear() or a load,
+ * before #tilesChanged() and #objectsChanged().
+ */
+
+/** @fn Map::objectsChanged
+ * 
+ * @brief Emitted once per modification of the objects. \a objectIds has bit n
+ * set if slot n changed, and \a changes tells how: added, removed, moved or
+ * otherwise modified. After a load, every slot is reported as changed.
+ */
 
 
 Map::Map(QObject *parent) : QObject(parent) {
-	_objects = new MapObject[OBJECT_COUNT];
+	_objects = new uint8_t[OBJECT_BYTES];
 	_tiles = new uint8_t[TILE_COUNT];
-	memset(_objects, 0, sizeof(_objects[0]) * OBJECT_COUNT);
+	memset(_objects, 0, OBJECT_BYTES);
 	memset(_tiles, 0, sizeof(_tiles[0]) * TILE_COUNT);
+	_tileIndex.reset(_tiles, width(), height());
+	reindexObjects();
 	
 	connect(this, &Map::objectsChanged, &Map::setModifiedFlag);
 	connect(this, &Map::tilesChanged, &Map::setModifiedFlag);
@@ -50,12 +86,15 @@ QRect Map::rect() const {
 
 
 void Map::clear() {
-	memset(_objects, 0, sizeof(_objects[0]) * OBJECT_COUNT);
+	memset(_objects, 0, OBJECT_BYTES);
 	memset(_tiles, 0, sizeof(_tiles[0]) * TILE_COUNT);
+	_tileIndex.reset(_tiles, width(), height());
+	reindexObjects();
 	
 	_modified = true; // make sure only one modifiedChanged signal is emitted	
 	setPath(QString());
-	emit objectsChanged();
+	emit replaced();
+	emitObjectsChanged(true);
 	emit tilesChanged();
 	setModified(false);
 }
@@ -75,18 +114,33 @@ QString Map::load(const QString &path) {
 		return QString("can't read file \"%1\": %2").arg(path, file.errorString());
 	}
 	
-	char magicBuffer[sizeof(MAP_MAGIC)];
-	qint64 bytesRead = file.read(magicBuffer, sizeof(magicBuffer));
-	if (bytesRead != sizeof(magicBuffer)) {
-		return QString("can't read magic of file \"%1\": got only %2 bytes but had requested %3")
-		        .arg(path).arg(bytesRead).arg(sizeof(magicBuffer));
+	const QByteArray data = file.readAll();
+	if (data.size() != int(MAP_BYTES)) {
+		return QString("can't read file \"%1\": got only %2 bytes but had requested %3")
+		        .arg(path).arg(data.size()).arg(MAP_BYTES);
+	}
+	return loadData(data, path);
+}
+
+
+/** Load the map from \a data, which must have the layout of a map file.
+ * \a path is only used as the map's path and in error messages.
+ * @return a null string on success, an error message otherwise
+ */
+QString Map::loadData(const QByteArray &data, const QString &path) {
+	TRACE_SCOPE("Map::loadData");
+	const QString name = path.isEmpty() ? QString("map") : QString("file \"%1\"").arg(path);
+	if (data.size() != int(MAP_BYTES)) {
+		return QString("%1 has size %2 but was expected to be size %3")
+		        .arg(name).arg(data.size()).arg(MAP_BYTES);
 	}
 	
+	const char *magicBuffer = data.constData();
 	for (size_t i = 0; i < sizeof(MAP_MAGIC); ++i) {
 		if (magicBuffer[i] != MAP_MAGIC[i]) {
-			return QString("file \"%1\" is invalid because its magic (0x%2%3) is wrong "
+			return QString("%1 is invalid because its magic (0x%2%3) is wrong "
                            "(it should be 0x%4%5)")
-			        .arg(path)
+			        .arg(name)
 			        .arg(static_cast<unsigned int>(magicBuffer[0]) & 0xFF, 2, 16, QChar('0'))
 			        .arg(static_cast<unsigned int>(magicBuffer[1]) & 0xFF, 2, 16, QChar('0'))
 			        .arg(static_cast<unsigned int>(MAP_MAGIC[0]) & 0xFF, 2, 16, QChar('0'))
@@ -94,21 +148,17 @@ QString Map::load(const QString &path) {
 		}
 	}
 	
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].unitType)); }
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].x)); }
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].y)); }
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].a)); }
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].b)); }
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].c)); }
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].d)); }
-	for (int i = 0; i < 64; ++i) { file.getChar(reinterpret_cast<char*>(&_objects[i].health)); }
-	file.seek(0x302);
-	file.read(reinterpret_cast<char*>(_tiles), 0x2000);
+	const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data.constData());
+	memcpy(_objects, bytes + OBJECTS_OFFSET, OBJECT_BYTES);
+	memcpy(_tiles, bytes + TILES_OFFSET, sizeof(_tiles[0]) * TILE_COUNT);
+	_tileIndex.reset(_tiles, width(), height());
+	reindexObjects();
 	
 	_modified = true; // make sure only one modifiedChanged signal is emitted
 	setPath(path);
+	emit replaced();
 	emit tilesChanged();
-	emit objectsChanged();
+	emitObjectsChanged(true);
 	setModified(false);
 	
 	return QString();
@@ -116,6 +166,7 @@ QString Map::load(const QString &path) {
 
 
 QString Map::save(const QString &path) {
+	TRACE_SCOPE("Map::save");
 	QFile file(path);
 	if (not file.open(QFile::WriteOnly)) {
 		return QString("cannot open \"%1\" for writing: %2") .arg(path, file.errorString());
@@ -136,84 +187,98 @@ QString Map::save(const QString &path) {
 
 
 int Map::hiddenItemCount() const {
-	int count = 0;
-	for (MapObject::id_t i = MapObject::IdHiddenMin; i <= MapObject::IdHiddenMax; ++i) {
-		if (_objects[i].unitType != MapObject::UnitType::None) { ++count; }
-	}
-	return count;
+	return qPopulationCount(quint64(_usedSlots & idMask(MapObject::IdHiddenMin, MapObject::IdHiddenMax)));
 }
 
 
 int Map::mapFeatureCount() const {
-	int count = 0;
-	for (MapObject::id_t i = MapObject::IdMapFeatureMin; i <= MapObject::IdMapFeatureMax; ++i) {
-		if (_objects[i].unitType != MapObject::UnitType::None) { ++count; }
-	}
-	return count;
+	return qPopulationCount(quint64(_usedSlots & idMask(MapObject::IdMapFeatureMin, MapObject::IdMapFeatureMax)));
 }
 
 
 int Map::robotCount() const {
-	int count = 0;
-	for (MapObject::id_t i = MapObject::IdRobotMin; i <= MapObject::IdRobotMax; ++i) {
-		if (_objects[i].unitType != MapObject::UnitType::None) { ++count; }
-	}
-	return count;
+	return qPopulationCount(quint64(_usedSlots & idMask(MapObject::IdRobotMin, MapObject::IdRobotMax)));
 }
 
 
 MapObject::id_t Map::nextAvailableObjectId(MapObject::Group group) const {
+	uint64_t range = 0;
 	switch (group) {
 	case MapObject::Group::Invalid: return MapObject::IdNone;
 	case MapObject::Group::Player: return MapObject::IdPlayer;
-	case MapObject::Group::Robots:
-		for (MapObject::id_t i = MapObject::IdRobotMin; i <= MapObject::IdRobotMax; ++i) {
-			if (_objects[i].unitType == MapObject::UnitType::None) { return i; }
-		}
-		return MapObject::IdNone;
-	case MapObject::Group::MapFeatures:
-		for (int i = MapObject::IdMapFeatureMin; i <= MapObject::IdMapFeatureMax; ++i) {
-			if (_objects[i].unitType == MapObject::UnitType::None) { return i; }
-		}
-		return MapObject::IdNone;
-	case MapObject::Group::HiddenObjects:
-		for (int i = MapObject::IdHiddenMin; i <= MapObject::IdHiddenMax; ++i) {
-			if (_objects[i].unitType == MapObject::UnitType::None) { return i; }
-		}
-		return MapObject::IdNone;
+	case MapObject::Group::Robots: range = idMask(MapObject::IdRobotMin, MapObject::IdRobotMax); break;
+	case MapObject::Group::MapFeatures: range = idMask(MapObject::IdMapFeatureMin, MapObject::IdMapFeatureMax); break;
+	case MapObject::Group::HiddenObjects: range = idMask(MapObject::IdHiddenMin, MapObject::IdHiddenMax); break;
 	}
+	const quint64 free = ~_usedSlots & range;
+	return free ? MapObject::id_t(qCountTrailingZeroBits(free)) : MapObject::IdNone;
 }
 
 
-const MapObject &Map::object(int no) const {
-	return const_cast<Map*>(this)->objectAt(no);
+/** A copy of object \a no. */
+MapObject Map::object(MapObject::id_t no) const {
+	Q_ASSERT_X(0 <= no and no <= 63, Q_FUNC_INFO,
+	           QString("Can't get object no %1").arg(no).toUtf8().constData());
+	const uint8_t *p = _objects + no;
+	MapObject object;
+	object.unitType = MapObject::UnitType(p[PlaneUnitType * OBJECT_COUNT]);
+	object.x = p[PlaneX * OBJECT_COUNT];
+	object.y = p[PlaneY * OBJECT_COUNT];
+	object.a = p[PlaneA * OBJECT_COUNT];
+	object.b = p[PlaneB * OBJECT_COUNT];
+	object.c = p[PlaneC * OBJECT_COUNT];
+	object.d = p[PlaneD * OBJECT_COUNT];
+	object.health = p[PlaneHealth * OBJECT_COUNT];
+	return object;
 }
 
 
 void Map::deleteObject(MapObject::id_t no) {
-	objectAt(no) = MapObject();
+	TRACE_SCOPE("Map::deleteObject");
+	assignObject(no, MapObject());
 	compact();
-	emit objectsChanged();
+	emitObjectsChanged();
+}
+
+
+/** Deletes the objects \a ids. The remaining objects are compacted once
+ * afterwards, so \a ids refer to the slots as they were before the call.
+ */
+void Map::deleteObjects(const std::vector<MapObject::id_t> &ids) {
+	TRACE_SCOPE("Map::deleteObjects");
+	if (ids.empty()) { return; }
+	for (MapObject::id_t id : ids) {
+		assignObject(id, MapObject());
+	}
+	compact();
+	emitObjectsChanged();
 }
 
 
 void Map::moveObject(MapObject::id_t no, const QPoint &pos) {
-	MapObject &object = objectAt(no);
+	TRACE_SCOPE("Map::moveObject");
+	MapObject object = this->object(no);
 	object.x = pos.x();
 	object.y = pos.y();
-	emit objectsChanged();
+	assignObject(no, object);
+	emitObjectsChanged();
 }
 
 
 void Map::setObject(MapObject::id_t no, const MapObject &object) {
-	objectAt(no) = object;
-	emit objectsChanged();
+	TRACE_SCOPE("Map::setObject");
+	assignObject(no, object);
+	emitObjectsChanged();
 }
 
 
 void Map::setObjects(const MapObject objects[]) {
-	memcpy(_objects, objects, sizeof(_objects[0]) * OBJECT_COUNT);
-	emit objectsChanged();
+	TRACE_SCOPE("Map::setObjects");
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		writeObject(id, objects[id]);
+	}
+	reindexObjects();
+	emitObjectsChanged();
 }
 
 
@@ -224,90 +289,108 @@ uint8_t Map::tileNo(const QPoint &tile) const {
 }
 
 
-uint8_t *Map::tiles() {
+const uint8_t *Map::tiles() const {
 	return _tiles;
 }
 
 
+/** Which objects are on which tile. Kept up to date on every modification
+ * of the map's objects.
+ */
+const ObjectIndex &Map::objectIndex() const {
+	return _objectIndex;
+}
+
+
+/** Where and how often each tile number is used. Kept up to date on every
+ * modification of the map's tiles.
+ */
+const TileIndex &Map::tileIndex() const {
+	return _tileIndex;
+}
+
+
+/** Copy the tiles in \a rect to \a dest, row by row. \a dest must have room
+ * for `rect.width() * rect.height()` bytes.
+ */
+void Map::copyTiles(const QRect &rect, uint8_t *dest) const {
+	Q_ASSERT(0 <= rect.left() and rect.right() < width());
+	Q_ASSERT(0 <= rect.top() and rect.bottom() < height());
+	for (int y = rect.top(); y <= rect.bottom(); ++y) {
+		memcpy(&dest[rect.width() * (y - rect.top())], &_tiles[rect.left() + width() * y], rect.width());
+	}
+}
+
+
 void Map::setTile(const QPoint &position, uint8_t tileNo) {
+	TRACE_SCOPE("Map::setTile");
 	Q_ASSERT(0 <= position.x() and position.x() < width());
 	Q_ASSERT(0 <= position.y() and position.y() < height());
-	int oldTileNo = _tiles[position.x() + width() * position.y()];
+	const int index = position.x() + width() * position.y();
+	const uint8_t oldTileNo = _tiles[index];
 	if (oldTileNo == tileNo) { return; }
-	_tiles[position.x() + width() * position.y()] = tileNo;
+	_tileIndex.change(index, oldTileNo, tileNo);
+	_tiles[index] = tileNo;
 	emit tilesChanged();
 }
 
 
-void Map::setTiles(const QRect &rect, uint8_t *tiles) {
+void Map::setTiles(const QRect &rect, const uint8_t *tiles) {
+	TRACE_SCOPE("Map::setTiles");
 	Q_ASSERT(0 <= rect.left() and rect.right() < width());
 	Q_ASSERT(0 <= rect.top() and rect.bottom() < height());
 	for (int y = rect.top(); y <= rect.bottom(); ++y) {
-		memcpy(&_tiles[rect.left() + width() * y], &tiles[rect.width() * (y - rect.top())], rect.width());
+		const uint8_t *src = &tiles[rect.width() * (y - rect.top())];
+		uint8_t *dest = &_tiles[rect.left() + width() * y];
+		if (memcmp(dest, src, rect.width()) == 0) { continue; }
+		for (int x = 0; x < rect.width(); ++x) {
+			if (dest[x] != src[x]) {
+				_tileIndex.change(rect.left() + x + width() * y, dest[x], src[x]);
+			}
+		}
+		memcpy(dest, src, rect.width());
 	}
 	emit tilesChanged();
 }
 
 
-void Map::setWall(const QPoint &position, bool cascade) {
-	static constexpr uint8_t wallTileByAttribute[64] = {
-	    0x04, 0x11, 0x0b, 0x13, 0x10, 0x05, 0x10, 0x05, // connect to: 0, l, t, lt, r, lr, tr, lrt,
-	    0x0f, 0x0f, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, // connect to: b, lb, tb, ltb, rb, lrb, trb, lrtb,
-	    
-	    // same, but there is a wall going right below
-	    0x1a, 0x1a, 0x0c, 0x0c, 0x10, 0x05, 0x10, 0x05, // last 4 don't fit well
-	    0x1a, 0x1a, 0x0c, 0x0c, 0x04, 0x05, 0x0c, 0x04, // last 4 don't fit well
-	    
-	    // same, but there is a wall going to the bottom on the right
-	    0x12, 0x06, 0x12, 0x06, 0x12, 0x06, 0x12, 0x06, // tile 0x12 is missing the right border
-	    0x0f, 0x0f, 0x08, 0x08, 0x04, 0x04, 0x08, 0x04, // none of these fit well
-	    
-	    // same, but there is a wall going right below, and a wall going to the bottom on the right
-	    0x1a, 0x11, 0x0b, 0x13, 0x12, 0x06, 0x12, 0x06, // none of these fit well
-	    0x1a, 0x1a, 0x0c, 0x0c, 0x04, 0x06, 0x0c, 0x06, // none of these fit well
-	};
-	
-	const uint8_t tileL = position.x() > 0            ? tileNo(position - QPoint(1, 0)) : 0;
-	const uint8_t tileT = position.y() > 0            ? tileNo(position - QPoint(0, 1)) : 0;
-	const uint8_t tileR = position.x() < width() - 1  ? tileNo(position + QPoint(1, 0)) : 0;
-	const uint8_t tileB = position.y() < height() - 1 ? tileNo(position + QPoint(0, 1)) : 0;
-	const WallFlags flagsL = wallFlags(tileL);
-	const WallFlags flagsT = wallFlags(tileT);
-	const WallFlags flagsR = wallFlags(tileR);
-	const WallFlags flagsB = wallFlags(tileB);
-	
-	const int attribute =
-	        ((flagsL.testFlag(WallFlag::ConnRight) or flagsL.testFlag(WallFlag::Generic)) ? 1 : 0)
-	        + ((flagsT.testFlag(WallFlag::ConnBottom) or flagsT.testFlag(WallFlag::Generic)) ? 2 : 0)
-	        + ((flagsR.testFlag(WallFlag::ConnLeft) or flagsR.testFlag(WallFlag::Generic)) ? 4 : 0)
-	        + ((flagsB.testFlag(WallFlag::ConnTop) or flagsB.testFlag(WallFlag::Generic)) ? 8 : 0)
-	        + (flagsB.testFlag(WallFlag::ConnRight) ? 16 : 0)
-	        + (flagsR.testFlag(WallFlag::ConnBottom) ? 32 : 0);
-	
-	setTile(position, wallTileByAttribute[attribute]);
-	
-	if (cascade) {
-		if (flagsL.testFlag(WallFlag::Generic)) {
-			setWall(position - QPoint(1, 0), false);
-		}
-		if (flagsT.testFlag(WallFlag::Generic)) {
-			setWall(position - QPoint(0, 1), false);
-		}
-		if (flagsR.testFlag(WallFlag::Generic)) {
-			setWall(position + QPoint(1, 0), false);
-		}
-		if (flagsB.testFlag(WallFlag::Generic)) {
-			setWall(position + QPoint(0, 1), false);
-		}
-		if (position.x() > 0 and position.y() > 0
-		        and wallFlags(tileNo(position - QPoint(1, 1))).testFlag(WallFlag::Generic)) {
-			setWall(position - QPoint(1, 1), false);
+/** Compares the map's tiles to the map sized buffer \a tiles.
+ * @return the tiles that differ, in row order, with their current tile number
+ *         as \c oldTileNo and the one in \a tiles as \c newTileNo
+ */
+std::vector<Map::TileChange> Map::diffTiles(const uint8_t *tiles) const {
+	std::vector<TileChange> changes;
+	const int size = width() * height();
+	for (int y = 0; y < size; y += width()) {
+		if (memcmp(&_tiles[y], &tiles[y], width()) == 0) { continue; }
+		for (int i = y; i < y + width(); ++i) {
+			if (_tiles[i] != tiles[i]) {
+				changes.push_back({ i, _tiles[i], tiles[i] });
+			}
 		}
 	}
+	return changes;
+}
+
+
+/** Applies the tile changes produced by #diffTiles(), or reverts them if
+ * \a revert is \c true.
+ */
+void Map::changeTiles(const std::vector<TileChange> &changes, bool revert) {
+	TRACE_SCOPE("Map::changeTiles");
+	if (changes.empty()) { return; }
+	for (const TileChange &change : changes) {
+		Q_ASSERT(0 <= change.index and change.index < width() * height());
+		const uint8_t tileNo = revert ? change.oldTileNo : change.newTileNo;
+		_tileIndex.change(change.index, _tiles[change.index], tileNo);
+		_tiles[change.index] = tileNo;
+	}
+	emit tilesChanged();
 }
 
 
 void Map::floodFill(const QPoint &position, uint8_t tileNo) {
+	TRACE_SCOPE("Map::floodFill");
 	Q_ASSERT(0 <= position.x() and position.x() < width());
 	Q_ASSERT(0 <= position.y() and position.y() < height());
 	uint8_t oldTileNo = _tiles[position.x() + width() * position.y()];
@@ -364,66 +447,152 @@ void Map::setModifiedFlag() {
 }
 
 
-void Map::compact() {
+/** Moves the objects of each group to the lowest ids of the group, keeping
+ * their order. Emits no signal.
+ * @return whether any object was moved
+ */
+bool Map::compact() {
+	TRACE_SCOPE("Map::compact");
 	static const std::forward_list<std::pair<MapObject::id_t, MapObject::id_t>> ranges = {
 	    { MapObject::IdRobotMin, MapObject::IdRobotMax },
 	    { MapObject::IdMapFeatureMin, MapObject::IdMapFeatureMax },
 	    { MapObject::IdHiddenMin, MapObject::IdHiddenMax }};
 	
 	bool changed = false;
+	const uint64_t used = _usedSlots;
 	
 	for (const std::pair<MapObject::id_t, MapObject::id_t> &range : ranges) {
-		for (MapObject::id_t i = range.first; i <= range.second - 1; ++i) {
-			if (_objects[i].unitType != MapObject::UnitType::None) { continue; }
-			bool moved = false;
-			for (MapObject::id_t j = i + 1; j < range.second; ++j) {
-				if (_objects[j].unitType != MapObject::UnitType::None) {
-					_objects[i] = _objects[j];
-					_objects[j] = MapObject();
-					++i;
-					moved = true;
-					changed = true;
-				}
+		quint64 ids = used & idMask(range.first, range.second);
+		MapObject::id_t target = range.first;
+		while (ids) {
+			const MapObject::id_t id = qCountTrailingZeroBits(ids);
+			ids &= ids - 1;
+			if (id != target) {
+				assignObject(target, object(id));
+				assignObject(id, MapObject());
+				changed = true;
 			}
-			if (not moved) { break; }
+			++target;
 		}
 	}
-	
-	if (changed) {
-		emit objectsChanged();
-	}
+	return changed;
 }
 
 
+/** The map in the layout of a map file. */
 QByteArray Map::data() const {
 	QByteArray ba(MAP_BYTES, 0);
 	
 	memcpy(ba.data(), MAP_MAGIC, sizeof(MAP_MAGIC));
-	for (MapObject::id_t i = MapObject::IdMin; i <= MapObject::IdMax; ++i) {
-		ba[0x002 + i] = MapObject::unitType_t(_objects[i].unitType);
-		ba[0x042 + i] = _objects[i].x;
-		ba[0x082 + i] = _objects[i].y;
-		ba[0x0c2 + i] = _objects[i].a;
-		ba[0x102 + i] = _objects[i].b;
-		ba[0x142 + i] = _objects[i].c;
-		ba[0x182 + i] = _objects[i].d;
-		ba[0x1c2 + i] = _objects[i].health;
-	}
+	memcpy(ba.data() + OBJECTS_OFFSET, _objects, OBJECT_BYTES);
 	
 	// I don't know what the range 0x202-0x301 is for, in the original maps
 	// those bytes are all set to either 0x00 or 0xAA.
 	
-	Q_ASSERT(0x302 + sizeof(_tiles[0]) * TILE_COUNT == MAP_BYTES);
-	memcpy(ba.data() + 0x302, _tiles, sizeof(_tiles[0]) * TILE_COUNT);
+	Q_ASSERT(TILES_OFFSET + sizeof(_tiles[0]) * TILE_COUNT == MAP_BYTES);
+	memcpy(ba.data() + TILES_OFFSET, _tiles, sizeof(_tiles[0]) * TILE_COUNT);
 	
 	return ba;
 }
 
 
-MapObject &Map::objectAt(MapObject::id_t no) {
+/** Replaces object \a no with \a object, keeping the object index current.
+ * Emits no signal.
+ */
+void Map::assignObject(MapObject::id_t no, const MapObject &object) {
+	_objectIndex.change(no, this->object(no), object);
+	writeObject(no, object);
+}
+
+
+/** Stores \a object in slot \a no of the object planes, and records how the
+ * slot changed for the next #emitObjectsChanged().
+ */
+void Map::writeObject(MapObject::id_t no, const MapObject &object) {
 	Q_ASSERT_X(0 <= no and no <= 63, Q_FUNC_INFO,
-	           QString("Can't get object no %1").arg(no).toUtf8().constData());
-	return _objects[no];
+	           QString("Can't set object no %1").arg(no).toUtf8().constData());
+	const MapObject previous = this->object(no);
+	const uint64_t bit = uint64_t(1) << no;
+	ObjectChanges changes;
+	if (previous.unitType == MapObject::UnitType::None and object.unitType != MapObject::UnitType::None) {
+		changes = ObjectChange::Added;
+		_usedSlots |= bit;
+	} else if (previous.unitType != MapObject::UnitType::None and object.unitType == MapObject::UnitType::None) {
+		changes = ObjectChange::Removed;
+		_usedSlots &= ~bit;
+	} else if (previous != object) {
+		if (previous.pos() != object.pos()) { changes |= ObjectChange::Moved; }
+		MapObject moved = previous;
+		moved.x = object.x;
+		moved.y = object.y;
+		if (moved != object) { changes |= ObjectChange::Modified; }
+	}
+	if (changes) {
+		_changedObjectIds |= bit;
+		_objectChanges |= changes;
+	}
+	
+	uint8_t *p = _objects + no;
+	p[PlaneUnitType * OBJECT_COUNT] = MapObject::unitType_t(object.unitType);
+	p[PlaneX * OBJECT_COUNT] = object.x;
+	p[PlaneY * OBJECT_COUNT] = object.y;
+	p[PlaneA * OBJECT_COUNT] = object.a;
+	p[PlaneB * OBJECT_COUNT] = object.b;
+	p[PlaneC * OBJECT_COUNT] = object.c;
+	p[PlaneD * OBJECT_COUNT] = object.d;
+	p[PlaneHealth * OBJECT_COUNT] = object.health;
+}
+
+
+/** Rebuilds the object index and the mask of used slots from the object
+ * planes.
+ */
+void Map::reindexObjects() {
+	_usedSlots = scanUsedSlots();
+	_objectIndex.reset(_objects + PlaneUnitType * OBJECT_COUNT, _objects + PlaneX * OBJECT_COUNT,
+	                   _objects + PlaneY * OBJECT_COUNT, width(), height());
+}
+
+
+/** Emits #objectsChanged() for the slots written since the last call, if
+ * any changed. With \a all, e.g. after the object planes were replaced as a
+ * whole, every slot is reported with every kind of change.
+ */
+void Map::emitObjectsChanged(bool all) {
+	if (all) {
+		_changedObjectIds = ~uint64_t(0);
+		_objectChanges = ObjectChange::Added | ObjectChange::Removed | ObjectChange::Moved
+		        | ObjectChange::Modified;
+	}
+	if (_changedObjectIds == 0) { return; }
+	const quint64 objectIds = _changedObjectIds;
+	const ObjectChanges changes = _objectChanges;
+	_changedObjectIds = 0;
+	_objectChanges = ObjectChanges();
+	emit objectsChanged(objectIds, changes);
+}
+
+
+/** Computes the mask with bit n set if object slot n is in use, i.e. its type
+ * isn't #MapObject::UnitType::None. The unit type plane is compared 16 slots
+ * at a time where SSE2 is available.
+ */
+uint64_t Map::scanUsedSlots() const {
+	const uint8_t *unitTypes = _objects + PlaneUnitType * OBJECT_COUNT;
+	uint64_t used = 0;
+#ifdef MAP_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (size_t i = 0; i < OBJECT_COUNT; i += 16) {
+		const __m128i types = _mm_loadu_si128(reinterpret_cast<const __m128i*>(unitTypes + i));
+		const uint64_t empty = uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(types, zero)));
+		used |= (~empty & 0xffff) << i;
+	}
+#else
+	for (size_t i = 0; i < OBJECT_COUNT; ++i) {
+		if (unitTypes[i] != 0) { used |= uint64_t(1) << i; }
+	}
+#endif
+	return used;
 }
 
 
@@ -433,6 +602,9 @@ int Map::recursiveFloodFill(const QPoint &pos, uint8_t oldTile, uint8_t newTile)
 	int right = pos.x();
 	while (left > 0 and _tiles[left - 1 + width() * pos.y()] == oldTile) { --left; }
 	while (right < width() - 1 and _tiles[right + 1 + width() * pos.y()] == oldTile) { ++right; }
+	for (int x = left; x <= right; ++x) {
+		_tileIndex.change(x + width() * pos.y(), oldTile, newTile);
+	}
 	memset(&_tiles[left + width() * pos.y()], newTile, right - left + 1);
 	for (int y2 : { pos.y() - 1, pos.y() + 1}) {
 		if (not (0 <= y2 and y2 < height())) { continue; }
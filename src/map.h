@@ -2,10 +2,14 @@
 #define MAP_H
 
 #include <cstdint>
+#include <QByteArray>
 #include <QObject>
 #include <QPoint>
 #include <QString>
+#include <vector>
 #include "mapobject.h"
+#include "objectindex.h"
+#include "tileindex.h"
 
 
 class Map : public QObject {
@@ -16,6 +20,17 @@ public:
 	enum class WallFlag { None, Generic = 1, ConnLeft = 2, ConnRight = 4, ConnTop = 8, ConnBottom = 16 };
 	typedef QFlags<WallFlag> WallFlags;
 	
+	/** How objects changed, see #objectsChanged(). */
+	enum class ObjectChange { Added = 1, Removed = 2, Moved = 4, Modified = 8 };
+	typedef QFlags<ObjectChange> ObjectChanges;
+	
+	/** A single modified tile, as recorded for undo. */
+	struct TileChange {
+		int index; ///< x + width * y
+		uint8_t oldTileNo;
+		uint8_t newTileNo;
+	};
+	
 	Map(QObject *parent = nullptr);
 	virtual ~Map();
 	
@@ -25,7 +40,9 @@ public:
 	
 	void clear();
 	QString load(const QString &path);
+	QString loadData(const QByteArray &data, const QString &path = QString());
 	QString save(const QString &path);
+	QByteArray data() const;
 	
 	int hiddenItemCount() const;
 	int mapFeatureCount() const;
@@ -33,17 +50,22 @@ public:
 	
 	MapObject::id_t nextAvailableObjectId(MapObject::Group group) const;
 	
-	const MapObject &object(MapObject::id_t no) const;
+	MapObject object(MapObject::id_t no) const;
 	void deleteObject(MapObject::id_t no);
+	void deleteObjects(const std::vector<MapObject::id_t> &ids);
 	void moveObject(MapObject::id_t no, const QPoint &pos);
 	void setObject(MapObject::id_t no, const MapObject &object);
 	void setObjects(const MapObject objects[]);
+	const ObjectIndex &objectIndex() const;
 	
 	uint8_t tileNo(const QPoint &tile) const;
-	uint8_t *tiles();
+	const uint8_t *tiles() const;
+	const TileIndex &tileIndex() const;
+	void copyTiles(const QRect &rect, uint8_t *dest) const;
 	void setTile(const QPoint &position, uint8_t tileNo);
-	void setTiles(const QRect &rect, uint8_t *tiles);
-	void setWall(const QPoint &position, bool cascade = true);
+	void setTiles(const QRect &rect, const uint8_t *tiles);
+	std::vector<TileChange> diffTiles(const uint8_t *tiles) const;
+	void changeTiles(const std::vector<TileChange> &changes, bool revert = false);
 	void floodFill(const QPoint &position, uint8_t tileNo);
 	
 	bool isModified() const;
@@ -53,25 +75,36 @@ public:
 	
 signals:
 	void modifiedChanged();
-	void objectsChanged();
+	void objectsChanged(quint64 objectIds, Map::ObjectChanges changes);
 	void pathChanged();
+	void replaced();
 	void tilesChanged();
 	
 private slots:
 	void setModifiedFlag();
 	
 private:
-	void compact();
-	QByteArray data() const;
-	MapObject &objectAt(MapObject::id_t no);
+	bool compact();
+	void assignObject(MapObject::id_t no, const MapObject &object);
+	void writeObject(MapObject::id_t no, const MapObject &object);
+	void reindexObjects();
+	void emitObjectsChanged(bool all = false);
+	uint64_t scanUsedSlots() const;
 	int recursiveFloodFill(const QPoint &position, uint8_t oldTile, uint8_t newTile);
 	void setModified(bool modified);
 	void setPath(const QString &path);
 	
-	MapObject *_objects;
+	uint8_t *_objects;
 	uint8_t *_tiles;
+	TileIndex _tileIndex;
+	ObjectIndex _objectIndex;
+	uint64_t _usedSlots = 0;
+	uint64_t _changedObjectIds = 0;
+	ObjectChanges _objectChanges;
 	bool _modified = false;
 	QString _path;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Map::ObjectChanges)
+
 #endif // MAP_H
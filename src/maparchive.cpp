@@ -0,0 +1,399 @@
+#include "maparchive.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+
+/** @class MapArchive
+ * An archive of many maps and optionally a tileset, for distributing whole
+ * episodes in a single file.
+ *
+ * #### Layout ####
+ *
+ * All numbers are little endian.
+ *
+ * | Size     | Content                                                    |
+ * |----------|------------------------------------------------------------|
+ * | 4        | magic, "PMAR"                                              |
+ * | 2        | version, 1                                                 |
+ * | 2        | number of maps                                             |
+ * | 4 + 4    | offset and size of the tileset, 0 if there is none         |
+ * | per map  | offset (4) and size (4) of its block, name length (2), name |
+ * | ...      | map blocks and the tileset                                 |
+ *
+ * A map block holds the three parts of a map file, each compressed
+ * separately: the object table (512 bytes, stored by column as in the map
+ * file, so equal values such as unused slots form runs), the 256 unused bytes
+ * that follow it, and the 128×64 tile plane. The sizes of the first two
+ * compressed parts come first, as two 16 bit numbers.
+ *
+ * Because the index has the position of every block, a single map can be
+ * read without touching the others. Archives are memory mapped when
+ * possible, so opening one only reads the index.
+ *
+ * #### Compression ####
+ *
+ * Each part is a sequence of commands, each starting with a control byte:
+ *
+ * | Control     | Meaning                                                  |
+ * |-------------|----------------------------------------------------------|
+ * | 0x00 – 0x3f | copy the next control + 1 bytes                          |
+ * | 0x40 – 0x7f | repeat the next byte (control & 0x3f) + 3 times          |
+ * | 0x80 – 0xff | repeat the (control & 0x7f) + 1 bytes from one row above |
+ *
+ * The last command is a form of LZ77 with a fixed distance of one map row.
+ * It captures what plain run length encoding doesn't: walls, corridors and
+ * rooms tend to continue in the next row.
+ */
+
+
+static constexpr char ARCHIVE_MAGIC[4] = { 'P', 'M', 'A', 'R' };
+static constexpr uint16_t ARCHIVE_VERSION = 1;
+static constexpr int HEADER_SIZE = 16;
+
+static constexpr int MAP_BYTES = 8962;
+static constexpr int OBJECTS_OFFSET = 0x002;
+static constexpr int OBJECTS_SIZE = 0x200;
+static constexpr int UNUSED_OFFSET = 0x202;
+static constexpr int UNUSED_SIZE = 0x100;
+static constexpr int TILES_OFFSET = 0x302;
+static constexpr int TILES_SIZE = 0x2000;
+static constexpr int TILES_ROW = 128;
+
+static constexpr int MAX_LITERAL = 64;
+static constexpr int MIN_RUN = 3;
+static constexpr int MAX_RUN = 66;
+static constexpr int MAX_COPY = 128;
+
+
+static void appendLE16(QByteArray &out, uint16_t value) {
+	char bytes[2];
+	qToLittleEndian(value, bytes);
+	out.append(bytes, 2);
+}
+
+
+static void appendLE32(QByteArray &out, uint32_t value) {
+	char bytes[4];
+	qToLittleEndian(value, bytes);
+	out.append(bytes, 4);
+}
+
+
+/** Whether \a name is a plain file name, so extracting the map can't write
+ * outside the target directory.
+ */
+static bool isPlainFileName(const QString &name) {
+	return not name.isEmpty() and not name.contains("/") and not name.contains("\\")
+	        and not name.contains("..") and not QDir::isAbsolutePath(name);
+}
+
+
+MapArchive::MapArchive() {}
+
+
+MapArchive::~MapArchive() {
+	close();
+}
+
+
+/** Opens the archive at \a path and reads its index.
+ * @return a null string on success, an error message otherwise
+ */
+QString MapArchive::open(const QString &path) {
+	close();
+	_file.setFileName(path);
+	if (not _file.open(QFile::ReadOnly)) {
+		return QString("can't read file \"%1\": %2").arg(path, _file.errorString());
+	}
+	_size = _file.size();
+	_data = _file.map(0, _size);
+	if (not _data) {
+		// e.g. on file systems that don't support mapping
+		_buffer = _file.readAll();
+		_data = reinterpret_cast<const uint8_t*>(_buffer.constData());
+	}
+	
+	const auto fail = [this, &path](const QString &reason) {
+		close();
+		return QString("file \"%1\" is not a valid map archive: %2").arg(path, reason);
+	};
+	if (_size < HEADER_SIZE or memcmp(_data, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+		return fail("wrong magic");
+	}
+	if (qFromLittleEndian<uint16_t>(_data + 4) != ARCHIVE_VERSION) {
+		return fail("unsupported version");
+	}
+	const int count = qFromLittleEndian<uint16_t>(_data + 6);
+	_tilesetOffset = qFromLittleEndian<uint32_t>(_data + 8);
+	_tilesetSize = qFromLittleEndian<uint32_t>(_data + 12);
+	if (quint64(_tilesetOffset) + _tilesetSize > quint64(_size)) {
+		return fail("the tileset lies outside of the file");
+	}
+	
+	qint64 pos = HEADER_SIZE;
+	for (int i = 0; i < count; ++i) {
+		if (pos + 10 > _size) { return fail("the index is truncated"); }
+		Entry entry;
+		entry.offset = qFromLittleEndian<uint32_t>(_data + pos);
+		entry.size = qFromLittleEndian<uint32_t>(_data + pos + 4);
+		const int nameLength = qFromLittleEndian<uint16_t>(_data + pos + 8);
+		pos += 10;
+		if (pos + nameLength > _size) { return fail("the index is truncated"); }
+		entry.name = QString::fromUtf8(reinterpret_cast<const char*>(_data + pos), nameLength);
+		pos += nameLength;
+		if (not isPlainFileName(entry.name)) {
+			return fail(QString("invalid map name \"%1\"").arg(entry.name));
+		}
+		if (indexOf(entry.name) >= 0) {
+			return fail(QString("more than one map is named \"%1\"").arg(entry.name));
+		}
+		if (quint64(entry.offset) + entry.size > quint64(_size) or entry.size < 4) {
+			return fail(QString("map \"%1\" lies outside of the file").arg(entry.name));
+		}
+		_entries.push_back(entry);
+	}
+	return QString();
+}
+
+
+void MapArchive::close() {
+	if (_data and _buffer.isEmpty()) {
+		_file.unmap(const_cast<uchar*>(_data));
+	}
+	_file.close();
+	_data = nullptr;
+	_size = 0;
+	_buffer.clear();
+	_entries.clear();
+	_tilesetOffset = 0;
+	_tilesetSize = 0;
+}
+
+
+int MapArchive::mapCount() const {
+	return _entries.size();
+}
+
+
+QString MapArchive::mapName(int index) const {
+	return _entries.at(index).name;
+}
+
+
+/** The index of the map called \a name, or -1 if there is none. */
+int MapArchive::indexOf(const QString &name) const {
+	for (size_t i = 0; i < _entries.size(); ++i) {
+		if (_entries[i].name == name) { return i; }
+	}
+	return -1;
+}
+
+
+/** The number of bytes map \a index takes up in the archive. */
+int MapArchive::compressedSize(int index) const {
+	return _entries.at(index).size;
+}
+
+
+/** Decompresses map \a index into \a data, in the layout of a map file, so it
+ * can be passed to Map::loadData().
+ * @return a null string on success, an error message otherwise
+ */
+QString MapArchive::mapData(int index, QByteArray *data) const {
+	const Entry &entry = _entries.at(index);
+	const uint8_t *block = _data + entry.offset;
+	const int objectsSize = qFromLittleEndian<uint16_t>(block);
+	const int unusedSize = qFromLittleEndian<uint16_t>(block + 2);
+	const int tilesSize = int(entry.size) - 4 - objectsSize - unusedSize;
+	if (tilesSize < 0) {
+		return QString("map \"%1\" is corrupt").arg(entry.name);
+	}
+	
+	data->resize(MAP_BYTES);
+	uint8_t *out = reinterpret_cast<uint8_t*>(data->data());
+	out[0] = 0x00;
+	out[1] = 0x5d;
+	const uint8_t *part = block + 4;
+	if (not decode(part, objectsSize, 0, out + OBJECTS_OFFSET, OBJECTS_SIZE)
+	        or not decode(part + objectsSize, unusedSize, 0, out + UNUSED_OFFSET, UNUSED_SIZE)
+	        or not decode(part + objectsSize + unusedSize, tilesSize, TILES_ROW, out + TILES_OFFSET,
+	                      TILES_SIZE)) {
+		return QString("map \"%1\" is corrupt").arg(entry.name);
+	}
+	return QString();
+}
+
+
+bool MapArchive::hasTileset() const {
+	return _tilesetSize > 0;
+}
+
+
+QByteArray MapArchive::tilesetData() const {
+	return QByteArray(reinterpret_cast<const char*>(_data + _tilesetOffset), _tilesetSize);
+}
+
+
+/** Writes an archive to \a path, containing the maps in \a mapPaths, named
+ * after their file names, and the tileset at \a tilesetPath unless it is
+ * empty. Maps are looked up by name, so no two may have the same file name.
+ * @return a null string on success, an error message otherwise
+ */
+QString MapArchive::write(const QString &path, const QStringList &mapPaths, const QString &tilesetPath) {
+	if (mapPaths.size() > 0xffff) { return QString("too many maps"); }
+	
+	QByteArray blocks;
+	std::vector<std::pair<QByteArray, uint32_t>> names; // UTF-8 name and block offset
+	std::vector<uint32_t> sizes;
+	for (const QString &mapPath : mapPaths) {
+		QFile file(mapPath);
+		if (not file.open(QFile::ReadOnly)) {
+			return QString("can't read file \"%1\": %2").arg(mapPath, file.errorString());
+		}
+		const QByteArray map = file.readAll();
+		if (map.size() != MAP_BYTES or map[0] != 0x00 or map[1] != 0x5d) {
+			return QString("file \"%1\" is not a map").arg(mapPath);
+		}
+		const uint8_t *bytes = reinterpret_cast<const uint8_t*>(map.constData());
+		const QByteArray objects = encode(bytes + OBJECTS_OFFSET, OBJECTS_SIZE, 0);
+		const QByteArray unused = encode(bytes + UNUSED_OFFSET, UNUSED_SIZE, 0);
+		const QByteArray tiles = encode(bytes + TILES_OFFSET, TILES_SIZE, TILES_ROW);
+		
+		const QByteArray name = QFileInfo(mapPath).fileName().toUtf8();
+		for (const auto &other : names) {
+			if (other.first == name) {
+				return QString("more than one map is named \"%1\"").arg(QString::fromUtf8(name));
+			}
+		}
+		names.push_back({ name, uint32_t(blocks.size()) });
+		appendLE16(blocks, objects.size());
+		appendLE16(blocks, unused.size());
+		blocks.append(objects).append(unused).append(tiles);
+		sizes.push_back(blocks.size() - names.back().second);
+	}
+	
+	QByteArray tileset;
+	if (not tilesetPath.isEmpty()) {
+		QFile file(tilesetPath);
+		if (not file.open(QFile::ReadOnly)) {
+			return QString("can't read file \"%1\": %2").arg(tilesetPath, file.errorString());
+		}
+		tileset = file.readAll();
+	}
+	
+	int indexSize = 0;
+	for (const auto &name : names) { indexSize += 10 + name.first.size(); }
+	const uint32_t blocksOffset = HEADER_SIZE + indexSize;
+	
+	QByteArray header(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+	appendLE16(header, ARCHIVE_VERSION);
+	appendLE16(header, names.size());
+	appendLE32(header, tileset.isEmpty() ? 0 : blocksOffset + blocks.size());
+	appendLE32(header, tileset.size());
+	for (size_t i = 0; i < names.size(); ++i) {
+		appendLE32(header, blocksOffset + names[i].second);
+		appendLE32(header, sizes[i]);
+		appendLE16(header, names[i].first.size());
+		header.append(names[i].first);
+	}
+	
+	QSaveFile file(path);
+	if (not file.open(QFile::WriteOnly)) {
+		return QString("cannot open \"%1\" for writing: %2").arg(path, file.errorString());
+	}
+	file.write(header);
+	file.write(blocks);
+	file.write(tileset);
+	if (not file.commit()) {
+		return QString("cannot write to \"%1\": %2").arg(path, file.errorString());
+	}
+	return QString();
+}
+
+
+const QString &MapArchive::fileExtension() {
+	static const QString extension = QStringLiteral("petarc");
+	return extension;
+}
+
+
+/** Compresses \a size bytes at \a data as described in the class
+ * documentation. Copies from \a distance bytes back are used if \a distance
+ * is greater than 0.
+ */
+QByteArray MapArchive::encode(const uint8_t *data, int size, int distance) {
+	QByteArray out;
+	int literalStart = 0;
+	const auto flushLiterals = [&](int end) {
+		while (literalStart < end) {
+			const int count = std::min(end - literalStart, MAX_LITERAL);
+			out.append(char(count - 1));
+			out.append(reinterpret_cast<const char*>(data + literalStart), count);
+			literalStart += count;
+		}
+	};
+	
+	int i = 0;
+	while (i < size) {
+		int copy = 0;
+		if (distance > 0 and i >= distance) {
+			while (copy < MAX_COPY and i + copy < size and data[i + copy] == data[i + copy - distance]) {
+				++copy;
+			}
+		}
+		int run = 1;
+		while (run < MAX_RUN and i + run < size and data[i + run] == data[i]) { ++run; }
+		
+		// a copy costs one byte, a run two, and literals one per byte
+		if (copy >= 2 and copy >= run) {
+			flushLiterals(i);
+			out.append(char(0x80 | (copy - 1)));
+			i += copy;
+			literalStart = i;
+		} else if (run >= MIN_RUN) {
+			flushLiterals(i);
+			out.append(char(0x40 | (run - MIN_RUN)));
+			out.append(char(data[i]));
+			i += run;
+			literalStart = i;
+		} else {
+			++i;
+		}
+	}
+	flushLiterals(size);
+	return out;
+}
+
+
+/** Decompresses \a size bytes at \a data into exactly \a outSize bytes at
+ * \a out. Returns \c false if the data is corrupt.
+ */
+bool MapArchive::decode(const uint8_t *data, int size, int distance, uint8_t *out, int outSize) {
+	int in = 0;
+	int pos = 0;
+	while (in < size) {
+		const uint8_t control = data[in++];
+		if (control < 0x40) {
+			const int count = control + 1;
+			if (in + count > size or pos + count > outSize) { return false; }
+			memcpy(out + pos, data + in, count);
+			in += count;
+			pos += count;
+		} else if (control < 0x80) {
+			const int count = (control & 0x3f) + MIN_RUN;
+			if (in >= size or pos + count > outSize) { return false; }
+			memset(out + pos, data[in++], count);
+			pos += count;
+		} else {
+			const int count = (control & 0x7f) + 1;
+			if (distance <= 0 or pos < distance or pos + count > outSize) { return false; }
+			// byte by byte, the source may overlap what is being written
+			for (int i = 0; i < count; ++i, ++pos) { out[pos] = out[pos - distance]; }
+		}
+	}
+	return pos == outSize;
+}
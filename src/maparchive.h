@@ -0,0 +1,51 @@
+#ifndef MAPARCHIVE_H
+#define MAPARCHIVE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <cstdint>
+#include <vector>
+
+
+class MapArchive {
+public:
+	MapArchive();
+	~MapArchive();
+	
+	QString open(const QString &path);
+	void close();
+	
+	int mapCount() const;
+	QString mapName(int index) const;
+	int indexOf(const QString &name) const;
+	int compressedSize(int index) const;
+	QString mapData(int index, QByteArray *data) const;
+	
+	bool hasTileset() const;
+	QByteArray tilesetData() const;
+	
+	static QString write(const QString &path, const QStringList &mapPaths, const QString &tilesetPath);
+	static const QString &fileExtension();
+	
+	static QByteArray encode(const uint8_t *data, int size, int distance);
+	static bool decode(const uint8_t *data, int size, int distance, uint8_t *out, int outSize);
+	
+private:
+	struct Entry {
+		QString name;
+		uint32_t offset;
+		uint32_t size;
+	};
+	
+	QFile _file;
+	const uint8_t *_data = nullptr;
+	qint64 _size = 0;
+	QByteArray _buffer;
+	std::vector<Entry> _entries;
+	uint32_t _tilesetOffset = 0;
+	uint32_t _tilesetSize = 0;
+};
+
+#endif // MAPARCHIVE_H
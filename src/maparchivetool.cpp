@@ -0,0 +1,183 @@
+#include "maparchivetool.h"
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <cstdio>
+#include "map.h"
+#include "maparchive.h"
+
+
+/** @class MapArchiveTool
+ * Creates, extracts and inspects map archives from the command line:
+ *
+ *     PetsciiRobotsMapEditor --pack ARCHIVE [--tileset PATH] MAP...
+ *     PetsciiRobotsMapEditor --unpack ARCHIVE [--output DIR]
+ *     PetsciiRobotsMapEditor --archive-info ARCHIVE [--benchmark]
+ *
+ * `--archive-info` lists the maps with their compressed sizes. With
+ * `--benchmark`, it also extracts the maps to a temporary directory and
+ * compares loading them from there with loading them from the archive.
+ *
+ * The exit code is 0 on success and 2 on errors.
+ */
+
+
+static constexpr int BENCHMARK_ROUNDS = 20;
+
+
+static QString unpack(const MapArchive &archive, const QString &directory) {
+	if (not QDir().mkpath(directory)) {
+		return QString("can't create directory \"%1\"").arg(directory);
+	}
+	const QDir targetDir(QFileInfo(directory).absoluteFilePath());
+	for (int i = 0; i < archive.mapCount(); ++i) {
+		QByteArray data;
+		QString error = archive.mapData(i, &data);
+		if (not error.isNull()) { return error; }
+		const QString path = targetDir.filePath(archive.mapName(i));
+		// MapArchive::open() rejects such names already, but never write
+		// outside of the target directory
+		if (QDir::cleanPath(QFileInfo(path).absolutePath()) != QDir::cleanPath(targetDir.absolutePath())) {
+			return QString("map name \"%1\" points outside of \"%2\"").arg(archive.mapName(i), directory);
+		}
+		QFile file(path);
+		if (not file.open(QFile::WriteOnly) or file.write(data) != data.size()) {
+			return QString("can't write file \"%1\": %2").arg(path, file.errorString());
+		}
+	}
+	if (archive.hasTileset()) {
+		const QString path = QDir(directory).filePath("tileset.pet");
+		QFile file(path);
+		const QByteArray data = archive.tilesetData();
+		if (not file.open(QFile::WriteOnly) or file.write(data) != data.size()) {
+			return QString("can't write file \"%1\": %2").arg(path, file.errorString());
+		}
+	}
+	return QString();
+}
+
+
+/** Loads every map in \a archive BENCHMARK_ROUNDS times, once from extracted
+ * files and once from the archive, and prints the times and sizes.
+ */
+static QString benchmark(const QString &archivePath, QTextStream &out) {
+	QTemporaryDir directory;
+	if (not directory.isValid()) { return QString("can't create a temporary directory"); }
+	MapArchive archive;
+	QString error = archive.open(archivePath);
+	if (not error.isNull()) { return error; }
+	error = unpack(archive, directory.path());
+	if (not error.isNull()) { return error; }
+	
+	QStringList paths;
+	qint64 looseSize = 0;
+	for (int i = 0; i < archive.mapCount(); ++i) {
+		paths.append(QDir(directory.path()).filePath(archive.mapName(i)));
+		looseSize += QFileInfo(paths.last()).size();
+	}
+	archive.close();
+	
+	Map map;
+	QElapsedTimer timer;
+	timer.start();
+	for (int round = 0; round < BENCHMARK_ROUNDS; ++round) {
+		for (const QString &path : paths) {
+			error = map.load(path);
+			if (not error.isNull()) { return error; }
+		}
+	}
+	const qint64 looseTime = timer.nsecsElapsed();
+	
+	timer.restart();
+	for (int round = 0; round < BENCHMARK_ROUNDS; ++round) {
+		// reopening each round includes reading the index in the measurement
+		error = archive.open(archivePath);
+		if (not error.isNull()) { return error; }
+		for (int i = 0; i < archive.mapCount(); ++i) {
+			QByteArray data;
+			error = archive.mapData(i, &data);
+			if (error.isNull()) { error = map.loadData(data); }
+			if (not error.isNull()) { return error; }
+		}
+		archive.close();
+	}
+	const qint64 archiveTime = timer.nsecsElapsed();
+	
+	const int loads = qMax(1, BENCHMARK_ROUNDS * paths.size());
+	out << "loose files: " << looseSize << " bytes, " << looseTime / loads / 1000.0 << " us per map" << '\n';
+	out << "archive:     " << QFileInfo(archivePath).size() << " bytes, " << archiveTime / loads / 1000.0
+	    << " us per map" << '\n';
+	return QString();
+}
+
+
+/** Run the tool with the command line \a arguments. Returns the exit code. */
+int MapArchiveTool::run(const QStringList &arguments) {
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Create, extract or inspect PETSCII Robots map archives.");
+	parser.addHelpOption();
+	const QCommandLineOption packOption("pack", "Pack maps into an archive and exit.");
+	const QCommandLineOption unpackOption("unpack", "Extract the maps from an archive and exit.");
+	const QCommandLineOption infoOption("archive-info", "List the maps in an archive and exit.");
+	const QCommandLineOption tilesetOption("tileset", "Include the tileset at <path> when packing.", "path");
+	const QCommandLineOption outputOption("output", "Extract to <directory>.", "directory");
+	const QCommandLineOption benchmarkOption("benchmark", "Compare load times with extracted maps.");
+	parser.addOption(packOption);
+	parser.addOption(unpackOption);
+	parser.addOption(infoOption);
+	parser.addOption(tilesetOption);
+	parser.addOption(outputOption);
+	parser.addOption(benchmarkOption);
+	parser.addPositionalArgument("archive", "The archive.");
+	parser.addPositionalArgument("maps", "The maps to pack.", "[MAP...]");
+	parser.process(arguments);
+	
+	QTextStream out(stdout);
+	QTextStream err(stderr);
+	QStringList paths = parser.positionalArguments();
+	if (paths.isEmpty()) {
+		err << "no archive given" << '\n';
+		return 2;
+	}
+	const QString archivePath = paths.takeFirst();
+	
+	if (parser.isSet(packOption)) {
+		if (paths.isEmpty()) {
+			err << "--pack needs at least one map" << '\n';
+			return 2;
+		}
+		const QString error = MapArchive::write(archivePath, paths, parser.value(tilesetOption));
+		if (not error.isNull()) {
+			err << archivePath << ": " << error << '\n';
+			return 2;
+		}
+		return 0;
+	}
+	
+	MapArchive archive;
+	QString error = archive.open(archivePath);
+	if (error.isNull() and parser.isSet(unpackOption)) {
+		error = unpack(archive, parser.isSet(outputOption) ? parser.value(outputOption) : QString("."));
+	} else if (error.isNull()) {
+		for (int i = 0; i < archive.mapCount(); ++i) {
+			out << archive.mapName(i) << ": " << archive.compressedSize(i) << " bytes" << '\n';
+		}
+		if (archive.hasTileset()) {
+			out << "tileset: " << archive.tilesetData().size() << " bytes" << '\n';
+		}
+		archive.close();
+		if (parser.isSet(benchmarkOption)) {
+			out.flush();
+			error = benchmark(archivePath, out);
+		}
+	}
+	if (not error.isNull()) {
+		err << archivePath << ": " << error << '\n';
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,13 @@
+#ifndef MAPARCHIVETOOL_H
+#define MAPARCHIVETOOL_H
+
+#include <QString>
+#include <QStringList>
+
+
+class MapArchiveTool {
+public:
+	static int run(const QStringList &arguments);
+};
+
+#endif // MAPARCHIVETOOL_H
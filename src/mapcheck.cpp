@@ -1,11 +1,15 @@
 #include "mapcheck.h"
 #include <QLoggingCategory>
 #include <QRect>
+#include <QtAlgorithms>
 #include <unordered_set>
 #include "map.h"
 #include "mapcontroller.h"
+#include "progressionsolver.h"
+#include "reachability.h"
 #include "tileset.h"
 #include "tile.h"
+#include "trace.h"
 
 static Q_LOGGING_CATEGORY(lc, "mapcheck");
 
@@ -17,6 +21,7 @@ MapCheck::MapCheck(MapController &mapController, const Tileset &tileset)
 
 
 void MapCheck::check() {
+	TRACE_SCOPE("MapCheck::check");
 	_problems.clear();
 	checkPlayerExists();
 	checkPlayerInBounds();
@@ -31,10 +36,12 @@ void MapCheck::check() {
 	checkKeys();
 	checkWeapons();
 	checkSearchAreas();
+	checkReachability();
 }
 
 
 void MapCheck::fixAll() {
+	TRACE_SCOPE("MapCheck::fixAll");
 	bool fixed;
 	do {
 		fixed = false;
@@ -548,6 +555,50 @@ void MapCheck::checkSearchAreas() {
 }
 
 
+void MapCheck::checkReachability() {
+	const Map &map = *_mapController.map();
+	const MapObject &player = map.object(MapObject::IdPlayer);
+	if (player.unitType != MapObject::UnitType::Player) { return; }
+	
+	Reachability reachability(map, _tileset);
+	reachability.compute(player.pos());
+	
+	bool exitReachable = false;
+	for (MapObject::id_t id = MapObject::IdMapFeatureMin; id <= MapObject::IdMapFeatureMax; ++id) {
+		const MapObject &object = map.object(id);
+		if (object.unitType != MapObject::UnitType::TransporterPad) { continue; }
+		if (reachability.isReachable(object.pos())) {
+			exitReachable |= object.b == 0;
+		} else if (object.b == 0) {
+			error(id, "the level exit can't be reached from the player spawn point");
+		} else {
+			warn(id, "transporter pad can't be reached from the player spawn point");
+		}
+	}
+	
+	// the exit isn't blocked by walls, but it might still be behind locked doors
+	if (exitReachable) {
+		ProgressionSolver solver(map, _tileset);
+		const ProgressionSolver::keyMask_t locks = solver.solve() ? 0 : solver.blockingLocks();
+		if (locks != 0) {
+			const bool plural = qPopulationCount(locks) > 1;
+			error(MapObject::IdNone, QString("the level exit can't be reached because the player can't "
+			                                 "get the %1 %2").arg(ProgressionSolver::keyName(locks),
+			                                                       plural ? "keys" : "key"));
+		}
+	}
+	
+	for (MapObject::id_t id = MapObject::IdHiddenMin; id <= MapObject::IdHiddenMax; ++id) {
+		const MapObject &object = map.object(id);
+		if (object.group() != MapObject::Group::HiddenObjects) { continue; }
+		if (not reachability.isReachableOrAdjacent(object.pos())) {
+			warn(id, QString("%1 can't be reached from the player spawn point")
+			     .arg(MapObject::toString(object.unitType)));
+		}
+	}
+}
+
+
 void MapCheck::checkUnused(MapObject::id_t id, bool a, bool b, bool c, bool d, bool health) {
 	const MapObject &object = _mapController.map()->object(id);
 	const QString unitType = MapObject::toString(object.unitType);
@@ -568,16 +619,7 @@ void MapCheck::checkUnused(MapObject::id_t id, bool a, bool b, bool c, bool d, b
 
 
 QRect MapCheck::walkableRect() const {
-	static const int HORIZONTAL_MARGIN = 5;
-	static const int VERTICAL_MARGIN = 3;
-	
-	QRect result = _mapController.map()->rect();
-	result.setLeft(result.left() + HORIZONTAL_MARGIN);
-	result.setRight(result.right() - HORIZONTAL_MARGIN);
-	result.setTop(result.top() + VERTICAL_MARGIN);
-	result.setBottom(result.bottom() - VERTICAL_MARGIN);
-	
-	return result;
+	return Reachability::walkableRect(*_mapController.map());
 }
 
 
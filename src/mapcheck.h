@@ -54,6 +54,7 @@ private:
 	void checkKeys();
 	void checkWeapons();
 	void checkSearchAreas();
+	void checkReachability();
 	
 	void checkUnused(MapObject::id_t id, bool a, bool b, bool c, bool d, bool health);
 	
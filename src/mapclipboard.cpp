@@ -0,0 +1,195 @@
+#include "mapclipboard.h"
+#include <QMimeData>
+#include <cstring>
+#include "map.h"
+
+
+/** @class MapClipboard
+ * A copied area of the map, consisting of a block of tiles and/or a list of
+ * objects.
+ *
+ * The clipboard is stored in a single contiguous buffer which is also its
+ * serialized form, so putting it onto or taking it from the system clipboard
+ * doesn't require any conversion. This allows copying and pasting between
+ * several instances of the map editor.
+ *
+ * #### Format ####
+ *
+ * | Offset | Size       | Content                                          |
+ * |--------|------------|--------------------------------------------------|
+ * | 0      | 4          | magic, `PRSB`                                    |
+ * | 4      | 1          | format version, currently 1                      |
+ * | 5      | 1          | flags, bit 0 is set if tiles are present         |
+ * | 6      | 1          | width in tiles                                   |
+ * | 7      | 1          | height in tiles                                  |
+ * | 8      | 1          | number of objects                                |
+ * | 9      | 3          | reserved, 0                                      |
+ * | 12     | w × h      | tile numbers, row by row (only if flag is set)   |
+ * | ...    | 8 × count  | objects: unit type, x, y, a, b, c, d, health     |
+ *
+ * Object positions are relative to the top left corner of the copied area.
+ */
+
+
+static constexpr char MAGIC[4] = { 'P', 'R', 'S', 'B' };
+static constexpr uint8_t VERSION = 1;
+static constexpr uint8_t FLAG_TILES = 0x01;
+static constexpr int HEADER_SIZE = 12;
+static constexpr int OBJECT_SIZE = 8;
+static constexpr int OFFSET_VERSION = 4;
+static constexpr int OFFSET_FLAGS = 5;
+static constexpr int OFFSET_WIDTH = 6;
+static constexpr int OFFSET_HEIGHT = 7;
+static constexpr int OFFSET_OBJECT_COUNT = 8;
+
+
+/** Create a null clipboard. */
+MapClipboard::MapClipboard() {}
+
+
+MapClipboard::MapClipboard(const QByteArray &data) : _data(data) {}
+
+
+/** Copy the area \a rect of \a map.
+ *
+ * Objects are only included if \a copyObjects is set, and only if their
+ * position lies within \a rect. The result needs only a single allocation.
+ */
+MapClipboard MapClipboard::fromMap(const Map &map, const QRect &rect, bool copyTiles,
+                                   bool copyObjects) {
+	Q_ASSERT(map.rect().contains(rect));
+
+	std::vector<MapObject::id_t> objectIds;
+	if (copyObjects) {
+		objectIds = map.objectIndex().objectsIn(rect);
+	}
+	const int objectCount = objectIds.size();
+
+	const int tileBytes = copyTiles ? rect.width() * rect.height() : 0;
+	QByteArray data(HEADER_SIZE + tileBytes + objectCount * OBJECT_SIZE, '\0');
+	uint8_t *p = reinterpret_cast<uint8_t*>(data.data());
+	memcpy(p, MAGIC, sizeof(MAGIC));
+	p[OFFSET_VERSION] = VERSION;
+	p[OFFSET_FLAGS] = copyTiles ? FLAG_TILES : 0;
+	p[OFFSET_WIDTH] = rect.width();
+	p[OFFSET_HEIGHT] = rect.height();
+	p[OFFSET_OBJECT_COUNT] = objectCount;
+	p += HEADER_SIZE;
+
+	if (copyTiles) {
+		map.copyTiles(rect, p);
+		p += tileBytes;
+	}
+
+	if (objectCount > 0) {
+		for (MapObject::id_t id : objectIds) {
+			const MapObject &object = map.object(id);
+			p[0] = MapObject::unitType_t(object.unitType);
+			p[1] = object.x - rect.left();
+			p[2] = object.y - rect.top();
+			p[3] = object.a;
+			p[4] = object.b;
+			p[5] = object.c;
+			p[6] = object.d;
+			p[7] = object.health;
+			p += OBJECT_SIZE;
+		}
+	}
+
+	return MapClipboard(data);
+}
+
+
+/** Extract a clipboard from \a mimeData.
+ *
+ * Returns a null clipboard if \a mimeData doesn't contain map data, or if
+ * the data is malformed.
+ */
+MapClipboard MapClipboard::fromMimeData(const QMimeData *mimeData) {
+	if (mimeData == nullptr or not mimeData->hasFormat(mimeType())) {
+		return MapClipboard();
+	}
+
+	const QByteArray data = mimeData->data(mimeType());
+	if (data.size() < HEADER_SIZE or memcmp(data.constData(), MAGIC, sizeof(MAGIC)) != 0) {
+		return MapClipboard();
+	}
+
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(data.constData());
+	if (p[OFFSET_VERSION] != VERSION) {
+		return MapClipboard();
+	}
+	const int tileBytes = (p[OFFSET_FLAGS] & FLAG_TILES) ? p[OFFSET_WIDTH] * p[OFFSET_HEIGHT] : 0;
+	const int expectedSize = HEADER_SIZE + tileBytes + p[OFFSET_OBJECT_COUNT] * OBJECT_SIZE;
+	if (data.size() != expectedSize or p[OFFSET_WIDTH] == 0 or p[OFFSET_HEIGHT] == 0) {
+		return MapClipboard();
+	}
+
+	return MapClipboard(data);
+}
+
+
+/** Create a QMimeData object suitable for QClipboard::setMimeData(). */
+QMimeData *MapClipboard::toMimeData() const {
+	QMimeData *mimeData = new QMimeData();
+	mimeData->setData(mimeType(), _data);
+	return mimeData;
+}
+
+
+bool MapClipboard::isNull() const {
+	return _data.isEmpty();
+}
+
+
+/** The size of the copied area, in tiles. */
+QSize MapClipboard::size() const {
+	if (isNull()) { return QSize(); }
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(_data.constData());
+	return QSize(p[OFFSET_WIDTH], p[OFFSET_HEIGHT]);
+}
+
+
+bool MapClipboard::hasTiles() const {
+	return not isNull() and (_data.at(OFFSET_FLAGS) & FLAG_TILES);
+}
+
+
+/** The copied tiles, row by row. Returns \c nullptr if there are no tiles. */
+const uint8_t *MapClipboard::tiles() const {
+	if (not hasTiles()) { return nullptr; }
+	return reinterpret_cast<const uint8_t*>(_data.constData()) + HEADER_SIZE;
+}
+
+
+int MapClipboard::objectCount() const {
+	if (isNull()) { return 0; }
+	return uint8_t(_data.at(OFFSET_OBJECT_COUNT));
+}
+
+
+/** Get the object number \a index, with a position relative to the top
+ * left corner of the copied area.
+ */
+MapObject MapClipboard::object(int index) const {
+	Q_ASSERT(0 <= index and index < objectCount());
+	const int tileBytes = hasTiles() ? size().width() * size().height() : 0;
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(_data.constData()) + HEADER_SIZE
+	        + tileBytes + index * OBJECT_SIZE;
+	MapObject object;
+	object.unitType = MapObject::UnitType(p[0]);
+	object.x = p[1];
+	object.y = p[2];
+	object.a = p[3];
+	object.b = p[4];
+	object.c = p[5];
+	object.d = p[6];
+	object.health = p[7];
+	return object;
+}
+
+
+const QString &MapClipboard::mimeType() {
+	static const QString result = QStringLiteral("application/x-petscii-robots-map-selection");
+	return result;
+}
@@ -0,0 +1,38 @@
+#ifndef MAPCLIPBOARD_H
+#define MAPCLIPBOARD_H
+
+#include <QByteArray>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <cstdint>
+#include "mapobject.h"
+
+class Map;
+class QMimeData;
+
+
+class MapClipboard {
+public:
+	MapClipboard();
+
+	static MapClipboard fromMap(const Map &map, const QRect &rect, bool copyTiles, bool copyObjects);
+	static MapClipboard fromMimeData(const QMimeData *mimeData);
+	QMimeData *toMimeData() const;
+
+	bool isNull() const;
+	QSize size() const;
+	bool hasTiles() const;
+	const uint8_t *tiles() const;
+	int objectCount() const;
+	MapObject object(int index) const;
+
+	static const QString &mimeType();
+
+private:
+	MapClipboard(const QByteArray &data);
+
+	QByteArray _data;
+};
+
+#endif // MAPCLIPBOARD_H
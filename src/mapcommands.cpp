@@ -4,7 +4,15 @@
 #include "util.h"
 
 
-enum CommandIds { MoveObjectId = 1 };
+enum CommandIds { MoveObjectId = 1, ModifyObjectId };
+
+/** The parts of an object that a #MapCommands::ModifyObject changes. */
+enum ObjectFields : uint8_t {
+	FieldUnitType = 1, FieldPosition = 2, FieldA = 4, FieldB = 8, FieldC = 16, FieldD = 32, FieldHealth = 64
+};
+
+/** Edits of the same object less than this many ms apart are merged. */
+static constexpr qint64 MODIFY_MERGE_INTERVAL = 1000;
 
 
 static QString unitTypeS(const MapObject &object) {
@@ -12,6 +20,19 @@ static QString unitTypeS(const MapObject &object) {
 }
 
 
+static uint8_t changedFields(const MapObject &a, const MapObject &b) {
+	uint8_t fields = 0;
+	if (a.unitType != b.unitType) { fields |= FieldUnitType; }
+	if (a.pos() != b.pos()) { fields |= FieldPosition; }
+	if (a.a != b.a) { fields |= FieldA; }
+	if (a.b != b.b) { fields |= FieldB; }
+	if (a.c != b.c) { fields |= FieldC; }
+	if (a.d != b.d) { fields |= FieldD; }
+	if (a.health != b.health) { fields |= FieldHealth; }
+	return fields;
+}
+
+
 MapCommands::DeleteObject::DeleteObject(Map &map, MapObject::id_t objectId, QUndoCommand *parent)
     : QUndoCommand("Delete " + unitTypeS(map.object(objectId)), parent), _map(map), _objectId(objectId) {}
 
@@ -29,13 +50,62 @@ void MapCommands::DeleteObject::undo() {
 }
 
 
+/** Deletes all \a objectIds at once. The ids refer to the slots before the
+ * deletion; the remaining objects are compacted only once afterwards.
+ */
+MapCommands::DeleteObjects::DeleteObjects(Map &map, const std::vector<MapObject::id_t> &objectIds,
+                                          QUndoCommand *parent)
+    : QUndoCommand(objectIds.size() == 1 ? "Delete " + unitTypeS(map.object(objectIds[0]))
+                                         : QString("Delete %1 Objects").arg(objectIds.size()), parent),
+      _map(map), _objectIds(objectIds) {}
+
+
+void MapCommands::DeleteObjects::redo() {
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		_previousState[id] = _map.object(id);
+	}
+	_map.deleteObjects(_objectIds);
+}
+
+
+void MapCommands::DeleteObjects::undo() {
+	_map.setObjects(_previousState);
+}
+
+
+/** Puts \a object into slot \a objectId.
+ * 
+ * Consecutive edits of the same fields of the same object, e.g. while the
+ * arrow of a spin box is held down, are merged into one undo step as long as
+ * they follow each other quickly and \a mergeCounter stays the same.
+ */
 MapCommands::ModifyObject::ModifyObject(Map &map, MapObject::id_t objectId, const MapObject &object,
-                                        QUndoCommand *parent)
+                                        int mergeCounter, QUndoCommand *parent)
     : QUndoCommand("Modify " + unitTypeS(object), parent), _map(map), _objectId(objectId),
-      _object(object) {
+      _object(object), _fields(changedFields(map.object(objectId), object)), _mergeCounter(mergeCounter) {
 	if (object.unitType == MapObject::UnitType::WaterRaft) {
 		applyWaterRaftConstraints();
 	}
+	_lastEdit.start();
+}
+
+
+int MapCommands::ModifyObject::id() const {
+	return ModifyObjectId;
+}
+
+
+bool MapCommands::ModifyObject::mergeWith(const QUndoCommand *command) {
+	const ModifyObject *other = dynamic_cast<const ModifyObject*>(command);
+	if (other->_objectId != _objectId or other->_fields != _fields or other->_mergeCounter != _mergeCounter
+	        or _lastEdit.elapsed() >= MODIFY_MERGE_INTERVAL) {
+		return false;
+	}
+	_object = other->_object;
+	_lastEdit.restart();
+	// e.g. a spin box stepped up and back down again
+	setObsolete(_object == _previousObject);
+	return true;
 }
 
 
@@ -157,7 +227,87 @@ void MapCommands::MoveObject::undoWaterRaft() {
 MapCommands::NewObject::NewObject(Map &map, MapObject::id_t objectId, const MapObject &object,
                                   QUndoCommand *parent)
     : QUndoCommand("Place " + unitTypeS(object), parent) {
-	new ModifyObject(map, objectId, object, this);
+	new ModifyObject(map, objectId, object, 0, this);
+}
+
+
+/** Paste \a clipboard with its top left corner at \a position.
+ *
+ * If \a source is valid, the clipboard was lifted from that area, and the
+ * command moves it: the tiles in \a source are cleared, and if
+ * \a moveObjects is set, the objects in \a source are deleted. Parts of the
+ * clipboard that lie outside the map are dropped.
+ */
+MapCommands::PasteArea::PasteArea(Map &map, const MapClipboard &clipboard, const QPoint &position,
+                                  const QRect &source, bool moveObjects, QUndoCommand *parent)
+    : QUndoCommand(source.isValid() ? "Move Area" : "Paste", parent), _map(map),
+      _clipboard(clipboard), _position(position), _source(source), _moveObjects(moveObjects) {}
+
+
+/** Whether the last #redo() found free slots for all objects. */
+bool MapCommands::PasteArea::addedAllObjects() const {
+	return _addedAllObjects;
+}
+
+
+void MapCommands::PasteArea::redo() {
+	const QRect target = QRect(_position, _clipboard.size()) & _map.rect();
+	
+	_affectedTiles = QRect();
+	if (_clipboard.hasTiles()) {
+		_affectedTiles = _source.isValid() ? (target | _source) : target;
+	}
+	if (not _affectedTiles.isEmpty()) {
+		const int stride = _affectedTiles.width();
+		_previousTiles.resize(stride * _affectedTiles.height());
+		_map.copyTiles(_affectedTiles, _previousTiles.data());
+		
+		std::vector<uint8_t> tiles(_previousTiles);
+		if (_source.isValid()) {
+			const QPoint offset = _source.topLeft() - _affectedTiles.topLeft();
+			for (int y = 0; y < _source.height(); ++y) {
+				memset(&tiles[offset.x() + stride * (offset.y() + y)], 0, _source.width());
+			}
+		}
+		const QPoint dst = target.topLeft() - _affectedTiles.topLeft();
+		const QPoint src = target.topLeft() - _position;
+		for (int y = 0; y < target.height(); ++y) {
+			memcpy(&tiles[dst.x() + stride * (dst.y() + y)],
+			       &_clipboard.tiles()[src.x() + _clipboard.size().width() * (src.y() + y)],
+			       target.width());
+		}
+		_map.setTiles(_affectedTiles, tiles.data());
+	}
+	
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		_previousObjects[id] = _map.object(id);
+	}
+	if (_moveObjects and _source.isValid()) {
+		_map.deleteObjects(_map.objectIndex().objectsIn(_source));
+	}
+	_addedAllObjects = true;
+	for (int i = 0; i < _clipboard.objectCount(); ++i) {
+		MapObject object = _clipboard.object(i);
+		if (object.group() == MapObject::Group::Invalid) { continue; }
+		const QPoint position = object.pos() + _position;
+		if (not _map.rect().contains(position)) { continue; }
+		const MapObject::id_t objectId = _map.nextAvailableObjectId(object.group());
+		if (objectId == MapObject::IdNone) {
+			_addedAllObjects = false;
+			continue;
+		}
+		object.x = position.x();
+		object.y = position.y();
+		_map.setObject(objectId, object);
+	}
+}
+
+
+void MapCommands::PasteArea::undo() {
+	if (not _affectedTiles.isEmpty()) {
+		_map.setTiles(_affectedTiles, _previousTiles.data());
+	}
+	_map.setObjects(_previousObjects);
 }
 
 
@@ -176,6 +326,24 @@ void MapCommands::SetTile::undo() {
 }
 
 
+MapCommands::SetTiles::SetTiles(Map &map, const QRect &rect, const uint8_t *tiles,
+                                 const QString &text, QUndoCommand *parent)
+    : QUndoCommand(text, parent), _map(map), _rect(rect),
+      _tiles(tiles, tiles + rect.width() * rect.height()),
+      _previousTiles(rect.width() * rect.height()) {}
+
+
+void MapCommands::SetTiles::redo() {
+	_map.copyTiles(_rect, _previousTiles.data());
+	_map.setTiles(_rect, _tiles.data());
+}
+
+
+void MapCommands::SetTiles::undo() {
+	_map.setTiles(_rect, _previousTiles.data());
+}
+
+
 MapCommands::FloodFill::FloodFill(Map &map, const QPoint &pos, uint8_t tileNo, QUndoCommand *parent)
     : QUndoCommand("Flood fill", parent), _map(map), _pos(pos), _tileNo(tileNo) {
 	_previousTiles = new uint8_t[_map.width() * _map.height()];
@@ -198,25 +366,75 @@ void MapCommands::FloodFill::undo() {
 }
 
 
+MapCommands::ChangeTiles::ChangeTiles(Map &map, const std::vector<Map::TileChange> &changes,
+                                       const QString &text, QUndoCommand *parent)
+    : QUndoCommand(text, parent), _map(map), _changes(changes) {}
 
-MapCommands::SetWall::SetWall(Map &map, const QPoint &pos, QUndoCommand *parent) 
-	: QUndoCommand("Draw Wall", parent), _map(map), _pos(pos) {}
 
+void MapCommands::ChangeTiles::redo() {
+	_map.changeTiles(_changes);
+}
 
-void MapCommands::SetWall::redo() {
-	_previousTileNo = _map.tileNo(_pos);
-	if (_pos.x() > 0) { _previousLTRB[0] = _map.tileNo(_pos - QPoint(1, 0)); }
-	if (_pos.y() > 0) { _previousLTRB[1] = _map.tileNo(_pos - QPoint(0, 1)); }
-	if (_pos.x() < _map.width() - 1) { _previousLTRB[2] = _map.tileNo(_pos + QPoint(1, 0)); }
-	if (_pos.y() > _map.height() - 1) { _previousLTRB[3] = _map.tileNo(_pos + QPoint(0, 1)); }
-	_map.setWall(_pos);
+
+void MapCommands::ChangeTiles::undo() {
+	_map.changeTiles(_changes, true);
 }
 
 
-void MapCommands::SetWall::undo() {
-	_map.setTile(_pos, _previousTileNo);
-	if (_pos.x() > 0) { _map.setTile(_pos - QPoint(1, 0), _previousLTRB[0]); }
-	if (_pos.y() > 0) { _map.setTile(_pos - QPoint(0, 1), _previousLTRB[1]); }
-	if (_pos.x() < _map.width() - 1) { _map.setTile(_pos + QPoint(1, 0), _previousLTRB[2]); }
-	if (_pos.y() > _map.height() - 1) { _map.setTile(_pos + QPoint(0, 1), _previousLTRB[3]); }
+#ifdef ENABLE_TRACING
+size_t MapCommands::DeleteObjects::memoryUsage() const {
+	return sizeof(*this) + _objectIds.capacity() * sizeof(MapObject::id_t);
+}
+
+
+size_t MapCommands::FloodFill::memoryUsage() const {
+	return sizeof(*this) + _map.width() * _map.height();
+}
+
+
+size_t MapCommands::PasteArea::memoryUsage() const {
+	const QSize size = _clipboard.size();
+	return sizeof(*this) + size.width() * size.height() + _clipboard.objectCount() * sizeof(MapObject)
+	        + _previousTiles.capacity();
+}
+
+
+size_t MapCommands::SetTiles::memoryUsage() const {
+	return sizeof(*this) + _tiles.capacity() + _previousTiles.capacity();
+}
+
+
+size_t MapCommands::ChangeTiles::memoryUsage() const {
+	return sizeof(*this) + _changes.capacity() * sizeof(Map::TileChange);
+}
+
+
+/** An estimate of the memory used by \a command and its children. */
+size_t MapCommands::memoryUsage(const QUndoCommand *command) {
+	size_t size = sizeof(QUndoCommand);
+	if (const FloodFill *c = dynamic_cast<const FloodFill*>(command)) {
+		size = c->memoryUsage();
+	} else if (const PasteArea *c = dynamic_cast<const PasteArea*>(command)) {
+		size = c->memoryUsage();
+	} else if (const SetTiles *c = dynamic_cast<const SetTiles*>(command)) {
+		size = c->memoryUsage();
+	} else if (const ChangeTiles *c = dynamic_cast<const ChangeTiles*>(command)) {
+		size = c->memoryUsage();
+	} else if (dynamic_cast<const DeleteObject*>(command)) {
+		size = sizeof(DeleteObject);
+	} else if (const DeleteObjects *c = dynamic_cast<const DeleteObjects*>(command)) {
+		size = c->memoryUsage();
+	} else if (dynamic_cast<const ModifyObject*>(command)) {
+		size = sizeof(ModifyObject);
+	} else if (dynamic_cast<const MoveObject*>(command)) {
+		size = sizeof(MoveObject);
+	} else if (dynamic_cast<const SetTile*>(command)) {
+		size = sizeof(SetTile);
+	}
+	size += command->text().size() * sizeof(QChar);
+	for (int i = 0; i < command->childCount(); ++i) {
+		size += memoryUsage(command->child(i));
+	}
+	return size;
 }
+#endif
@@ -2,9 +2,13 @@
 #define MAPCOMMANDS_H
 
 
+#include <QElapsedTimer>
 #include <QPoint>
+#include <QRect>
 #include <QUndoCommand>
+#include <vector>
 #include "map.h"
+#include "mapclipboard.h"
 #include "mapobject.h"
 
 
@@ -23,10 +27,29 @@ private:
 };
 
 
+class DeleteObjects : public QUndoCommand {
+public:
+	DeleteObjects(Map &map, const std::vector<MapObject::id_t> &objectIds, QUndoCommand *parent = nullptr);
+	
+#ifdef ENABLE_TRACING
+	size_t memoryUsage() const;
+#endif
+	void redo() override;
+	void undo() override;
+private:
+	Map &_map;
+	const std::vector<MapObject::id_t> _objectIds;
+	MapObject _previousState[MapObject::IdMax + 1];
+};
+
+
 class ModifyObject : public QUndoCommand {
 public:
-	ModifyObject(Map &map, MapObject::id_t objectId, const MapObject &object, QUndoCommand *parent = nullptr);
+	ModifyObject(Map &map, MapObject::id_t objectId, const MapObject &object, int mergeCounter,
+	             QUndoCommand *parent = nullptr);
 	
+	int id() const override;
+	bool mergeWith(const QUndoCommand *command) override;
 	void redo() override;
 	void undo() override;
 	
@@ -37,6 +60,9 @@ private:
 	const MapObject::id_t _objectId;
 	MapObject _object;
 	MapObject _previousObject;
+	uint8_t _fields;
+	int _mergeCounter;
+	QElapsedTimer _lastEdit;
 };
 
 
@@ -76,6 +102,9 @@ public:
 	FloodFill(Map &map, const QPoint &pos, uint8_t tileNo, QUndoCommand *parent = nullptr);
 	virtual ~FloodFill();
 	
+#ifdef ENABLE_TRACING
+	size_t memoryUsage() const;
+#endif
 	void redo() override;
 	void undo() override;
 	
@@ -87,6 +116,32 @@ private:
 };
 
 
+class PasteArea : public QUndoCommand {
+public:
+	PasteArea(Map &map, const MapClipboard &clipboard, const QPoint &position,
+	          const QRect &source = QRect(), bool moveObjects = false, QUndoCommand *parent = nullptr);
+	
+	bool addedAllObjects() const;
+	
+#ifdef ENABLE_TRACING
+	size_t memoryUsage() const;
+#endif
+	void redo() override;
+	void undo() override;
+	
+private:
+	Map &_map;
+	const MapClipboard _clipboard;
+	const QPoint _position;
+	const QRect _source;
+	const bool _moveObjects;
+	QRect _affectedTiles;
+	std::vector<uint8_t> _previousTiles;
+	MapObject _previousObjects[MapObject::IdMax + 1];
+	bool _addedAllObjects = true;
+};
+
+
 class SetTile : public QUndoCommand {
 public:
 	SetTile(Map &map, const QPoint &pos, uint8_t tileNo, QUndoCommand *parent = nullptr);
@@ -102,19 +157,44 @@ private:
 };
 
 
-class SetWall : public QUndoCommand {
+class SetTiles : public QUndoCommand {
 public:
-	SetWall(Map &map, const QPoint &pos, QUndoCommand *parent = nullptr);
+	SetTiles(Map &map, const QRect &rect, const uint8_t *tiles, const QString &text,
+	         QUndoCommand *parent = nullptr);
 	
+#ifdef ENABLE_TRACING
+	size_t memoryUsage() const;
+#endif
 	void redo() override;
 	void undo() override;
 	
 private:
 	Map &_map;
-	const QPoint _pos;
-	uint8_t _previousTileNo;
-	uint8_t _previousLTRB[4];
+	const QRect _rect;
+	std::vector<uint8_t> _tiles;
+	std::vector<uint8_t> _previousTiles;
+};
+
+
+class ChangeTiles : public QUndoCommand {
+public:
+	ChangeTiles(Map &map, const std::vector<Map::TileChange> &changes, const QString &text,
+	            QUndoCommand *parent = nullptr);
+	
+#ifdef ENABLE_TRACING
+	size_t memoryUsage() const;
+#endif
+	void redo() override;
+	void undo() override;
+	
+private:
+	Map &_map;
+	const std::vector<Map::TileChange> _changes;
 };
+
+#ifdef ENABLE_TRACING
+size_t memoryUsage(const QUndoCommand *command);
+#endif
 } // namespace MapCommands
 
 #endif // MAPCOMMANDS_H
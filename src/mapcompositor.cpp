@@ -0,0 +1,108 @@
+#include "mapcompositor.h"
+#include <QtConcurrent>
+#include "constants.h"
+#include "map.h"
+#include "tileset.h"
+#include "trace.h"
+
+
+static constexpr int BAND_ROWS = 4; // map rows per band
+
+
+/** @class MapCompositor
+ * Draws the tiles of a whole map into an image in the background.
+ *
+ * The map is split into horizontal bands of a few rows each, which are drawn
+ * concurrently on the global thread pool. Drawing happens in a back buffer,
+ * while #image() keeps returning the last finished image. When all bands are
+ * done, the buffers are swapped and #finished() is emitted. The GUI thread
+ * therefore never waits for drawing, except when there is no finished image
+ * yet.
+ *
+ * If #compose() is called again while drawing is still in progress, the
+ * request is queued, and only the most recent one is drawn afterwards.
+ */
+
+
+MapCompositor::MapCompositor(QObject *parent) : QObject(parent) {
+	connect(&_watcher, &QFutureWatcher<void>::finished, this, &MapCompositor::onFinished);
+}
+
+
+MapCompositor::~MapCompositor() {
+	_watcher.waitForFinished();
+}
+
+
+/** Starts drawing the tiles of \a map with \a tileset. The map and the
+ * tileset are copied, so they need not stay unchanged until it's done.
+ */
+void MapCompositor::compose(const Map &map, const Tileset &tileset) {
+	TRACE_SCOPE("MapCompositor::compose");
+	_next.width = map.width();
+	_next.height = map.height();
+	_next.tiles.assign(map.tiles(), map.tiles() + map.width() * map.height());
+	_next.images = TileBlitter::tileImages(tileset);
+	_hasNext = true;
+	if (not _composing) { start(); }
+}
+
+
+bool MapCompositor::isComposing() const {
+	return _composing;
+}
+
+
+/** Blocks until all requested drawing is done and #image() is up to date. */
+void MapCompositor::waitForFinished() {
+	TRACE_SCOPE("MapCompositor::waitForFinished");
+	while (_composing) {
+		_watcher.waitForFinished();
+		onFinished();
+	}
+}
+
+
+/** The last finished image, or a null image if there is none yet. It may be
+ * painted on, until the next composition finishes and replaces it.
+ */
+QImage *MapCompositor::image() {
+	return &_front;
+}
+
+
+void MapCompositor::start() {
+	_job = std::move(_next);
+	_hasNext = false;
+	const QSize size(_job.width * _job.images[0].width(), _job.height * _job.images[0].height());
+	if (_back.size() != size) {
+		_back = QImage(size, IMAGE_FORMAT);
+	}
+	// detach here, as the workers mustn't
+	_job.target = _back.bits();
+	_job.bytesPerLine = _back.bytesPerLine();
+
+	_bands.clear();
+	for (int row = 0; row < _job.height; row += BAND_ROWS) {
+		_bands.push_back(row);
+	}
+	_composing = true;
+#ifdef ENABLE_TRACING
+	_timer.start();
+#endif
+	_watcher.setFuture(QtConcurrent::map(_bands, [this](int firstRow) {
+		TRACE_SCOPE("MapCompositor::band");
+		_blitter.blit(_job.target, _job.bytesPerLine, _job.tiles.data(), _job.width,
+		              firstRow, qMin(BAND_ROWS, _job.height - firstRow), _job.images);
+	}));
+}
+
+
+void MapCompositor::onFinished() {
+	if (not _composing) { return; }
+	_composing = false;
+	TRACE_COUNTER("MapCompositor::composeTime", _timer.nsecsElapsed());
+	_front.swap(_back);
+	emit finished();
+	if (_hasNext) { start(); }
+}
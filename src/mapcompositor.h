@@ -0,0 +1,61 @@
+#ifndef MAPCOMPOSITOR_H
+#define MAPCOMPOSITOR_H
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QObject>
+#include <cstdint>
+#include <vector>
+#include "tileblitter.h"
+
+class Map;
+class Tileset;
+
+
+class MapCompositor : public QObject {
+	Q_OBJECT
+public:
+	MapCompositor(QObject *parent = nullptr);
+	virtual ~MapCompositor();
+
+	void compose(const Map &map, const Tileset &tileset);
+	bool isComposing() const;
+	void waitForFinished();
+
+	QImage *image();
+
+signals:
+	void finished();
+
+private:
+	/** What is being composed: a copy of the map's tiles and of the tile
+	 * images, so the map and tileset can change in the meantime.
+	 */
+	struct Job {
+		std::vector<uint8_t> tiles;
+		int width = 0;
+		int height = 0;
+		std::vector<QImage> images;
+		uchar *target = nullptr;
+		int bytesPerLine = 0;
+	};
+
+	void start();
+	void onFinished();
+
+	TileBlitter _blitter;
+	QImage _front;
+	QImage _back;
+	Job _job;
+	Job _next;
+	bool _hasNext = false;
+	bool _composing = false;
+	std::vector<int> _bands;
+	QFutureWatcher<void> _watcher;
+#ifdef ENABLE_TRACING
+	QElapsedTimer _timer;
+#endif
+};
+
+#endif // MAPCOMPOSITOR_H
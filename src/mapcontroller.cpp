@@ -1,10 +1,16 @@
 #include "mapcontroller.h"
 #include <QAction>
 #include <QKeySequence>
+#include <QRect>
+#include <cstring>
 #include <random>
+#include <vector>
 #include "map.h"
+#include "mapclipboard.h"
 #include "mapcommands.h"
 #include "mapobject.h"
+#include "trace.h"
+#include "wallengine.h"
 
 
 /** @class MapController
@@ -40,6 +46,9 @@
 MapController::MapController(QObject *parent) : QObject(parent) {
 	_map = new Map(this);
 	_undoStack.setUndoLimit(64);
+#ifdef ENABLE_TRACING
+	connect(&_undoStack, &QUndoStack::indexChanged, this, &MapController::updateUndoMemory);
+#endif
 }
 
 /** Get a pointer to the map. Only use its const methods! */
@@ -92,6 +101,19 @@ QString MapController::load(const QString &path) {
 }
 
 
+/** Loads the map from \a data in the layout of a map file, e.g. from an
+ * archive. The map has no path afterwards, so it can only be saved with
+ * "Save As".
+ */
+QString MapController::loadData(const QByteArray &data) {
+	QString result = _map->loadData(data);
+	if (result.isNull()) {
+		_undoStack.clear();
+	}
+	return result;
+}
+
+
 QString MapController::save(const QString &path) {
 	QString result = _map->save(path);
 	if (result.isNull()) {
@@ -106,7 +128,21 @@ QString MapController::save(const QString &path) {
 /** Delete the object in slot \a objectId. */
 void MapController::deleteObject(MapObject::id_t objectId) {
 	Q_ASSERT(MapObject::IdMin <= objectId and objectId <= MapObject::IdMax);
-	_undoStack.push(new MapCommands::DeleteObject(*_map, objectId));
+	push(new MapCommands::DeleteObject(*_map, objectId));
+}
+
+
+/** Delete all objects in \a rect, or all \a objectIds, in a single undo
+ * step. The remaining objects are compacted only once.
+ */
+void MapController::deleteObjects(const QRect &rect) {
+	deleteObjects(_map->objectIndex().objectsIn(rect));
+}
+
+
+void MapController::deleteObjects(const std::vector<MapObject::id_t> &objectIds) {
+	if (objectIds.empty()) { return; }
+	push(new MapCommands::DeleteObjects(*_map, objectIds));
 }
 
 
@@ -117,7 +153,7 @@ void MapController::deleteObject(MapObject::id_t objectId) {
  * the merging, call #incrementMergeCounter() after each group of moves.
  */
 void MapController::moveObject(MapObject::id_t objectId, const QPoint &position) {
-	_undoStack.push(new MapCommands::MoveObject(*_map, objectId, position, _mergeCounter));
+	push(new MapCommands::MoveObject(*_map, objectId, position, _mergeCounter));
 }
 
 
@@ -141,7 +177,7 @@ MapObject::id_t MapController::newObject(const MapObject &object, QString *error
 		}
 	}
 	
-	_undoStack.push(new MapCommands::NewObject(*_map, id, object));
+	push(new MapCommands::NewObject(*_map, id, object));
 	
 	return id;
 }
@@ -151,17 +187,19 @@ MapObject::id_t MapController::newObject(const MapObject &object, QString *error
  * Put \a object into slot \a objectId.
  * 
  * \a isNew only influences how this action is shown in the undo stack.
+ * Quick successive changes to the same fields of an object are merged into
+ * a single undo action, like the moves in #moveObject().
  */
 void MapController::setObject(MapObject::id_t objectId, const MapObject &object, bool isNew) {
 	if (isNew) {
-		_undoStack.push(new MapCommands::NewObject(*_map, objectId, object));
+		push(new MapCommands::NewObject(*_map, objectId, object));
 	} else {
-		_undoStack.push(new MapCommands::ModifyObject(*_map, objectId, object));
+		push(new MapCommands::ModifyObject(*_map, objectId, object, _mergeCounter));
 	}
 }
 
 
-/** Create an undo action merge barrier. @see #moveObject(). */
+/** Create an undo action merge barrier. @see #moveObject(), #setObject(). */
 void MapController::incrementMergeCounter() {
 	++_mergeCounter;
 }
@@ -193,7 +231,7 @@ void MapController::endUndoGroup() {
  * \a position. This works like in a painting program.
  */
 void MapController::floodFill(const QPoint &position, uint8_t tileNo) {
-	_undoStack.push(new MapCommands::FloodFill(*_map, position, tileNo));
+	push(new MapCommands::FloodFill(*_map, position, tileNo));
 }
 
 
@@ -206,12 +244,75 @@ void MapController::floodFill(const QPoint &position, uint8_t tileNo) {
  * however.
  */
 void MapController::setTile(const QPoint &position, uint8_t tileNo) {
-	_undoStack.push(new MapCommands::SetTile(*_map, position, tileNo));
+	push(new MapCommands::SetTile(*_map, position, tileNo));
+}
+
+
+/** Set a block of tiles.
+ * Change the map tiles in \a rect to \a tiles, which are given row by row.
+ * This creates a single undo action, regardless of the size of \a rect.
+ */
+void MapController::setTiles(const QRect &rect, const uint8_t *tiles, const QString &description) {
+	push(new MapCommands::SetTiles(*_map, rect, tiles,
+	                                          description.isNull() ? "Set Tiles" : description));
+}
+
+
+/** Paste the tiles and objects in \a clipboard at \a position.
+ * 
+ * If \a source is valid, the clipboard contents are moved from \a source
+ * instead, see #MapCommands::PasteArea. Either way, this creates a single
+ * undo action.
+ * 
+ * @return \c false if not all objects could be placed because there weren't
+ *         enough free object slots, \c true otherwise
+ */
+bool MapController::pasteArea(const MapClipboard &clipboard, const QPoint &position, const QRect &source,
+                              bool moveObjects) {
+	MapCommands::PasteArea *command = new MapCommands::PasteArea(*_map, clipboard, position, source,
+	                                                             moveObjects);
+	push(command);
+	return command->addedAllObjects();
 }
 
 
 void MapController::drawWall(const QPoint &position) {
-	_undoStack.push(new MapCommands::SetWall(*_map, position));
+	std::vector<uint8_t> tiles(_map->tiles(), _map->tiles() + _map->width() * _map->height());
+	WallEngine(tiles.data(), _map->width(), _map->height()).drawWall(position);
+	changeTiles(tiles.data(), "Draw Wall");
+}
+
+
+/** Replaces every occurrence of \a oldTileNo with \a newTileNo, in a single
+ * undo step.
+ */
+void MapController::replaceTile(uint8_t oldTileNo, uint8_t newTileNo) {
+	if (oldTileNo == newTileNo) { return; }
+	std::vector<Map::TileChange> changes;
+	for (const QPoint &position : _map->tileIndex().positions(oldTileNo)) {
+		changes.push_back({ position.x() + _map->width() * position.y(), oldTileNo, newTileNo });
+	}
+	if (not changes.empty()) {
+		push(new MapCommands::ChangeTiles(*_map, changes, "Replace Tile"));
+	}
+}
+
+
+/** Puts the row by row buffer \a tiles of size \a size at each of
+ * \a positions, in a single undo step. Parts that would lie outside of the map
+ * are cut off.
+ */
+void MapController::replacePattern(const std::vector<QPoint> &positions, const QSize &size,
+                                   const uint8_t *tiles) {
+	std::vector<uint8_t> newTiles(_map->tiles(), _map->tiles() + _map->width() * _map->height());
+	for (const QPoint &position : positions) {
+		const QRect rect = QRect(position, size) & _map->rect();
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			memcpy(&newTiles[rect.left() + _map->width() * y],
+			       &tiles[rect.left() - position.x() + size.width() * (y - position.y())], rect.width());
+		}
+	}
+	changeTiles(newTiles.data(), "Replace Pattern");
 }
 
 
@@ -229,6 +330,69 @@ void MapController::randomizeGrass(const QRect &rect) {
 }
 
 
+/** Recomputes all walls in \a rect, so they connect to each other and to the
+ * walls around \a rect.
+ */
+void MapController::rewall(const QRect &rect) {
+	std::vector<uint8_t> tiles(_map->tiles(), _map->tiles() + _map->width() * _map->height());
+	WallEngine(tiles.data(), _map->width(), _map->height()).rewall(rect);
+	changeTiles(tiles.data(), "Re-wall");
+}
+
+
+/** Pushes a single undo command that changes the map's tiles to \a tiles,
+ * which must be the size of the map. Only the tiles that actually differ are
+ * recorded.
+ */
+void MapController::changeTiles(const uint8_t *tiles, const QString &description) {
+	std::vector<Map::TileChange> changes = _map->diffTiles(tiles);
+	if (not changes.empty()) {
+		push(new MapCommands::ChangeTiles(*_map, changes, description));
+	}
+}
+
+
+/** Pushes \a command onto the undo stack, which executes it. */
+void MapController::push(QUndoCommand *command) {
+	TRACE_SCOPE("MapController::push");
+	_undoStack.push(command);
+}
+
+
+#ifdef ENABLE_TRACING
+/** Updates the estimate of the undo stack's memory after its index changed,
+ * without walking the whole stack. Only the command below the new index and
+ * those above it can have been added, merged into or discarded, apart from
+ * the oldest commands, which the undo limit drops from the bottom.
+ */
+void MapController::updateUndoMemory() {
+	const int count = _undoStack.count();
+	while (not _commandMemory.empty()
+	       and (count == 0 or _commandMemory.front().first != _undoStack.command(0))) {
+		_undoMemory -= _commandMemory.front().second;
+		_commandMemory.pop_front();
+	}
+	while (_commandMemory.size() > size_t(count)) {
+		_undoMemory -= _commandMemory.back().second;
+		_commandMemory.pop_back();
+	}
+	const int first = qMin(int(_commandMemory.size()), qMax(0, _undoStack.index() - 1));
+	for (int i = first; i < count; ++i) {
+		const QUndoCommand *command = _undoStack.command(i);
+		const size_t memory = MapCommands::memoryUsage(command);
+		if (size_t(i) < _commandMemory.size()) {
+			_undoMemory -= _commandMemory[i].second;
+			_commandMemory[i] = { command, memory };
+		} else {
+			_commandMemory.push_back({ command, memory });
+		}
+		_undoMemory += memory;
+	}
+	TRACE_COUNTER("MapController::undoMemory", _undoMemory);
+}
+#endif
+
+
 void MapController::randomize(const QRect &rect, const std::unordered_set<uint8_t> tiles) {
 	static std::mt19937 gen;
 	std::uniform_int_distribution<size_t> randDist(0, tiles.size() - 1);
@@ -3,11 +3,15 @@
 
 #include <QObject>
 #include <QPoint>
+#include <QSize>
 #include <QUndoStack>
+#include <deque>
 #include <unordered_set>
+#include <vector>
 #include "mapobject.h"
 
 class Map;
+class MapClipboard;
 
 class MapController : public QObject {
 	Q_OBJECT
@@ -22,9 +26,12 @@ public:
 	void clear();
 	
 	QString load(const QString &path);
+	QString loadData(const QByteArray &data);
 	QString save(const QString &path);
 	
 	void deleteObject(MapObject::id_t objectId);
+	void deleteObjects(const QRect &rect);
+	void deleteObjects(const std::vector<MapObject::id_t> &objectIds);
 	void moveObject(MapObject::id_t objectId, const QPoint &position);
 	MapObject::id_t newObject(const MapObject &object, QString *error);
 	void setObject(MapObject::id_t objectId, const MapObject &object, bool isNew = false);
@@ -34,13 +41,24 @@ public:
 	void endUndoGroup();
 	void floodFill(const QPoint &position, uint8_t tileNo);
 	void setTile(const QPoint &position, uint8_t tileNo);
+	void setTiles(const QRect &rect, const uint8_t *tiles, const QString &description = QString());
+	bool pasteArea(const MapClipboard &clipboard, const QPoint &position, const QRect &source = QRect(),
+	               bool moveObjects = false);
 	void drawWall(const QPoint &position);
+	void replaceTile(uint8_t oldTileNo, uint8_t newTileNo);
+	void replacePattern(const std::vector<QPoint> &positions, const QSize &size, const uint8_t *tiles);
 	
 public slots:
 	void randomizeDirt(const QRect &rect);
 	void randomizeGrass(const QRect &rect);
+	void rewall(const QRect &rect);
 	
 private:
+	void changeTiles(const uint8_t *tiles, const QString &description);
+	void push(QUndoCommand *command);
+#ifdef ENABLE_TRACING
+	void updateUndoMemory();
+#endif
 	void randomize(const QRect &rect, const std::unordered_set<uint8_t> tiles);
 	
 	Map *_map;
@@ -49,6 +67,10 @@ private:
 	QUndoStack _undoStack;
 	int _mergeCounter = 0;
 	bool _inMacro = false;
+#ifdef ENABLE_TRACING
+	std::deque<std::pair<const QUndoCommand*, size_t>> _commandMemory; ///< estimate for each command on the stack
+	size_t _undoMemory = 0;
+#endif
 };
 
 #endif // MAPCONTROLLER_H
@@ -0,0 +1,311 @@
+#include "mapdiff.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "map.h"
+
+
+/** @class MapDiff
+ * The differences between two maps: which tiles changed, grouped into
+ * rectangles, and which object slots were added, removed or modified.
+ *
+ * Tile rows are first compared as a whole, and rows that differ are compared
+ * eight tiles at a time, so identical areas cost next to nothing. Objects are
+ * compared slot by slot, because the slot number is the object's identity in
+ * the game.
+ *
+ * #merge() combines two sets of changes made to the same base map, tile by
+ * tile and, within each object group, object slot by object slot.
+ */
+
+
+/** Covers the cells set in \a cells with rectangles: runs of set cells within
+ * a row are extended downwards as long as the rows below have a run with the
+ * same extent.
+ */
+static std::vector<QRect> coveringRects(const std::vector<bool> &cells, int width, int height) {
+	std::vector<QRect> result;
+	std::vector<QRect> open;
+	std::vector<QRect> next;
+	for (int y = 0; y < height; ++y) {
+		next.clear();
+		for (int x = 0; x < width; ++x) {
+			if (not cells[x + width * y]) { continue; }
+			const int left = x;
+			while (x + 1 < width and cells[x + 1 + width * y]) { ++x; }
+			bool extended = false;
+			for (QRect &rect : open) {
+				if (rect.isValid() and rect.left() == left and rect.right() == x) {
+					rect.setBottom(y);
+					next.push_back(rect);
+					rect = QRect();
+					extended = true;
+					break;
+				}
+			}
+			if (not extended) { next.push_back(QRect(left, y, x - left + 1, 1)); }
+		}
+		for (const QRect &rect : open) {
+			if (rect.isValid()) { result.push_back(rect); }
+		}
+		std::swap(open, next);
+	}
+	result.insert(result.end(), open.begin(), open.end());
+	return result;
+}
+
+
+static uint64_t load64(const uint8_t *p) {
+	uint64_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+
+MapDiff::MapDiff(const Map &before, const Map &after)
+    : _width(after.width()), _height(after.height()), _changed(_width * _height, false) {
+	Q_ASSERT(before.width() == after.width() and before.height() == after.height());
+	diffTiles(before.tiles(), after.tiles());
+	diffObjects(before, after);
+}
+
+
+bool MapDiff::isEmpty() const {
+	return _changedTileCount == 0 and _objectDeltas.empty();
+}
+
+
+int MapDiff::changedTileCount() const {
+	return _changedTileCount;
+}
+
+
+bool MapDiff::isTileChanged(const QPoint &position) const {
+	return _changed[position.x() + _width * position.y()];
+}
+
+
+/** Rectangles covering exactly the changed tiles, in row order. */
+const std::vector<QRect> &MapDiff::changedRects() const {
+	return _changedRects;
+}
+
+
+const std::vector<MapDiff::ObjectDelta> &MapDiff::objectDeltas() const {
+	return _objectDeltas;
+}
+
+
+/** A human readable description of the differences, one line per changed
+ * area or object.
+ */
+QStringList MapDiff::describe() const {
+	QStringList lines;
+	for (const QRect &rect : _changedRects) {
+		lines.append(QString("tiles changed at %1,%2 size %3x%4")
+		             .arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height()));
+	}
+	for (const ObjectDelta &delta : _objectDeltas) {
+		switch (delta.change) {
+		case ObjectChange::Added:
+			lines.append(QString("object %1 added: %2 at %3,%4").arg(delta.id)
+			             .arg(MapObject::toString(delta.after.unitType)).arg(delta.after.x).arg(delta.after.y));
+			break;
+		case ObjectChange::Removed:
+			lines.append(QString("object %1 removed: %2 at %3,%4").arg(delta.id)
+			             .arg(MapObject::toString(delta.before.unitType)).arg(delta.before.x)
+			             .arg(delta.before.y));
+			break;
+		case ObjectChange::Modified: {
+			QStringList fields;
+			const MapObject &b = delta.before;
+			const MapObject &a = delta.after;
+			if (b.unitType != a.unitType) {
+				fields.append(QString("type %1 -> %2").arg(MapObject::toString(b.unitType),
+				                                           MapObject::toString(a.unitType)));
+			}
+			if (b.pos() != a.pos()) {
+				fields.append(QString("position %1,%2 -> %3,%4").arg(b.x).arg(b.y).arg(a.x).arg(a.y));
+			}
+			if (b.a != a.a) { fields.append(QString("a %1 -> %2").arg(b.a).arg(a.a)); }
+			if (b.b != a.b) { fields.append(QString("b %1 -> %2").arg(b.b).arg(a.b)); }
+			if (b.c != a.c) { fields.append(QString("c %1 -> %2").arg(b.c).arg(a.c)); }
+			if (b.d != a.d) { fields.append(QString("d %1 -> %2").arg(b.d).arg(a.d)); }
+			if (b.health != a.health) { fields.append(QString("health %1 -> %2").arg(b.health).arg(a.health)); }
+			lines.append(QString("object %1 modified: %2").arg(delta.id).arg(fields.join(", ")));
+			break;
+		}
+		}
+	}
+	return lines;
+}
+
+
+/** Merges the object slots \a first to \a last into \a objects, see
+ * MapDiff::merge().
+ *
+ * Deleting an object moves the objects above it in its group down one slot,
+ * so once the number of objects in the range changed, the same slot may hold
+ * different objects on each side. If that happened and both sides changed
+ * the range, the whole range is one conflict.
+ * @return \c true if there were no conflicts
+ */
+static bool mergeObjects(const Map &base, const Map &ours, const Map &theirs, MapObject::id_t first,
+                         MapObject::id_t last, MapObject *objects, QStringList *conflicts) {
+	bool oursChanged = false;
+	bool theirsChanged = false;
+	bool sameOnBothSides = true;
+	int baseCount = 0;
+	int oursCount = 0;
+	int theirsCount = 0;
+	for (MapObject::id_t id = first; id <= last; ++id) {
+		const MapObject bo = base.object(id);
+		const MapObject oo = ours.object(id);
+		const MapObject to = theirs.object(id);
+		oursChanged = oursChanged or oo != bo;
+		theirsChanged = theirsChanged or to != bo;
+		sameOnBothSides = sameOnBothSides and oo == to;
+		baseCount += bo.unitType != MapObject::UnitType::None;
+		oursCount += oo.unitType != MapObject::UnitType::None;
+		theirsCount += to.unitType != MapObject::UnitType::None;
+	}
+	
+	const auto take = [&](const Map &map) {
+		for (MapObject::id_t id = first; id <= last; ++id) {
+			objects[id] = map.object(id);
+		}
+	};
+	if (not theirsChanged or sameOnBothSides) {
+		take(ours);
+		return true;
+	}
+	if (not oursChanged) {
+		take(theirs);
+		return true;
+	}
+	if (first != last and (oursCount != baseCount or theirsCount != baseCount)) {
+		take(ours);
+		if (conflicts) {
+			conflicts->append(QString("objects %1 to %2 were added or removed on both sides")
+			                  .arg(first).arg(last));
+		}
+		return false;
+	}
+	
+	bool result = true;
+	for (MapObject::id_t id = first; id <= last; ++id) {
+		const MapObject bo = base.object(id);
+		const MapObject oo = ours.object(id);
+		const MapObject to = theirs.object(id);
+		if (oo == to or to == bo) {
+			objects[id] = oo;
+		} else if (oo == bo) {
+			objects[id] = to;
+		} else {
+			objects[id] = oo;
+			result = false;
+			if (conflicts) {
+				conflicts->append(QString("object %1 was changed on both sides").arg(id));
+			}
+		}
+	}
+	return result;
+}
+
+
+/** Combines the changes from \a base to \a ours and from \a base to \a theirs
+ * into \a result. A tile or object slot changed on only one side takes that
+ * side's value; one changed identically on both sides takes that value.
+ * Tiles and objects changed differently on both sides are conflicts: they
+ * keep our value, and are described in \a conflicts. If both sides added or
+ * removed objects of the same group, the whole group is a conflict, as the
+ * slots no longer correspond.
+ * @return \c true if there were no conflicts
+ */
+bool MapDiff::merge(const Map &base, const Map &ours, const Map &theirs, Map &result, QStringList *conflicts) {
+	const int width = base.width();
+	const int height = base.height();
+	const uint8_t *b = base.tiles();
+	const uint8_t *o = ours.tiles();
+	const uint8_t *t = theirs.tiles();
+	std::vector<uint8_t> tiles(o, o + width * height);
+	std::vector<bool> conflicting(width * height, false);
+	bool haveConflicts = false;
+	
+	for (int y = 0; y < height; ++y) {
+		const int row = width * y;
+		if (memcmp(&o[row], &t[row], width) == 0 or memcmp(&t[row], &b[row], width) == 0) { continue; }
+		for (int i = row; i < row + width; ++i) {
+			if (o[i] == t[i] or t[i] == b[i]) { continue; }
+			if (o[i] == b[i]) {
+				tiles[i] = t[i];
+			} else {
+				conflicting[i] = true;
+				haveConflicts = true;
+			}
+		}
+	}
+	
+	// the object groups, and the reserved slots between the robots and the
+	// map features
+	static const std::pair<MapObject::id_t, MapObject::id_t> ranges[] = {
+	    { MapObject::IdPlayer, MapObject::IdPlayer },
+	    { MapObject::IdRobotMin, MapObject::IdRobotMax },
+	    { MapObject::IdRobotMax + 1, MapObject::IdMapFeatureMin - 1 },
+	    { MapObject::IdMapFeatureMin, MapObject::IdMapFeatureMax },
+	    { MapObject::IdHiddenMin, MapObject::IdHiddenMax }};
+	MapObject objects[MapObject::IdMax + 1];
+	for (const std::pair<MapObject::id_t, MapObject::id_t> &range : ranges) {
+		if (not mergeObjects(base, ours, theirs, range.first, range.second, objects, conflicts)) {
+			haveConflicts = true;
+		}
+	}
+	
+	if (conflicts) {
+		for (const QRect &rect : coveringRects(conflicting, width, height)) {
+			conflicts->append(QString("tiles at %1,%2 size %3x%4 were changed on both sides")
+			                  .arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height()));
+		}
+	}
+	
+	result.setTiles(result.rect(), tiles.data());
+	result.setObjects(objects);
+	return not haveConflicts;
+}
+
+
+void MapDiff::diffTiles(const uint8_t *before, const uint8_t *after) {
+	for (int y = 0; y < _height; ++y) {
+		const int row = _width * y;
+		if (memcmp(&before[row], &after[row], _width) == 0) { continue; }
+		for (int x = 0; x < _width; x += 8) {
+			const int i = row + x;
+			if (x + 8 <= _width and load64(&before[i]) == load64(&after[i])) { continue; }
+			for (int j = i; j < row + std::min(x + 8, _width); ++j) {
+				if (before[j] != after[j]) {
+					_changed[j] = true;
+					++_changedTileCount;
+				}
+			}
+		}
+	}
+	_changedRects = coveringRects(_changed, _width, _height);
+}
+
+
+void MapDiff::diffObjects(const Map &before, const Map &after) {
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		const MapObject &b = before.object(id);
+		const MapObject &a = after.object(id);
+		if (a == b) { continue; }
+		ObjectChange change;
+		if (b.unitType == MapObject::UnitType::None) {
+			change = ObjectChange::Added;
+		} else if (a.unitType == MapObject::UnitType::None) {
+			change = ObjectChange::Removed;
+		} else {
+			change = ObjectChange::Modified;
+		}
+		_objectDeltas.push_back({ id, change, b, a });
+	}
+}
@@ -0,0 +1,49 @@
+#ifndef MAPDIFF_H
+#define MAPDIFF_H
+
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <cstdint>
+#include <vector>
+#include "mapobject.h"
+
+class Map;
+
+
+class MapDiff {
+public:
+	enum class ObjectChange { Added, Removed, Modified };
+	
+	struct ObjectDelta {
+		MapObject::id_t id;
+		ObjectChange change;
+		MapObject before;
+		MapObject after;
+	};
+	
+	MapDiff(const Map &before, const Map &after);
+	
+	bool isEmpty() const;
+	int changedTileCount() const;
+	bool isTileChanged(const QPoint &position) const;
+	const std::vector<QRect> &changedRects() const;
+	const std::vector<ObjectDelta> &objectDeltas() const;
+	QStringList describe() const;
+	
+	static bool merge(const Map &base, const Map &ours, const Map &theirs, Map &result,
+	                  QStringList *conflicts);
+	
+private:
+	void diffTiles(const uint8_t *before, const uint8_t *after);
+	void diffObjects(const Map &before, const Map &after);
+	
+	int _width;
+	int _height;
+	std::vector<bool> _changed;
+	int _changedTileCount = 0;
+	std::vector<QRect> _changedRects;
+	std::vector<ObjectDelta> _objectDeltas;
+};
+
+#endif // MAPDIFF_H
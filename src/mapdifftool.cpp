@@ -0,0 +1,121 @@
+#include "mapdifftool.h"
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <cstdio>
+#include "map.h"
+#include "mapdiff.h"
+
+
+/** @class MapDiffTool
+ * Compares and merges maps from the command line, so git can diff and merge
+ * map files:
+ *
+ *     PetsciiRobotsMapEditor --diff OLD NEW
+ *     PetsciiRobotsMapEditor --merge BASE OURS THEIRS [--output PATH]
+ *
+ * `--diff` lists the changed tile areas and objects. It also accepts the
+ * seven arguments git passes to an external diff command, so it can be set
+ * up in `.gitattributes` with `*.petmap diff=petmap` and
+ *
+ *     git config diff.petmap.command "PetsciiRobotsMapEditor --diff"
+ *
+ * `--merge` combines the changes from BASE to OURS and from BASE to THEIRS,
+ * see MapDiff::merge(), and writes the result to OURS unless `--output` is
+ * given. This matches git's merge drivers:
+ *
+ *     git config merge.petmap.driver "PetsciiRobotsMapEditor --merge %O %A %B"
+ *
+ * The exit code is 0 on success, 1 if the merge had conflicts, and 2 on
+ * errors.
+ */
+
+
+/** Loads \a path into \a map. A missing file, as passed by git for added or
+ * deleted files, is an empty map.
+ */
+static QString loadMap(const QString &path, Map &map) {
+	if (path == "/dev/null") {
+		map.clear();
+		return QString();
+	}
+	return map.load(path);
+}
+
+
+/** Run the tool with the command line \a arguments. Returns the exit code. */
+int MapDiffTool::run(const QStringList &arguments) {
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Compare or merge PETSCII Robots maps.");
+	parser.addHelpOption();
+	const QCommandLineOption diffOption("diff", "Compare two maps and exit.");
+	const QCommandLineOption mergeOption("merge", "Merge two maps with a common base and exit.");
+	const QCommandLineOption outputOption("output", "Write the merged map to <path>.", "path");
+	parser.addOption(diffOption);
+	parser.addOption(mergeOption);
+	parser.addOption(outputOption);
+	parser.addPositionalArgument("maps", "OLD NEW for --diff, BASE OURS THEIRS for --merge.", "MAP...");
+	parser.process(arguments);
+	
+	QTextStream out(stdout);
+	QTextStream err(stderr);
+	QStringList paths = parser.positionalArguments();
+	
+	if (parser.isSet(diffOption)) {
+		QString name;
+		if (paths.size() == 7) {
+			// git: path old-file old-hex old-mode new-file new-hex new-mode
+			name = paths[0];
+			paths = QStringList({ paths[1], paths[4] });
+		}
+		if (paths.size() != 2) {
+			err << "--diff needs two maps" << '\n';
+			return 2;
+		}
+		Map before;
+		Map after;
+		const std::pair<QString, Map*> loads[] = { { paths[0], &before }, { paths[1], &after } };
+		for (const std::pair<QString, Map*> &load : loads) {
+			const QString error = loadMap(load.first, *load.second);
+			if (not error.isNull()) {
+				err << load.first << ": " << error << '\n';
+				return 2;
+			}
+		}
+		const MapDiff diff(before, after);
+		const QString prefix = name.isEmpty() ? QString() : name + ": ";
+		for (const QString &line : diff.describe()) {
+			out << prefix << line << '\n';
+		}
+		return 0;
+	}
+	
+	if (paths.size() != 3) {
+		err << "--merge needs three maps" << '\n';
+		return 2;
+	}
+	Map base;
+	Map ours;
+	Map theirs;
+	const std::pair<QString, Map*> loads[] = { { paths[0], &base }, { paths[1], &ours }, { paths[2], &theirs } };
+	for (const std::pair<QString, Map*> &load : loads) {
+		const QString error = loadMap(load.first, *load.second);
+		if (not error.isNull()) {
+			err << load.first << ": " << error << '\n';
+			return 2;
+		}
+	}
+	
+	QStringList conflicts;
+	Map result;
+	const bool clean = MapDiff::merge(base, ours, theirs, result, &conflicts);
+	for (const QString &conflict : conflicts) {
+		err << paths[1] << ": conflict: " << conflict << '\n';
+	}
+	const QString outputPath = parser.isSet(outputOption) ? parser.value(outputOption) : paths[1];
+	const QString error = result.save(outputPath);
+	if (not error.isNull()) {
+		err << outputPath << ": " << error << '\n';
+		return 2;
+	}
+	return clean ? 0 : 1;
+}
@@ -0,0 +1,12 @@
+#ifndef MAPDIFFTOOL_H
+#define MAPDIFFTOOL_H
+
+#include <QStringList>
+
+
+class MapDiffTool {
+public:
+	static int run(const QStringList &arguments);
+};
+
+#endif // MAPDIFFTOOL_H
@@ -0,0 +1,333 @@
+#include "mapindex.h"
+#include <QByteArray>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QSet>
+#include <QVector>
+#include <QtConcurrent>
+#include <algorithm>
+#include "map.h"
+#include "tileindex.h"
+
+
+/** @class MapIndex
+ * An inverted index over all maps in a directory, answering which maps use a
+ * tile and where, and which maps contain objects of a given type or
+ * configuration.
+ *
+ * For every map, the positions of its tiles are stored grouped by tile
+ * number, along with its objects. From those, lists of the maps using each
+ * tile number and each unit type are built, so a query only looks at the
+ * maps that actually match.
+ *
+ * The index is stored in the directory it covers, in a compressed file. When
+ * it is updated, only maps whose modification time or size changed are
+ * loaded again, and those are loaded in parallel.
+ */
+
+
+static constexpr char INDEX_FILE_NAME[] = ".petmapindex";
+static constexpr char INDEX_MAGIC[] = "PMIX";
+static constexpr quint16 INDEX_VERSION = 1;
+
+
+bool MapIndex::ObjectQuery::matches(const MapObject &object) const {
+	return object.unitType == unitType and (a < 0 or a == object.a) and (b < 0 or b == object.b)
+	        and (c < 0 or c == object.c) and (d < 0 or d == object.d);
+}
+
+
+MapIndex::MapIndex(const QString &directory) : _directory(directory) {}
+
+
+const QString &MapIndex::directory() const {
+	return _directory;
+}
+
+
+QString MapIndex::indexPath() const {
+	return QDir(_directory).filePath(INDEX_FILE_NAME);
+}
+
+
+int MapIndex::mapCount() const {
+	return _entries.size();
+}
+
+
+/** Reads the index file. If there is none yet, or it is corrupt, the index is
+ * left empty, so the next #update() rebuilds it from scratch.
+ * @return a null string on success, an error message otherwise
+ */
+QString MapIndex::load() {
+	_entries.clear();
+	rebuildPostings();
+	
+	QFile file(indexPath());
+	if (not file.exists()) { return QString(); }
+	if (not file.open(QFile::ReadOnly)) {
+		return QString("cannot open \"%1\": %2").arg(file.fileName(), file.errorString());
+	}
+	const QByteArray header = file.read(6);
+	if (header.size() != 6 or not header.startsWith(INDEX_MAGIC)) {
+		return QString("\"%1\" is not a map index").arg(file.fileName());
+	}
+	if (quint16((uint8_t(header[4]) << 8) | uint8_t(header[5])) != INDEX_VERSION) {
+		return QString("\"%1\" was written by a different version").arg(file.fileName());
+	}
+	const QByteArray data = qUncompress(file.readAll());
+	
+	QDataStream in(data);
+	in.setVersion(QDataStream::Qt_5_12);
+	quint32 entryCount;
+	in >> entryCount;
+	const QRect bounds = Map().rect();
+	std::vector<Entry> entries;
+	for (quint32 i = 0; i < entryCount and in.status() == QDataStream::Ok; ++i) {
+		Entry entry;
+		in >> entry.fileName >> entry.modified >> entry.size;
+		entry.tileOffsets.resize(257);
+		for (uint16_t &offset : entry.tileOffsets) { in >> offset; }
+		if (in.status() != QDataStream::Ok or entry.tileOffsets.back() > data.size() / 2) { break; }
+		entry.positions.resize(entry.tileOffsets.back());
+		for (uint16_t &position : entry.positions) { in >> position; }
+		quint8 objectCount;
+		in >> objectCount;
+		if (objectCount > MapObject::IdMax + 1) { break; }
+		entry.objects.resize(objectCount);
+		for (MapObject &object : entry.objects) {
+			quint8 unitType;
+			in >> unitType >> object.x >> object.y >> object.a >> object.b >> object.c >> object.d
+			   >> object.health;
+			object.unitType = MapObject::UnitType(unitType);
+		}
+		if (in.status() != QDataStream::Ok or not isValid(entry, bounds)) { break; }
+		entries.push_back(std::move(entry));
+	}
+	if (in.status() != QDataStream::Ok or entries.size() != entryCount or not in.atEnd()) {
+		return QString("\"%1\" is corrupt").arg(file.fileName());
+	}
+	
+	_entries = std::move(entries);
+	rebuildPostings();
+	return QString();
+}
+
+
+/** Writes the index file.
+ * @return a null string on success, an error message otherwise
+ */
+QString MapIndex::save() const {
+	QByteArray data;
+	QDataStream out(&data, QIODevice::WriteOnly);
+	out.setVersion(QDataStream::Qt_5_12);
+	out << quint32(_entries.size());
+	for (const Entry &entry : _entries) {
+		out << entry.fileName << entry.modified << entry.size;
+		for (uint16_t offset : entry.tileOffsets) { out << offset; }
+		for (uint16_t position : entry.positions) { out << position; }
+		out << quint8(entry.objects.size());
+		for (const MapObject &object : entry.objects) {
+			out << quint8(object.unitType) << object.x << object.y << object.a << object.b << object.c
+			    << object.d << object.health;
+		}
+	}
+	
+	QSaveFile file(indexPath());
+	if (not file.open(QFile::WriteOnly)) {
+		return QString("cannot open \"%1\" for writing: %2").arg(file.fileName(), file.errorString());
+	}
+	QByteArray header(INDEX_MAGIC);
+	header.append(char(INDEX_VERSION >> 8));
+	header.append(char(INDEX_VERSION & 0xff));
+	file.write(header);
+	file.write(qCompress(data));
+	if (not file.commit()) {
+		return QString("cannot write to \"%1\": %2").arg(file.fileName(), file.errorString());
+	}
+	return QString();
+}
+
+
+/** Brings the index up to date with the maps in the directory. Maps that are
+ * new or were modified are loaded, in parallel; maps that were deleted are
+ * dropped.
+ */
+MapIndex::UpdateResult MapIndex::update() {
+	UpdateResult result;
+	const QFileInfoList files = QDir(_directory).entryInfoList(nameFilters(), QDir::Files | QDir::Readable,
+	                                                            QDir::Name);
+	
+	QHash<QString, int> existing;
+	for (size_t i = 0; i < _entries.size(); ++i) { existing.insert(_entries[i].fileName, i); }
+	
+	QSet<QString> present;
+	for (const QFileInfo &info : files) { present.insert(info.fileName()); }
+	for (const Entry &entry : _entries) {
+		if (not present.contains(entry.fileName)) { ++result.removed; }
+	}
+	
+	std::vector<Entry> entries;
+	QStringList changed;
+	for (const QFileInfo &info : files) {
+		const auto it = existing.constFind(info.fileName());
+		if (it != existing.constEnd() and _entries[*it].modified == info.lastModified().toMSecsSinceEpoch()
+		        and _entries[*it].size == info.size()) {
+			entries.push_back(std::move(_entries[*it]));
+			++result.unchanged;
+		} else {
+			changed.append(info.absoluteFilePath());
+		}
+	}
+	
+	const QVector<ScanResult> scanned =
+	        QtConcurrent::blockingMapped<QVector<ScanResult>>(changed, &MapIndex::scan);
+	for (int i = 0; i < scanned.size(); ++i) {
+		if (scanned[i].error.isNull()) {
+			entries.push_back(scanned[i].entry);
+			++result.scanned;
+		} else {
+			result.errors.append(QString("%1: %2").arg(changed[i], scanned[i].error));
+		}
+	}
+	
+	std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+		return a.fileName < b.fileName;
+	});
+	_entries = std::move(entries);
+	rebuildPostings();
+	return result;
+}
+
+
+/** All maps that use \a tileNo, with the positions where they use it. */
+std::vector<MapIndex::TileHit> MapIndex::findTile(uint8_t tileNo) const {
+	std::vector<TileHit> hits;
+	for (int entryNo : _tileMaps[tileNo]) {
+		const Entry &entry = _entries[entryNo];
+		TileHit hit;
+		hit.path = absolutePath(entry);
+		for (int i = entry.tileOffsets[tileNo]; i < entry.tileOffsets[tileNo + 1]; ++i) {
+			hit.positions.push_back(QPoint(entry.positions[i] & 0xff, entry.positions[i] >> 8));
+		}
+		hits.push_back(hit);
+	}
+	return hits;
+}
+
+
+/** All maps that contain objects matching \a query, with the ids of those
+ * objects.
+ */
+std::vector<MapIndex::ObjectHit> MapIndex::findObjects(const ObjectQuery &query) const {
+	std::vector<ObjectHit> hits;
+	for (int entryNo : _unitMaps[MapObject::unitType_t(query.unitType)]) {
+		const Entry &entry = _entries[entryNo];
+		ObjectHit hit;
+		for (size_t id = 0; id < entry.objects.size(); ++id) {
+			if (query.matches(entry.objects[id])) { hit.objectIds.push_back(id); }
+		}
+		if (not hit.objectIds.empty()) {
+			hit.path = absolutePath(entry);
+			hits.push_back(hit);
+		}
+	}
+	return hits;
+}
+
+
+/** The file names considered to be maps: the editor's `.petmap` files, and
+ * the game's own `level-*` files.
+ */
+const QStringList &MapIndex::nameFilters() {
+	static const QStringList filters = { "*.petmap", "level-*" };
+	return filters;
+}
+
+
+/** Loads the map at \a path and extracts what the index needs. Runs in a
+ * worker thread.
+ */
+MapIndex::ScanResult MapIndex::scan(const QString &path) {
+	ScanResult result;
+	Map map;
+	result.error = map.load(path);
+	if (not result.error.isNull()) { return result; }
+	
+	const QFileInfo info(path);
+	Entry &entry = result.entry;
+	entry.fileName = info.fileName();
+	entry.modified = info.lastModified().toMSecsSinceEpoch();
+	entry.size = info.size();
+	
+	// a counting sort of the map's tiles, using the counts the map keeps anyway
+	const TileIndex &tileIndex = map.tileIndex();
+	entry.tileOffsets.resize(257);
+	entry.positions.reserve(map.width() * map.height());
+	for (int tileNo = 0; tileNo < 256; ++tileNo) {
+		entry.tileOffsets[tileNo] = entry.positions.size();
+		for (const QPoint &position : tileIndex.positions(tileNo)) {
+			entry.positions.push_back(position.x() | (position.y() << 8));
+		}
+	}
+	entry.tileOffsets[256] = entry.positions.size();
+	
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		entry.objects.push_back(map.object(id));
+	}
+	return result;
+}
+
+
+/** Whether \a entry, as read from the index file, is consistent: a plain
+ * file name, tile offsets that start at 0 and never decrease, and positions
+ * within \a bounds.
+ */
+bool MapIndex::isValid(const Entry &entry, const QRect &bounds) {
+	if (entry.fileName.isEmpty() or entry.fileName.contains("/") or entry.fileName.contains("\\")) {
+		return false;
+	}
+	if (entry.tileOffsets.size() != 257 or entry.tileOffsets.front() != 0
+	        or entry.positions.size() != entry.tileOffsets.back()) {
+		return false;
+	}
+	for (int tileNo = 0; tileNo < 256; ++tileNo) {
+		if (entry.tileOffsets[tileNo] > entry.tileOffsets[tileNo + 1]) { return false; }
+	}
+	for (uint16_t position : entry.positions) {
+		if (not bounds.contains(QPoint(position & 0xff, position >> 8))) { return false; }
+	}
+	return true;
+}
+
+
+void MapIndex::rebuildPostings() {
+	for (std::vector<int> &maps : _tileMaps) { maps.clear(); }
+	for (std::vector<int> &maps : _unitMaps) { maps.clear(); }
+	for (size_t entryNo = 0; entryNo < _entries.size(); ++entryNo) {
+		const Entry &entry = _entries[entryNo];
+		for (int tileNo = 0; tileNo < 256; ++tileNo) {
+			if (entry.tileOffsets[tileNo] != entry.tileOffsets[tileNo + 1]) {
+				_tileMaps[tileNo].push_back(entryNo);
+			}
+		}
+		bool seen[256] = {};
+		for (const MapObject &object : entry.objects) {
+			const MapObject::unitType_t unitType = MapObject::unitType_t(object.unitType);
+			if (object.unitType != MapObject::UnitType::None and not seen[unitType]) {
+				seen[unitType] = true;
+				_unitMaps[unitType].push_back(entryNo);
+			}
+		}
+	}
+}
+
+
+QString MapIndex::absolutePath(const Entry &entry) const {
+	return QDir(_directory).filePath(entry.fileName);
+}
@@ -0,0 +1,84 @@
+#ifndef MAPINDEX_H
+#define MAPINDEX_H
+
+#include <QPoint>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <cstdint>
+#include <vector>
+#include "mapobject.h"
+
+
+class MapIndex {
+public:
+	/** Which objects to look for. Attributes set to -1 match any value. */
+	struct ObjectQuery {
+		MapObject::UnitType unitType = MapObject::UnitType::None;
+		int a = -1;
+		int b = -1;
+		int c = -1;
+		int d = -1;
+		
+		bool matches(const MapObject &object) const;
+	};
+	
+	struct TileHit {
+		QString path;
+		std::vector<QPoint> positions;
+	};
+	
+	struct ObjectHit {
+		QString path;
+		std::vector<MapObject::id_t> objectIds;
+	};
+	
+	struct UpdateResult {
+		int scanned = 0;
+		int unchanged = 0;
+		int removed = 0;
+		QStringList errors;
+	};
+	
+	explicit MapIndex(const QString &directory);
+	
+	const QString &directory() const;
+	QString indexPath() const;
+	int mapCount() const;
+	
+	QString load();
+	QString save() const;
+	UpdateResult update();
+	
+	std::vector<TileHit> findTile(uint8_t tileNo) const;
+	std::vector<ObjectHit> findObjects(const ObjectQuery &query) const;
+	
+	static const QStringList &nameFilters();
+	
+private:
+	struct Entry {
+		QString fileName;
+		qint64 modified = 0;
+		qint64 size = 0;
+		std::vector<uint16_t> tileOffsets; ///< where each tile's positions begin, 257 entries
+		std::vector<uint16_t> positions;   ///< x | y << 8, grouped by tile number
+		std::vector<MapObject> objects;
+	};
+	
+	struct ScanResult {
+		Entry entry;
+		QString error;
+	};
+	
+	static ScanResult scan(const QString &path);
+	static bool isValid(const Entry &entry, const QRect &bounds);
+	void rebuildPostings();
+	QString absolutePath(const Entry &entry) const;
+	
+	QString _directory;
+	std::vector<Entry> _entries;
+	std::vector<int> _tileMaps[256]; ///< entries using each tile number
+	std::vector<int> _unitMaps[256]; ///< entries containing each unit type
+};
+
+#endif // MAPINDEX_H
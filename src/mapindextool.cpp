@@ -0,0 +1,133 @@
+#include "mapindextool.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <cstdio>
+
+
+/** @class MapIndexTool
+ * Queries a directory of maps from the command line:
+ *
+ *     PetsciiRobotsMapEditor --index DIR [--tile N] [--unit TYPE [--a N] [--b N] [--c N] [--d N]]
+ *
+ * The MapIndex of `DIR` is brought up to date and saved first. With `--tile`,
+ * the maps using that tile are listed along with the positions where they use
+ * it. With `--unit`, the maps containing objects of that type are listed
+ * along with the object ids; `--a` to `--d` restrict the objects to those
+ * with the given attributes. Numbers can be given in decimal or, prefixed
+ * with `0x`, in hexadecimal. Unit types can be given by number or by name.
+ *
+ * The exit code is 0 if the query found something, 1 if it didn't, and 2 on
+ * errors.
+ */
+
+
+static bool parseNumber(const QString &text, int max, int *value) {
+	bool ok;
+	*value = text.toInt(&ok, 0);
+	return ok and 0 <= *value and *value <= max;
+}
+
+
+/** Run the tool with the command line \a arguments. Returns the exit code. */
+int MapIndexTool::run(const QStringList &arguments) {
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Index a directory of PETSCII Robots maps and query it.");
+	parser.addHelpOption();
+	const QCommandLineOption indexOption("index", "Index the maps in <dir> and exit.", "dir");
+	const QCommandLineOption tileOption("tile", "List the maps using tile <no>.", "no");
+	const QCommandLineOption unitOption("unit", "List the maps with objects of <type>.", "type");
+	const QCommandLineOption aOption("a", "Only objects with attribute A set to <value>.", "value");
+	const QCommandLineOption bOption("b", "Only objects with attribute B set to <value>.", "value");
+	const QCommandLineOption cOption("c", "Only objects with attribute C set to <value>.", "value");
+	const QCommandLineOption dOption("d", "Only objects with attribute D set to <value>.", "value");
+	parser.addOptions({ indexOption, tileOption, unitOption, aOption, bOption, cOption, dOption });
+	parser.process(arguments);
+	
+	QTextStream out(stdout);
+	QTextStream err(stderr);
+	
+	int tileNo = -1;
+	if (parser.isSet(tileOption) and not parseNumber(parser.value(tileOption), 255, &tileNo)) {
+		err << "invalid tile number: " << parser.value(tileOption) << '\n';
+		return 2;
+	}
+	MapIndex::ObjectQuery query;
+	if (parser.isSet(unitOption) and not parseUnitType(parser.value(unitOption), &query.unitType)) {
+		err << "invalid unit type: " << parser.value(unitOption) << '\n';
+		return 2;
+	}
+	const std::pair<const QCommandLineOption*, int*> attributes[] = {
+	    { &aOption, &query.a }, { &bOption, &query.b }, { &cOption, &query.c }, { &dOption, &query.d }
+	};
+	for (const auto &attribute : attributes) {
+		if (parser.isSet(*attribute.first)
+		        and not parseNumber(parser.value(*attribute.first), 255, attribute.second)) {
+			err << "invalid attribute value: " << parser.value(*attribute.first) << '\n';
+			return 2;
+		}
+	}
+	
+	QElapsedTimer timer;
+	timer.start();
+	MapIndex index(parser.value(indexOption));
+	QString error = index.load();
+	if (not error.isNull()) {
+		err << "ignoring the old index: " << error << '\n';
+	}
+	const MapIndex::UpdateResult update = index.update();
+	for (const QString &message : update.errors) {
+		err << message << '\n';
+	}
+	error = index.save();
+	if (not error.isNull()) {
+		err << "could not save the index: " << error << '\n';
+	}
+	err << index.mapCount() << " maps indexed, " << update.scanned << " scanned, " << update.unchanged
+	    << " unchanged, " << update.removed << " removed, in " << timer.elapsed() << " ms" << '\n';
+	
+	if (tileNo < 0 and query.unitType == MapObject::UnitType::None) { return 0; }
+	
+	int hitCount = 0;
+	timer.restart();
+	if (tileNo >= 0) {
+		const std::vector<MapIndex::TileHit> hits = index.findTile(tileNo);
+		for (const MapIndex::TileHit &hit : hits) {
+			out << hit.path << ":";
+			for (const QPoint &position : hit.positions) {
+				out << " " << position.x() << "," << position.y();
+			}
+			out << '\n';
+		}
+		hitCount += hits.size();
+	}
+	if (query.unitType != MapObject::UnitType::None) {
+		const std::vector<MapIndex::ObjectHit> hits = index.findObjects(query);
+		for (const MapIndex::ObjectHit &hit : hits) {
+			out << hit.path << ": objects";
+			for (MapObject::id_t id : hit.objectIds) { out << " " << id; }
+			out << '\n';
+		}
+		hitCount += hits.size();
+	}
+	err << hitCount << " maps found in " << timer.nsecsElapsed() / 1000 << " us" << '\n';
+	
+	return hitCount > 0 ? 0 : 1;
+}
+
+
+/** Parses a unit type given either by number or by name, as returned by
+ * MapObject::toString().
+ */
+bool MapIndexTool::parseUnitType(const QString &text, MapObject::UnitType *unitType) {
+	int number;
+	for (MapObject::UnitType candidate : MapObject::unitTypes()) {
+		if (candidate == MapObject::UnitType::None) { continue; }
+		if (text.compare(MapObject::toString(candidate), Qt::CaseInsensitive) == 0
+		        or (parseNumber(text, 255, &number) and number == int(candidate))) {
+			*unitType = candidate;
+			return true;
+		}
+	}
+	return false;
+}
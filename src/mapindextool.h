@@ -0,0 +1,16 @@
+#ifndef MAPINDEXTOOL_H
+#define MAPINDEXTOOL_H
+
+#include <QString>
+#include <QStringList>
+#include "mapindex.h"
+
+
+class MapIndexTool {
+public:
+	static int run(const QStringList &arguments);
+	
+	static bool parseUnitType(const QString &text, MapObject::UnitType *unitType);
+};
+
+#endif // MAPINDEXTOOL_H
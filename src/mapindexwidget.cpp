@@ -0,0 +1,171 @@
+#include "mapindexwidget.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QSettings>
+#include <QTreeWidgetItem>
+#include "mapindex.h"
+#include "mapindextool.h"
+
+
+/** @class MapIndexWidget
+ * Searches all maps in a directory for a tile or for objects, using a
+ * MapIndex. Activating a result opens the map.
+ */
+
+
+static constexpr char SETTINGS_INDEX_DIRECTORY[] = "General/IndexDirectory";
+static constexpr int ROLE_PATH = Qt::UserRole;
+static constexpr int ROLE_OBJECT_ID = Qt::UserRole + 1;
+
+
+MapIndexWidget::MapIndexWidget(QWidget *parent) : QWidget(parent) {
+	_ui.setupUi(this);
+	_ui.editDirectory->setText(QSettings().value(SETTINGS_INDEX_DIRECTORY).toString());
+	onKindChanged();
+	
+	connect(_ui.editDirectory, &QLineEdit::textChanged, this, &MapIndexWidget::onDirectoryChanged);
+	connect(_ui.buttonBrowse, &QToolButton::clicked, this, &MapIndexWidget::onBrowse);
+	connect(_ui.buttonUpdate, &QPushButton::clicked, this, &MapIndexWidget::updateIndex);
+	connect(_ui.buttonSearch, &QPushButton::clicked, this, &MapIndexWidget::search);
+	connect(_ui.editQuery, &QLineEdit::returnPressed, this, &MapIndexWidget::search);
+	connect(_ui.comboKind, QOverload<int>::of(&QComboBox::currentIndexChanged),
+	        this, &MapIndexWidget::onKindChanged);
+	connect(_ui.treeResults, &QTreeWidget::itemActivated, this, &MapIndexWidget::onItemActivated);
+}
+
+
+MapIndexWidget::~MapIndexWidget() {}
+
+
+void MapIndexWidget::onBrowse() {
+	const QString directory = QFileDialog::getExistingDirectory(this, "Map Directory",
+	                                                            _ui.editDirectory->text());
+	if (not directory.isEmpty()) {
+		_ui.editDirectory->setText(directory);
+		updateIndex();
+	}
+}
+
+
+/** Drops the index of the previous directory, so the next search opens the
+ * index of the new one.
+ */
+void MapIndexWidget::onDirectoryChanged() {
+	_index.reset();
+}
+
+
+void MapIndexWidget::onKindChanged() {
+	_ui.editQuery->setPlaceholderText(_ui.comboKind->currentIndex() == 0 ? "tile number, e.g. 0x49"
+	                                                                     : "unit type, e.g. door a=1 c=2");
+}
+
+
+void MapIndexWidget::onItemActivated(QTreeWidgetItem *item) {
+	const QString path = item->data(0, ROLE_PATH).toString();
+	if (not path.isEmpty()) {
+		emit openMapRequested(path, item->data(0, ROLE_OBJECT_ID).toInt());
+	}
+}
+
+
+/** Runs the query in the query field, and lists the maps found. */
+void MapIndexWidget::search() {
+	_ui.treeResults->clear();
+	if (not _index and not openIndex()) { return; }
+	
+	const QString text = _ui.editQuery->text().trimmed();
+	QElapsedTimer timer;
+	timer.start();
+	int hitCount = 0;
+	if (_ui.comboKind->currentIndex() == 0) {
+		bool ok;
+		const int tileNo = text.toInt(&ok, 0);
+		if (not ok or tileNo < 0 or tileNo > 255) {
+			_ui.labelStatus->setText("Please enter a tile number from 0 to 255, or 0x00 to 0xff.");
+			return;
+		}
+		for (const MapIndex::TileHit &hit : _index->findTile(tileNo)) {
+			QTreeWidgetItem *item = new QTreeWidgetItem(_ui.treeResults);
+			item->setText(0, QFileInfo(hit.path).fileName());
+			item->setText(1, QString("%1× (first at %2, %3)").arg(hit.positions.size())
+			              .arg(hit.positions.front().x()).arg(hit.positions.front().y()));
+			item->setData(0, ROLE_PATH, hit.path);
+			item->setData(0, ROLE_OBJECT_ID, int(MapObject::IdNone));
+			++hitCount;
+		}
+	} else {
+		// attribute filters look like "a=1", everything else is the unit type's name
+		MapIndex::ObjectQuery query;
+		QStringList typeWords;
+		for (const QString &word : text.split(' ')) {
+			if (word.isEmpty()) { continue; }
+			const QStringList parts = word.split('=');
+			int *attribute = nullptr;
+			if (parts.size() == 2 and parts[0].size() == 1 and QString("abcd").contains(parts[0])) {
+				const int i = QString("abcd").indexOf(parts[0]);
+				attribute = i == 0 ? &query.a : i == 1 ? &query.b : i == 2 ? &query.c : &query.d;
+			}
+			bool ok = false;
+			if (attribute) { *attribute = parts[1].toInt(&ok, 0); }
+			if (not ok) { typeWords.append(word); }
+		}
+		if (not MapIndexTool::parseUnitType(typeWords.join(' '), &query.unitType)) {
+			_ui.labelStatus->setText(QString("Unknown unit type \"%1\".").arg(typeWords.join(' ')));
+			return;
+		}
+		for (const MapIndex::ObjectHit &hit : _index->findObjects(query)) {
+			QTreeWidgetItem *item = new QTreeWidgetItem(_ui.treeResults);
+			item->setText(0, QFileInfo(hit.path).fileName());
+			item->setText(1, QString("%1 object(s)").arg(hit.objectIds.size()));
+			item->setData(0, ROLE_PATH, hit.path);
+			item->setData(0, ROLE_OBJECT_ID, int(MapObject::IdNone));
+			for (MapObject::id_t id : hit.objectIds) {
+				QTreeWidgetItem *child = new QTreeWidgetItem(item);
+				child->setText(1, QString("object %1").arg(id));
+				child->setData(0, ROLE_PATH, hit.path);
+				child->setData(0, ROLE_OBJECT_ID, id);
+			}
+			++hitCount;
+		}
+	}
+	_ui.labelStatus->setText(QString("%1 of %2 maps match (%3 µs).").arg(hitCount).arg(_index->mapCount())
+	                         .arg(timer.nsecsElapsed() / 1000));
+}
+
+
+/** Brings the index of the chosen directory up to date. */
+void MapIndexWidget::updateIndex() {
+	_index.reset();
+	openIndex();
+}
+
+
+bool MapIndexWidget::openIndex() {
+	const QString directory = _ui.editDirectory->text();
+	if (directory.isEmpty() or not QFileInfo(directory).isDir()) {
+		_ui.labelStatus->setText("Please choose a directory with maps first.");
+		return false;
+	}
+	QSettings().setValue(SETTINGS_INDEX_DIRECTORY, directory);
+	
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	_index = std::make_unique<MapIndex>(directory);
+	_index->load(); // a missing or outdated index is simply rebuilt
+	const MapIndex::UpdateResult result = _index->update();
+	const QString error = _index->save();
+	QApplication::restoreOverrideCursor();
+	
+	QString status = QString("%1 maps indexed, %2 scanned.").arg(_index->mapCount()).arg(result.scanned);
+	if (not result.errors.isEmpty()) {
+		status += QString(" %1 could not be loaded.").arg(result.errors.size());
+		_ui.labelStatus->setToolTip(result.errors.join('\n'));
+	} else {
+		_ui.labelStatus->setToolTip(QString());
+	}
+	if (not error.isNull()) { status += " The index could not be saved: " + error; }
+	_ui.labelStatus->setText(status);
+	return true;
+}
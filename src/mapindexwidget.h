@@ -0,0 +1,37 @@
+#ifndef MAPINDEXWIDGET_H
+#define MAPINDEXWIDGET_H
+
+#include "ui_mapindexwidget.h"
+#include <QWidget>
+#include <memory>
+#include "mapobject.h"
+
+class MapIndex;
+class QTreeWidgetItem;
+
+
+class MapIndexWidget : public QWidget {
+	Q_OBJECT
+public:
+	explicit MapIndexWidget(QWidget *parent = nullptr);
+	virtual ~MapIndexWidget();
+	
+signals:
+	void openMapRequested(const QString &path, MapObject::id_t objectId);
+	
+private slots:
+	void onBrowse();
+	void onDirectoryChanged();
+	void onKindChanged();
+	void onItemActivated(QTreeWidgetItem *item);
+	void search();
+	void updateIndex();
+	
+private:
+	bool openIndex();
+	
+	Ui::MapIndexWidget _ui;
+	std::unique_ptr<MapIndex> _index;
+};
+
+#endif // MAPINDEXWIDGET_H
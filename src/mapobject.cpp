@@ -44,6 +44,12 @@ MapObject::MapObject(UnitType unitType)
 }
 
 
+bool MapObject::operator==(const MapObject &other) const {
+	return unitType == other.unitType and x == other.x and y == other.y and a == other.a and b == other.b
+	        and c == other.c and d == other.d and health == other.health;
+}
+
+
 MapObject::Group MapObject::group() const {
 	return group(unitType);
 }
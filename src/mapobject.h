@@ -40,6 +40,9 @@ public:
 	uint8_t d;
 	uint8_t health;
 	
+	bool operator==(const MapObject &other) const;
+	bool operator!=(const MapObject &other) const { return not (*this == other); }
+	
 	Group group() const;
 	QPoint pos() const;
 	static Group group(UnitType unitType);
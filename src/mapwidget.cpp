@@ -1,24 +1,38 @@
 #include "mapwidget.h"
+#include <QFontMetrics>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QPolygonF>
 #include <QSize>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
 #include "constants.h"
+#include "gamesimulator.h"
+#include "lineofsight.h"
 #include "map.h"
+#include "mapdiff.h"
+#include "reachability.h"
 #include "tile.h"
 #include "tileset.h"
+#include "trace.h"
+
+
+static constexpr int OVERLAY_UPDATE_INTERVAL = 40; // ms
 
 
 MapWidget::MapWidget(QWidget *parent) : AbstractTileWidget(parent) {
 	setMouseTracking(true);
 	
-	_tilesImage = new QImage(imageSize(), IMAGE_FORMAT);
+	connect(&_compositor, &MapCompositor::finished, this, [this]() { update(); });
+	_overlayUpdateTimer.setSingleShot(true);
+	_overlayUpdateTimer.setInterval(OVERLAY_UPDATE_INTERVAL);
+	connect(&_overlayUpdateTimer, &QTimer::timeout, this, &MapWidget::onOverlayUpdateTimeout);
 }
 
 
-MapWidget::~MapWidget() {
-	delete _tilesImage;
-}
+MapWidget::~MapWidget() {}
 
 
 void MapWidget::setDragMode(MapWidget::DragMode dragMode) {
@@ -28,16 +42,24 @@ void MapWidget::setDragMode(MapWidget::DragMode dragMode) {
 
 void MapWidget::setMap(const Map *map) {
 	disconnect(_map);
+	onMapReplaced();
 	_map = map;
+	connect(_map, &Map::replaced, this, &MapWidget::onMapReplaced);
 	connect(_map, &Map::tilesChanged, this, &MapWidget::onMapTilesChanged);
-	connect(_map, &Map::objectsChanged, this,
-	        static_cast<void(MapWidget::*)()>(&MapWidget::update));
+	connect(_map, &Map::objectsChanged, this, &MapWidget::onMapObjectsChanged);
 	_redrawTiles = true;
+	_redrawReachability = true;
+	_redrawSimulation = true;
+	_updateDangerZones = true;
+	_redrawDiff = true;
 	update();
 }
 
 
 QRect MapWidget::selectedArea() const {
+	if (hasFloatingSelection()) {
+		return floatingRect() & _map->rect();
+	}
 	if (_dragAreaBegin.x() >= 0) {
 		return QRect(QPoint(qMin(_dragAreaBegin.x(), _dragAreaEnd.x()),
 		                    qMin(_dragAreaBegin.y(), _dragAreaEnd.y())),
@@ -48,6 +70,85 @@ QRect MapWidget::selectedArea() const {
 }
 
 
+/// @{
+/** The floating selection is an area of tiles and objects that hovers
+ * above the map and can be dragged around with the mouse. It's either
+ * created through #setFloatingSelection(), for example to preview pasting,
+ * or by dragging the selected area, which lifts it off the map.
+ * 
+ * The floating selection isn't part of the map until it is dropped. The
+ * widget emits #floatingSelectionDropped() when the user clicks outside
+ * of it; the receiver should apply it to the map and then call
+ * #clearFloatingSelection().
+ */
+bool MapWidget::hasFloatingSelection() const {
+	return not _floating.isNull();
+}
+
+
+const MapClipboard &MapWidget::floatingSelection() const {
+	return _floating;
+}
+
+
+/** The map position of the floating selection's top left corner. It may lie
+ * outside the map if the selection has been dragged over the map border.
+ */
+QPoint MapWidget::floatingSelectionPosition() const {
+	return _floatingPosition;
+}
+
+
+/** The area the floating selection was lifted from, or a null rect if it
+ * wasn't lifted from the map.
+ */
+QRect MapWidget::floatingSelectionSource() const {
+	return _floatingSource;
+}
+
+
+/** Whether the objects in #floatingSelectionSource() were lifted along with
+ * the tiles.
+ */
+bool MapWidget::floatingSelectionMovesObjects() const {
+	return _floatingMovesObjects;
+}
+
+
+void MapWidget::setFloatingSelection(const MapClipboard &clipboard, const QPoint &position) {
+	setDragMode(DragMode::Area);
+	_floating = clipboard;
+	_floatingPosition = position;
+	_floatingSource = QRect();
+	_floatingMovesObjects = false;
+	makeFloatingImages();
+	update();
+}
+
+
+/** Remove the floating selection. The area where it was becomes the
+ * selected area.
+ */
+void MapWidget::clearFloatingSelection() {
+	if (not hasFloatingSelection()) { return; }
+	const QRect r = floatingRect() & _map->rect();
+	if (r.isEmpty()) {
+		_dragAreaBegin = _dragAreaEnd = QPoint(-1, -1);
+	} else {
+		_dragAreaBegin = r.topLeft();
+		_dragAreaEnd = r.bottomRight();
+	}
+	_floating = MapClipboard();
+	_floatingSource = QRect();
+	_floatingMovesObjects = false;
+	_floatingImage = QImage();
+	_floatingHoleImage = QImage();
+	_draggingFloating = false;
+	update();
+}
+/// @}
+
+
 void MapWidget::clearSelection() {
 	_dragAreaBegin = _dragAreaEnd = QPoint(-1, -1);
 	update();
@@ -98,6 +199,75 @@ void MapWidget::setObjectsVisible(bool visible) {
 }
 
 
+/** Whether to shade the map according to how far each tile is from the
+ * player spawn point. Tiles the player can't reach are darkened.
+ */
+void MapWidget::setShowReachability(bool enable) {
+	if (_showReachability != enable) {
+		_showReachability = enable;
+		_redrawReachability = true;
+		update();
+	}
+}
+
+
+/** Whether to show where robots and water rafts go. The map is shaded by how
+ * often robots pass each tile, and the path of the selected object is drawn.
+ */
+void MapWidget::setShowSimulation(bool enable) {
+	if (_showSimulation != enable) {
+		_showSimulation = enable;
+		_redrawSimulation = true;
+		update();
+	}
+}
+
+
+/** Whether to shade the tiles that robots can see along their row and
+ * column. Tiles seen by attack hoverbots or evilbots are shaded stronger.
+ */
+void MapWidget::setShowDangerZones(bool enable) {
+	if (_showDangerZones != enable) {
+		_showDangerZones = enable;
+		_updateDangerZones = true;
+		update();
+	}
+}
+
+
+/** Outlines the areas of size \a size at the top left corners \a matches.
+ * Pass an empty vector to remove the outlines.
+ */
+void MapWidget::setPatternMatches(const std::vector<QPoint> &matches, const QSize &size) {
+	_patternMatches = matches;
+	_patternSize = size;
+	update();
+}
+
+
+/** Shows the differences between \a map and the edited map: changed tiles
+ * are tinted, and added, removed and modified objects are outlined. Pass
+ * \c nullptr to stop comparing. \a map must outlive the comparison.
+ */
+void MapWidget::setCompareMap(const Map *map) {
+	_compareMap = map;
+	_redrawDiff = true;
+	_diff.reset();
+	update();
+}
+
+
+/** Outlines every occurrence of \a tileNo on the map, or none if \a tileNo
+ * is -1.
+ */
+void MapWidget::setMarkedTile(int tileNo) {
+	if (_markedTile != tileNo) {
+		_markedTile = tileNo;
+		update();
+	}
+}
+
+
 void MapWidget::clickEveryTile() {
 	for (int y = 0; y < _map->height(); ++y) {
 		for (int x = 0; x < _map->width(); ++x) {
@@ -106,12 +276,9 @@ void MapWidget::clickEveryTile() {
 
 			if (not _objectsVisible) { continue; }
 			
-			for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
-				const MapObject &object = _map->object(id);
-				if (object.unitType != MapObject::UnitType::None and object.pos() == pos) {
-					emit objectClicked(id);
-					break;
-				}
+			const MapObject::id_t id = _map->objectIndex().objectAt(pos);
+			if (id != MapObject::IdNone) {
+				emit objectClicked(id);
 			}
 			
 			emit objectClicked(MapObject::IdNone);
@@ -121,19 +288,81 @@ void MapWidget::clickEveryTile() {
 
 
 void MapWidget::paintEvent(QPaintEvent *event) {
+	TRACE_SCOPE("MapWidget::paintEvent");
 	Q_UNUSED(event);
+	if (drawPlaceholder()) { return; }
+	TRACE_COUNTER("MapWidget::tilesRedrawn", _redrawTiles ? _map->width() * _map->height() : 0);
 	if (_redrawTiles) { makeTilesImage(); }
+	if (_compositor.image()->isNull()) { _compositor.waitForFinished(); }
 	
 	QPainter painter(this);
 	painter.scale(scale(), scale());
-	painter.drawImage(0, 0, *_tilesImage);
+	painter.drawImage(0, 0, *_compositor.image());
+	
+	if (hasFloatingSelection() and _floatingSource.isValid() and not _floatingHoleImage.isNull()) {
+		painter.drawImage(tileRect(_floatingSource.topLeft()).topLeft(), _floatingHoleImage);
+	}
+	
+	if (_showReachability) {
+		if (_redrawReachability) { makeReachabilityImage(); }
+		painter.drawImage(QRect(QPoint(0, 0), imageSize()), _reachabilityImage);
+	}
+	
+	if (_compareMap) {
+		if (_redrawDiff) { makeDiffImage(); }
+		painter.drawImage(QRect(QPoint(0, 0), imageSize()), _diffImage);
+	}
+	
+	if (_showDangerZones) {
+		if (not _lineOfSight) {
+			_lineOfSight = std::make_unique<LineOfSight>(*tileset());
+			_updateDangerZones = true;
+		}
+		if (_updateDangerZones) {
+			_lineOfSight->update(*_map);
+			_updateDangerZones = false;
+		}
+		painter.drawImage(QRect(QPoint(0, 0), imageSize()), _lineOfSight->image());
+	}
+	
+	if (_showSimulation) {
+		if (_redrawSimulation) { makeSimulationImage(); }
+		painter.drawImage(QRect(QPoint(0, 0), imageSize()), _simulationImage);
+		if (_selectedObject != MapObject::IdNone) {
+			const std::vector<QPoint> &trajectory = _simulation->trajectory(_selectedObject);
+			QPolygonF path;
+			for (const QPoint &position : trajectory) {
+				const QPointF center = QRectF(tileRect(position)).center();
+				if (path.isEmpty() or path.last() != center) { path.append(center); }
+			}
+			painter.setPen(QPen(C::colorTrajectory, 2));
+			painter.setBrush(Qt::NoBrush);
+			painter.drawPolyline(path);
+		}
+	}
 	
 	if (_objectsVisible) {
+		const bool hideLifted = hasFloatingSelection() and _floatingMovesObjects;
 		for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+			if (hideLifted and _floatingSource.contains(_map->object(id).pos())) { continue; }
 			drawMapObject(painter, id);
 		}
 	}
 	
+	if (hasFloatingSelection()) {
+		if (not _floatingImage.isNull()) {
+			painter.drawImage(tileRect(_floatingPosition).topLeft(), _floatingImage);
+		}
+		if (_objectsVisible) {
+			for (int i = 0; i < _floating.objectCount(); ++i) {
+				const MapObject object = _floating.object(i);
+				if (object.unitType == MapObject::UnitType::None) { continue; }
+				painter.drawImage(tileRect(object.pos() + _floatingPosition),
+				                  _objectImages.at(object.unitType));
+			}
+		}
+	}
+	
 	if (highlightAttribute() != Tile::None) {
 		for (int y = 0; y < _map->height(); ++y) {
 			for (int x = 0; x < _map->width(); ++x) {
@@ -164,7 +393,46 @@ void MapWidget::paintEvent(QPaintEvent *event) {
 		}
 	}
 	
-	if (_dragMode == DragMode::Area and _dragAreaBegin.x() >= 0) {
+	if (_markedTile >= 0) {
+		painter.setPen(QPen(C::colorMarkedTile, 2));
+		painter.setBrush(Qt::NoBrush);
+		for (const QPoint &position : _map->tileIndex().positions(_markedTile)) {
+			painter.drawRect(QRectF(position.x() * tileSize.width() + 1, position.y() * tileSize.height() + 1,
+			                        tileSize.width() - 2, tileSize.height() - 2));
+		}
+	}
+	
+	if (_diff) {
+		painter.setBrush(Qt::NoBrush);
+		for (const MapDiff::ObjectDelta &delta : _diff->objectDeltas()) {
+			const QColor &color = delta.change == MapDiff::ObjectChange::Added ? C::colorDiffAdded
+			        : delta.change == MapDiff::ObjectChange::Removed ? C::colorDiffRemoved : C::colorDiffModified;
+			const QPoint position = delta.change == MapDiff::ObjectChange::Removed ? delta.before.pos()
+			                                                                        : delta.after.pos();
+			painter.setPen(QPen(color, 2, Qt::DotLine));
+			painter.drawRect(QRectF(position.x() * tileSize.width() + 1, position.y() * tileSize.height() + 1,
+			                        tileSize.width() - 2, tileSize.height() - 2));
+		}
+	}
+	
+	if (not _patternMatches.empty()) {
+		painter.setPen(QPen(C::colorPatternMatch, 2));
+		painter.setBrush(Qt::NoBrush);
+		for (const QPoint &match : _patternMatches) {
+			painter.drawRect(QRectF(match.x() * tileSize.width() + 1, match.y() * tileSize.height() + 1,
+			                        _patternSize.width() * tileSize.width() - 2,
+			                        _patternSize.height() * tileSize.height() - 2));
+		}
+	}
+	
+	if (hasFloatingSelection()) {
+		const QRect r = floatingRect();
+		QPen pen(C::colorAreaSelection, 2, Qt::DashLine);
+		painter.setPen(pen);
+		painter.setBrush(Qt::NoBrush);
+		painter.drawRect(QRectF(r.left() * tileSize.width(), r.top() * tileSize.height(),
+		                        r.width() * tileSize.width() - 1, r.height() * tileSize.height() - 1));
+	} else if (_dragMode == DragMode::Area and _dragAreaBegin.x() >= 0) {
 		painter.setPen(QPen(C::colorAreaSelection, 2));
 		QColor fillColor(C::colorAreaSelection);
 		fillColor.setAlpha(50);
@@ -175,7 +443,22 @@ void MapWidget::paintEvent(QPaintEvent *event) {
 		const double bottom = (qMax(_dragAreaBegin.y(), _dragAreaEnd.y()) + 1) * tileSize.height() - 1;
 		painter.drawRect(QRectF(QPointF(left, top), QPointF(right, bottom)));
 	}
+	
+#ifdef ENABLE_TRACING
+	if (_showPerformanceOverlay) { drawPerformanceOverlay(painter); }
+#endif
+}
+
+
+#ifdef ENABLE_TRACING
+/** Shows timings and counters recorded by Trace in the visible top left
+ * corner. Only available in builds with tracing.
+ */
+void MapWidget::setShowPerformanceOverlay(bool enable) {
+	_showPerformanceOverlay = enable;
+	update();
 }
+#endif
 
 
 QSize MapWidget::sizeHint() const {
@@ -197,8 +480,22 @@ void MapWidget::mouseMoveEvent(QMouseEvent *event) {
 		
 		switch (_dragMode) {
 		case DragMode::Area:
-			_dragAreaEnd = tilePos;
-			update();
+			if (_liftPending and tilePos != _liftPressPosition) {
+				liftSelection();
+				_liftPending = false;
+				_draggingFloating = true;
+				_floatingDragOffset = _liftPressPosition - _floatingPosition;
+			}
+			if (_draggingFloating) {
+				const QPoint position = tilePos - _floatingDragOffset;
+				if (position != _floatingPosition) {
+					_floatingPosition = position;
+					update();
+				}
+			} else if (not _liftPending) {
+				_dragAreaEnd = tilePos;
+				update();
+			}
 			break;
 		case DragMode::Single:
 			emit tileDragged(tilePos);
@@ -223,25 +520,29 @@ void MapWidget::mousePressEvent(QMouseEvent *event) {
 	const QPoint tilePos = pixelToTile(event->pos());
 	switch (_dragMode) {
 	case DragMode::Area:
+		if (hasFloatingSelection()) {
+			if (floatingRect().contains(tilePos)) {
+				_draggingFloating = true;
+				_floatingDragOffset = tilePos - _floatingPosition;
+				break;
+			}
+			emit floatingSelectionDropped();
+		} else if (selectedArea().contains(tilePos)) {
+			// dragging the selected area lifts it off the map, see mouseMoveEvent()
+			_liftPending = true;
+			_liftPressPosition = tilePos;
+			break;
+		}
 		_dragAreaBegin = tilePos;
 		_dragAreaEnd = tilePos;
 		update();
 		break;
 	case DragMode::Single:
 		if (_objectsVisible) {
-			bool foundObject = false;
-			for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
-				const MapObject &object = _map->object(id);
-				if (object.unitType != MapObject::UnitType::None and object.pos() == tilePos) {
-					emit objectClicked(id);
-					foundObject = true;
-					_dragObject = id;
-					break;
-				}
-			}
-			
-			if (not foundObject) {
-				emit objectClicked(MapObject::IdNone);
+			const MapObject::id_t id = _map->objectIndex().objectAt(tilePos);
+			emit objectClicked(id);
+			if (id != MapObject::IdNone) {
+				_dragObject = id;
 			}
 		}
 		
@@ -259,6 +560,13 @@ void MapWidget::mousePressEvent(QMouseEvent *event) {
 void MapWidget::mouseReleaseEvent(QMouseEvent *event) {
 	if (event->button() == Qt::LeftButton) {
 		event->accept();
+		if (_liftPending) {
+			// clicked without dragging, select just the clicked tile
+			_liftPending = false;
+			_dragAreaBegin = _dragAreaEnd = _liftPressPosition;
+			update();
+		}
+		_draggingFloating = false;
 		_dragObject = MapObject::IdNone;
 		emit released();
 	} else {
@@ -274,24 +582,107 @@ void MapWidget::scaleChanged() {
 
 void MapWidget::tilesetChanged() {
 	_redrawTiles = true;
+	_redrawReachability = true;
+	_redrawSimulation = true;
+	_lineOfSight.reset();
 	makeObjectImages();
+	makeFloatingImages();
 	update();
 }
 
 
+/** Only the map cells showing one of \a tileNos are redrawn. As tile
+ * attributes may have changed too, the overlays are recomputed.
+ */
+void MapWidget::tilesChanged(const std::vector<uint8_t> &tileNos) {
+	TRACE_SCOPE("MapWidget::tilesChanged");
+	if (_map == nullptr or tileset() == nullptr) { return; }
+	if (_compositor.isComposing()) {
+		// the composition in progress still uses the old tiles
+		_redrawTiles = true;
+	} else if (not _redrawTiles) {
+		int count = 0;
+		for (uint8_t tileNo : tileNos) {
+			for (const QPoint &position : _map->tileIndex().positions(tileNo)) {
+				drawTile(position);
+				++count;
+			}
+		}
+		TRACE_COUNTER("MapWidget::tilesRedrawn", count);
+	}
+	_redrawReachability = true;
+	_redrawSimulation = true;
+	_lineOfSight.reset();
+	makeObjectImages();
+	makeFloatingImages();
+	update();
+}
+
+
+/** Repaints right away, but recomputes the overlays that depend on the
+ * objects at most once per OVERLAY_UPDATE_INTERVAL, as they are expensive.
+ * The first change updates them right away, further ones within the
+ * interval once it has passed.
+ */
 void MapWidget::onMapObjectsChanged() {
-	if (_objectsVisible) {
+	// hidden overlays are still invalidated, so they are current once shown
+	if (_overlayUpdateTimer.isActive()) {
+		_overlayUpdatePending = true;
+	} else {
+		invalidateObjectOverlays();
+		_overlayUpdateTimer.start();
+	}
+	if (_objectsVisible or _showReachability or _showSimulation or _showDangerZones or _compareMap) {
 		update();
 	}
 }
 
 
+void MapWidget::onOverlayUpdateTimeout() {
+	if (_overlayUpdatePending) {
+		_overlayUpdatePending = false;
+		invalidateObjectOverlays();
+		update();
+		_overlayUpdateTimer.start();
+	}
+}
+
+
+void MapWidget::invalidateObjectOverlays() {
+	_redrawReachability = true;
+	_redrawSimulation = true;
+	_updateDangerZones = true;
+	_redrawDiff = true;
+}
+
+
+/** Drops the floating selection and the selected area, which belong to the
+ * previous map.
+ */
+void MapWidget::onMapReplaced() {
+	clearFloatingSelection();
+	_dragAreaBegin = _dragAreaEnd = QPoint(-1, -1);
+	_draggingFloating = false;
+	_liftPending = false;
+	update();
+}
+
+
 void MapWidget::onMapTilesChanged() {
 	_redrawTiles = true;
+	_redrawReachability = true;
+	_redrawSimulation = true;
+	_updateDangerZones = true;
+	_redrawDiff = true;
 	update();
 }
 
 
+QRect MapWidget::floatingRect() const {
+	return QRect(_floatingPosition, _floating.size());
+}
+
+
 QSize MapWidget::imageSize() const {
 	return QSize(_map->width() * tileset()->tileSize().width(),
 	             _map->height() * tileset()->tileSize().height());
@@ -401,31 +792,117 @@ void MapWidget::drawSpecialObject(QPainter &painter, const QRect &rect, MapObjec
 }
 
 
+/** Blocks until the tiles image shows the current map, which is otherwise
+ * drawn in the background and picked up by a later paint event.
+ */
+void MapWidget::waitForTilesImage() {
+	if (_redrawTiles) { makeTilesImage(); }
+	_compositor.waitForFinished();
+}
+
+
 void MapWidget::makeTilesImage() {
-	static constexpr int Bpp(4); // bytes per pixel
+	TRACE_SCOPE("MapWidget::makeTilesImage");
 	if (_map == nullptr or tileset() == nullptr) { return; }
-	QPainter painter(_tilesImage);
+	_compositor.compose(*_map, *tileset());
+	_redrawTiles = false;
+}
+
+
+/** Copies the image of the tile at \a position into the tiles image. */
+void MapWidget::drawTile(const QPoint &position) {
+	static constexpr int Bpp(4); // bytes per pixel
+	const QImage tileImage = tile(position).image();
+	const QRect r = tileRect(position);
+	QImage *tilesImage = _compositor.image();
+	if (tilesImage->isNull()) { return; }
+	uchar *dst = tilesImage->bits();
+	const uchar *src = tileImage.bits();
+	for (int py = 0; py < r.height(); ++py) {
+		memcpy(&dst[(r.top() + py) * tilesImage->bytesPerLine() + r.left() * Bpp],
+		       &src[py * tileImage.bytesPerLine()],
+		       tileImage.bytesPerLine());
+	}
+}
+
+
+#ifdef ENABLE_TRACING
+/** The paint times are those of the previous frames, as this one isn't
+ * finished yet.
+ */
+void MapWidget::drawPerformanceOverlay(QPainter &painter) {
+	const auto ms = [](qint64 ns) { return QString::number(ns / 1e6, 'f', 2); };
+	const Trace::Statistics paint = Trace::statistics("MapWidget::paintEvent");
+	const QStringList lines = {
+		QString("paint: %1 ms (avg %2, max %3)").arg(ms(paint.last), ms(paint.average), ms(paint.max)),
+		QString("tiles image: %1 ms").arg(ms(Trace::counterValue("MapCompositor::composeTime"))),
+		QString("tiles redrawn: %1").arg(Trace::counterValue("MapWidget::tilesRedrawn")),
+		QString("undo stack: %1 KiB").arg(Trace::counterValue("MapController::undoMemory") / 1024),
+	};
+	
+	const QFontMetrics metrics = painter.fontMetrics();
+	int width = 0;
+	for (const QString &line : lines) {
+		width = qMax(width, metrics.boundingRect(line).width());
+	}
+	const int margin = metrics.height() / 2;
+	const QRect rect(visibleRegion().boundingRect().topLeft() + QPoint(margin, margin),
+	                 QSize(width + 2 * margin, lines.size() * metrics.height() + 2 * margin));
 	painter.setPen(Qt::NoPen);
+	painter.setBrush(C::colorOverlayBackground);
+	painter.drawRect(rect);
+	painter.setPen(C::colorOverlayText);
+	for (int i = 0; i < lines.size(); ++i) {
+		painter.drawText(rect.left() + margin, rect.top() + margin + i * metrics.height() + metrics.ascent(),
+		                 lines[i]);
+	}
+}
+#endif
+
+
+void MapWidget::liftSelection() {
+	const QRect source = selectedArea();
+	_floating = MapClipboard::fromMap(*_map, source, true, _objectsVisible);
+	_floatingPosition = source.topLeft();
+	_floatingSource = source;
+	_floatingMovesObjects = _objectsVisible;
+	makeFloatingImages();
+	update();
+}
+
+
+/** Render the floating selection's tiles, and the empty tiles that are shown
+ * in its place if it has been lifted off the map. This is done once, so that
+ * dragging the floating selection only requires blitting these images.
+ */
+void MapWidget::makeFloatingImages() {
+	_floatingImage = QImage();
+	_floatingHoleImage = QImage();
+	if (not _floating.hasTiles() or tileset() == nullptr) { return; }
 	
-	uchar *dst = _tilesImage->bits();
-	for (int y = 0; y < _map->height(); ++y) {
-		for (int x = 0; x < _map->width(); ++x) {
-			const QPoint position(x, y);
-			const QImage &tileImage = tile(position).image();
-			const QRect r = tileRect(position);
-#if 1
-			const uchar *src = tileImage.bits();
-			for (int py = 0; py < r.height(); ++py) {
-				memcpy(&dst[(r.top() + py) * _tilesImage->bytesPerLine() + r.left() * Bpp],
-				       &src[py * tileImage.bytesPerLine()],
-				       tileImage.bytesPerLine());
+	const QSize ts = tileset()->tileSize();
+	const QSize size = _floating.size();
+	_floatingImage = QImage(size.width() * ts.width(), size.height() * ts.height(), IMAGE_FORMAT);
+	QPainter painter(&_floatingImage);
+	for (int y = 0; y < size.height(); ++y) {
+		for (int x = 0; x < size.width(); ++x) {
+			const uint8_t tileNo = _floating.tiles()[x + size.width() * y];
+			painter.drawImage(tileRect({x, y}), tileset()->tile(tileNo).image());
+		}
+	}
+	painter.end();
+	
+	if (_floatingSource.isValid()) {
+		_floatingHoleImage = QImage(_floatingSource.width() * ts.width(),
+		                            _floatingSource.height() * ts.height(), IMAGE_FORMAT);
+		QPainter holePainter(&_floatingHoleImage);
+		const QImage emptyTile = tileset()->tile(0).image();
+		for (int y = 0; y < _floatingSource.height(); ++y) {
+			for (int x = 0; x < _floatingSource.width(); ++x) {
+				holePainter.drawImage(tileRect({x, y}), emptyTile);
 			}
-#else
-			painter.drawImage(r, tileImage);
-#endif
 		}
 	}
-	_redrawTiles = false;
 }
 
 
@@ -442,6 +919,87 @@ void MapWidget::makeObjectImages() {
 }
 
 
+/** Render the reachability overlay with one pixel per tile. It is scaled up
+ * when painting.
+ */
+void MapWidget::makeReachabilityImage() {
+	_redrawReachability = false;
+	_reachabilityImage = QImage(_map->width(), _map->height(), IMAGE_FORMAT);
+	_reachabilityImage.fill(Qt::transparent);
+	
+	const MapObject &player = _map->object(MapObject::IdPlayer);
+	if (player.unitType != MapObject::UnitType::Player or tileset() == nullptr) { return; }
+	
+	Reachability reachability(*_map, *tileset());
+	reachability.compute(player.pos());
+	
+	const QRgb unreachable = qPremultiply(C::colorUnreachable.rgba());
+	const int maxDistance = qMax(1, reachability.maxDistance());
+	for (int y = 0; y < _map->height(); ++y) {
+		QRgb *line = reinterpret_cast<QRgb*>(_reachabilityImage.scanLine(y));
+		for (int x = 0; x < _map->width(); ++x) {
+			const int distance = reachability.distance({x, y});
+			if (distance == Reachability::Unreachable) {
+				line[x] = unreachable;
+			} else {
+				// from green close to the player to blue far away
+				const int hue = 120 + 120 * distance / maxDistance;
+				line[x] = qPremultiply(QColor::fromHsv(hue, 255, 255, 80).rgba());
+			}
+		}
+	}
+}
+
+
+/** Compare the map to the compare map, and tint the changed tiles with one
+ * pixel per tile.
+ */
+void MapWidget::makeDiffImage() {
+	_redrawDiff = false;
+	_diff = std::make_unique<MapDiff>(*_compareMap, *_map);
+	_diffImage = QImage(_map->width(), _map->height(), IMAGE_FORMAT);
+	_diffImage.fill(Qt::transparent);
+	const QRgb changed = qPremultiply(C::colorDiffTiles.rgba());
+	for (const QRect &rect : _diff->changedRects()) {
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			QRgb *line = reinterpret_cast<QRgb*>(_diffImage.scanLine(y));
+			std::fill(line + rect.left(), line + rect.right() + 1, changed);
+		}
+	}
+}
+
+
+/** Run the game simulation and render its heatmap with one pixel per tile.
+ * It is scaled up when painting.
+ */
+void MapWidget::makeSimulationImage() {
+	static constexpr int SIMULATION_TICKS = 2000;
+	
+	_redrawSimulation = false;
+	_simulation = std::make_unique<GameSimulator>(*_map, *tileset());
+	_simulation->setRecordTrajectories(true);
+	_simulation->run(SIMULATION_TICKS);
+	
+	_simulationImage = QImage(_map->width(), _map->height(), IMAGE_FORMAT);
+	const std::vector<uint32_t> &heatmap = _simulation->heatmap();
+	const double maxHeat = qMax(1u, _simulation->heatmapMax());
+	for (int y = 0; y < _map->height(); ++y) {
+		QRgb *line = reinterpret_cast<QRgb*>(_simulationImage.scanLine(y));
+		for (int x = 0; x < _map->width(); ++x) {
+			const uint32_t heat = heatmap[x + _map->width() * y];
+			if (heat == 0) {
+				line[x] = 0;
+			} else {
+				// rarely visited tiles should still be visible
+				QColor color = C::colorHeatmap;
+				color.setAlpha(60 + 160 * std::sqrt(heat / maxHeat));
+				line[x] = qPremultiply(color.rgba());
+			}
+		}
+	}
+}
+
+
 Tile MapWidget::tile(QPoint position) const {
 	const uint8_t tileNo = _map->tileNo(position);
 	return tileset()->tile(tileNo);
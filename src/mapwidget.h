@@ -4,12 +4,20 @@
 #include <QPoint>
 #include <QRect>
 #include <QSize>
+#include <QTimer>
 #include <QWidget>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include "abstracttilewidget.h"
+#include "mapclipboard.h"
+#include "mapcompositor.h"
 #include "mapobject.h"
 
+class GameSimulator;
+class LineOfSight;
 class Map;
+class MapDiff;
 class Tile;
 class Tileset;
 
@@ -27,12 +35,31 @@ public:
 	
 	QRect selectedArea() const;
 	
+	bool hasFloatingSelection() const;
+	const MapClipboard &floatingSelection() const;
+	QPoint floatingSelectionPosition() const;
+	QRect floatingSelectionSource() const;
+	bool floatingSelectionMovesObjects() const;
+	void setFloatingSelection(const MapClipboard &clipboard, const QPoint &position);
+	void clearFloatingSelection();
+	
+	void setPatternMatches(const std::vector<QPoint> &matches, const QSize &size);
+	void setCompareMap(const Map *map);
+	void waitForTilesImage();
+#ifdef ENABLE_TRACING
+	void setShowPerformanceOverlay(bool enable);
+#endif
+	
 public slots:
 	void clearSelection();	
 	void markObject(MapObject::id_t objectId);
 	void selectAll();
 	void setShowGridLines(bool enable);
 	void setObjectsVisible(bool visible);
+	void setShowReachability(bool enable);
+	void setShowSimulation(bool enable);
+	void setShowDangerZones(bool enable);
+	void setMarkedTile(int tileNo);
 	void clickEveryTile(); // TODO: remove
 	
 signals:
@@ -43,6 +70,7 @@ signals:
 	void mouseOverTile(const QPoint &tile);
 	void objectClicked(MapObject::id_t objectId);
 	void objectDragged(MapObject::id_t objectId, const QPoint &tile);
+	void floatingSelectionDropped();
 	
 protected:
 	void paintEvent(QPaintEvent *event) override;
@@ -54,33 +82,80 @@ protected:
 	void mouseReleaseEvent(QMouseEvent *event) override;
 	void scaleChanged() override;
 	void tilesetChanged() override;
+	void tilesChanged(const std::vector<uint8_t> &tileNos) override;
 	
 private slots:
 	void onMapObjectsChanged();
+	void onMapReplaced();
 	void onMapTilesChanged();
+	void onOverlayUpdateTimeout();
 	
 private:
+	void invalidateObjectOverlays();
 	void drawMapObject(QPainter &painter, MapObject::id_t objectId);
 	void drawObject(QPainter &painter, const QRect & rect, MapObject::UnitType unitType);
 	void drawSpecialObject(QPainter &painter, const QRect &rect, MapObject::UnitType unitType);
+#ifdef ENABLE_TRACING
+	void drawPerformanceOverlay(QPainter &painter);
+#endif
+	QRect floatingRect() const;
 	QSize imageSize() const;
+	void liftSelection();
+	void makeFloatingImages();
 	void makeTilesImage();
+	void drawTile(const QPoint &position);
 	void makeObjectImages();
+	void makeReachabilityImage();
+	void makeSimulationImage();
+	void makeDiffImage();
 	Tile tile(QPoint position) const;
 	QRect tileRect(const QPoint &position) const;
 	QPoint pixelToTile(QPoint pos);
 	
 	bool _objectsVisible = true;
 	const Map *_map = nullptr;
-	QImage *_tilesImage = nullptr;
+	MapCompositor _compositor;
 	std::unordered_map<MapObject::UnitType, QImage> _objectImages;
 	bool _redrawTiles = false;
 	bool _showGridLines = false;
+	bool _showReachability = false;
+	bool _redrawReachability = false;
+	QImage _reachabilityImage;
+	bool _showSimulation = false;
+	bool _redrawSimulation = false;
+	std::unique_ptr<GameSimulator> _simulation;
+	QImage _simulationImage;
+	bool _showDangerZones = false;
+	bool _updateDangerZones = false;
+	std::unique_ptr<LineOfSight> _lineOfSight;
+	int _markedTile = -1;
+	std::vector<QPoint> _patternMatches;
+	QSize _patternSize;
+	const Map *_compareMap = nullptr;
+	bool _redrawDiff = false;
+	QTimer _overlayUpdateTimer;
+	bool _overlayUpdatePending = false;
+	std::unique_ptr<MapDiff> _diff;
+	QImage _diffImage;
 	DragMode _dragMode = DragMode::Single;
 	MapObject::id_t _dragObject = MapObject::IdNone;
 	MapObject::id_t _selectedObject = MapObject::IdNone;
 	QPoint _dragAreaBegin = QPoint(-1, -1);
 	QPoint _dragAreaEnd;
+	
+	MapClipboard _floating;
+	QPoint _floatingPosition;
+	QRect _floatingSource;
+	bool _floatingMovesObjects = false;
+	QImage _floatingImage;
+	QImage _floatingHoleImage;
+	bool _draggingFloating = false;
+	QPoint _floatingDragOffset;
+	bool _liftPending = false;
+	QPoint _liftPressPosition;
+#ifdef ENABLE_TRACING
+	bool _showPerformanceOverlay = false;
+#endif
 };
 
 #endif // MAPWIDGET_H
@@ -151,8 +151,9 @@ void ObjectEditWidget::mapClickCancelled() {
 }
 
 
-void ObjectEditWidget::onObjectsChanged() {
-	if (_objectId != MapObject::IdNone) {
+/** Reloads the form if the shown object is among \a objectIds. */
+void ObjectEditWidget::onObjectsChanged(quint64 objectIds) {
+	if (_objectId != MapObject::IdNone and (objectIds >> _objectId) & 1) {
 		loadObject(_objectId);
 	}
 }
@@ -24,7 +24,7 @@ signals:
 	void mapClickRequested(const QString &label);
 	
 private slots:
-	void onObjectsChanged();
+	void onObjectsChanged(quint64 objectIds);
 	void onCoordinateMapClickRequested(const QString &label);
 	void store();
 	
@@ -0,0 +1,112 @@
+#include "objectindex.h"
+#include <QtAlgorithms>
+
+
+/** @class ObjectIndex
+ * Keeps track of which objects are on which tile of a map.
+ *
+ * For every map position there is a 64 bit mask with one bit per object id.
+ * Several objects can share a tile, e.g. an item hidden under a robot. Moving
+ * an object updates two masks, so the map can keep the index current on every
+ * modification, and finding the objects on a tile or in an area doesn't need
+ * a scan of all object slots. Empty slots, whose type is
+ * #MapObject::UnitType::None, and objects outside the map aren't indexed.
+ */
+
+
+ObjectIndex::ObjectIndex() {}
+
+
+/** Rebuild the index from the types and positions of the 64 objects on a
+ * map of size \a width × \a height, given as arrays indexed by object id.
+ */
+void ObjectIndex::reset(const uint8_t *unitTypes, const uint8_t *xs, const uint8_t *ys, int width, int height) {
+	_width = width;
+	_height = height;
+	_masks.assign(width * height, 0);
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		if (unitTypes[id] != 0 and xs[id] < width and ys[id] < height) {
+			_masks[xs[id] + width * ys[id]] |= uint64_t(1) << id;
+		}
+	}
+}
+
+
+/** Record that the object \a id changed from \a oldObject to \a newObject. */
+void ObjectIndex::change(MapObject::id_t id, const MapObject &oldObject, const MapObject &newObject) {
+	const uint64_t bit = uint64_t(1) << id;
+	if (isIndexed(oldObject)) {
+		Q_ASSERT(_masks[index(oldObject)] & bit);
+		_masks[index(oldObject)] &= ~bit;
+	}
+	if (isIndexed(newObject)) {
+		_masks[index(newObject)] |= bit;
+	}
+}
+
+
+/** The objects at \a position, with bit n set for object id n. */
+uint64_t ObjectIndex::mask(const QPoint &position) const {
+	if (position.x() < 0 or position.x() >= _width or position.y() < 0 or position.y() >= _height) {
+		return 0;
+	}
+	return _masks[position.x() + _width * position.y()];
+}
+
+
+/** The objects within \a rect, with bit n set for object id n. */
+uint64_t ObjectIndex::mask(const QRect &rect) const {
+	const QRect r = rect & QRect(0, 0, _width, _height);
+	uint64_t result = 0;
+	for (int y = r.top(); y <= r.bottom(); ++y) {
+		const uint64_t *row = &_masks[_width * y];
+		for (int x = r.left(); x <= r.right(); ++x) {
+			result |= row[x];
+		}
+	}
+	return result;
+}
+
+
+/** The object at \a position with the lowest id, or #MapObject::IdNone if
+ * there is none.
+ */
+MapObject::id_t ObjectIndex::objectAt(const QPoint &position) const {
+	const quint64 bits = mask(position);
+	return bits ? MapObject::id_t(qCountTrailingZeroBits(bits)) : MapObject::IdNone;
+}
+
+
+/** The ids of the objects at \a position, in ascending order. */
+std::vector<MapObject::id_t> ObjectIndex::objectsAt(const QPoint &position) const {
+	return ids(mask(position));
+}
+
+
+/** The ids of the objects within \a rect, in ascending order. */
+std::vector<MapObject::id_t> ObjectIndex::objectsIn(const QRect &rect) const {
+	return ids(mask(rect));
+}
+
+
+/** The ids whose bits are set in \a mask, in ascending order. */
+std::vector<MapObject::id_t> ObjectIndex::ids(uint64_t mask) {
+	std::vector<MapObject::id_t> result;
+	result.reserve(qPopulationCount(quint64(mask)));
+	quint64 bits = mask;
+	while (bits) {
+		result.push_back(qCountTrailingZeroBits(bits));
+		bits &= bits - 1;
+	}
+	return result;
+}
+
+
+bool ObjectIndex::isIndexed(const MapObject &object) const {
+	return object.unitType != MapObject::UnitType::None and object.x < _width and object.y < _height;
+}
+
+
+int ObjectIndex::index(const MapObject &object) const {
+	return object.x + _width * object.y;
+}
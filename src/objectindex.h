@@ -0,0 +1,35 @@
+#ifndef OBJECTINDEX_H
+#define OBJECTINDEX_H
+
+#include <QPoint>
+#include <QRect>
+#include <cstdint>
+#include <vector>
+#include "mapobject.h"
+
+
+class ObjectIndex {
+public:
+	ObjectIndex();
+	
+	void reset(const uint8_t *unitTypes, const uint8_t *xs, const uint8_t *ys, int width, int height);
+	void change(MapObject::id_t id, const MapObject &oldObject, const MapObject &newObject);
+	
+	uint64_t mask(const QPoint &position) const;
+	uint64_t mask(const QRect &rect) const;
+	MapObject::id_t objectAt(const QPoint &position) const;
+	std::vector<MapObject::id_t> objectsAt(const QPoint &position) const;
+	std::vector<MapObject::id_t> objectsIn(const QRect &rect) const;
+	
+	static std::vector<MapObject::id_t> ids(uint64_t mask);
+	
+private:
+	bool isIndexed(const MapObject &object) const;
+	int index(const MapObject &object) const;
+	
+	int _width = 0;
+	int _height = 0;
+	std::vector<uint64_t> _masks;
+};
+
+#endif // OBJECTINDEX_H
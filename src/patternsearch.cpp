@@ -0,0 +1,123 @@
+#include "patternsearch.h"
+#include <QRect>
+#include <cstring>
+
+
+/** @class PatternSearch
+ * Finds all occurrences of a rectangular tile pattern in a map, using a 2D
+ * Rabin–Karp rolling hash.
+ *
+ * First, each row of the map is hashed with a window as wide as the pattern,
+ * sliding the window one tile to the right at a time. Then those row hashes
+ * are hashed again in a window as high as the pattern, sliding down one row
+ * at a time. Both passes only add the entering and remove the leaving value,
+ * so every position's hash is known after a single pass over the map,
+ * independent of the pattern size. Hashes are computed modulo 2^64, and
+ * positions with a matching hash are compared tile by tile to rule out
+ * collisions.
+ */
+
+
+static constexpr uint64_t ROW_BASE = 257;
+static constexpr uint64_t COLUMN_BASE = 1000003;
+
+
+/** Prepare a search for the row by row buffer \a pattern of size \a size. */
+PatternSearch::PatternSearch(const uint8_t *pattern, const QSize &size)
+    : _pattern(pattern, pattern + size.width() * size.height()), _size(size) {
+	Q_ASSERT(not size.isEmpty());
+	for (int i = 1; i < size.width(); ++i) { _rowPower *= ROW_BASE; }
+	for (int i = 1; i < size.height(); ++i) { _columnPower *= COLUMN_BASE; }
+	
+	for (int y = 0; y < size.height(); ++y) {
+		uint64_t rowHash = 0;
+		for (int x = 0; x < size.width(); ++x) {
+			rowHash = rowHash * ROW_BASE + _pattern[x + size.width() * y];
+		}
+		_hash = _hash * COLUMN_BASE + rowHash;
+	}
+}
+
+
+const QSize &PatternSearch::size() const {
+	return _size;
+}
+
+
+/** Finds all occurrences of the pattern in the row by row buffer \a tiles of
+ * size \a width × \a height. Occurrences may overlap.
+ * @return the top left corners of the occurrences, in row order
+ */
+std::vector<QPoint> PatternSearch::find(const uint8_t *tiles, int width, int height) const {
+	std::vector<QPoint> matches;
+	const int pw = _size.width();
+	const int ph = _size.height();
+	if (pw > width or ph > height) { return matches; }
+	
+	// rowHashes[x + columns * y] is the hash of tiles (x, y) to (x + pw - 1, y)
+	const int columns = width - pw + 1;
+	std::vector<uint64_t> rowHashes(columns * height);
+	for (int y = 0; y < height; ++y) {
+		const uint8_t *row = &tiles[width * y];
+		uint64_t hash = 0;
+		for (int x = 0; x < pw; ++x) { hash = hash * ROW_BASE + row[x]; }
+		rowHashes[columns * y] = hash;
+		for (int x = 1; x < columns; ++x) {
+			hash = (hash - row[x - 1] * _rowPower) * ROW_BASE + row[x + pw - 1];
+			rowHashes[x + columns * y] = hash;
+		}
+	}
+	
+	// slide down each column of row hashes, keeping one window hash per column
+	std::vector<uint64_t> hashes(columns, 0);
+	for (int y = 0; y < ph; ++y) {
+		for (int x = 0; x < columns; ++x) {
+			hashes[x] = hashes[x] * COLUMN_BASE + rowHashes[x + columns * y];
+		}
+	}
+	for (int y = 0; ; ++y) {
+		for (int x = 0; x < columns; ++x) {
+			if (hashes[x] == _hash and matchesAt(tiles, width, x, y)) {
+				matches.push_back(QPoint(x, y));
+			}
+		}
+		if (y + ph >= height) { break; }
+		for (int x = 0; x < columns; ++x) {
+			hashes[x] = (hashes[x] - rowHashes[x + columns * y] * _columnPower) * COLUMN_BASE
+			        + rowHashes[x + columns * (y + ph)];
+		}
+	}
+	return matches;
+}
+
+
+/** Drops the matches that overlap an earlier match, so every tile is covered
+ * by at most one of the remaining ones. \a matches must be in row order, as
+ * returned by #find().
+ */
+std::vector<QPoint> PatternSearch::nonOverlapping(const std::vector<QPoint> &matches, const QSize &size) {
+	std::vector<QPoint> result;
+	for (const QPoint &match : matches) {
+		const QRect rect(match, size);
+		bool overlaps = false;
+		// earlier matches can only overlap if they start less than size.height() rows above
+		for (auto it = result.rbegin(); it != result.rend() and it->y() > match.y() - size.height(); ++it) {
+			if (rect.intersects(QRect(*it, size))) {
+				overlaps = true;
+				break;
+			}
+		}
+		if (not overlaps) { result.push_back(match); }
+	}
+	return result;
+}
+
+
+bool PatternSearch::matchesAt(const uint8_t *tiles, int width, int x, int y) const {
+	for (int py = 0; py < _size.height(); ++py) {
+		if (memcmp(&tiles[x + width * (y + py)], &_pattern[_size.width() * py], _size.width()) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,29 @@
+#ifndef PATTERNSEARCH_H
+#define PATTERNSEARCH_H
+
+#include <QPoint>
+#include <QSize>
+#include <cstdint>
+#include <vector>
+
+
+class PatternSearch {
+public:
+	PatternSearch(const uint8_t *pattern, const QSize &size);
+	
+	const QSize &size() const;
+	std::vector<QPoint> find(const uint8_t *tiles, int width, int height) const;
+	
+	static std::vector<QPoint> nonOverlapping(const std::vector<QPoint> &matches, const QSize &size);
+	
+private:
+	bool matchesAt(const uint8_t *tiles, int width, int x, int y) const;
+	
+	std::vector<uint8_t> _pattern;
+	QSize _size;
+	uint64_t _hash = 0;
+	uint64_t _rowPower = 1;
+	uint64_t _columnPower = 1;
+};
+
+#endif // PATTERNSEARCH_H
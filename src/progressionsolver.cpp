@@ -0,0 +1,361 @@
+#include "progressionsolver.h"
+#include <algorithm>
+#include "map.h"
+#include "reachability.h"
+
+
+/** @class ProgressionSolver
+ * Determines whether a level can be completed, i.e. whether the player can
+ * get from the spawn point to the level exit, taking locked doors and the keys
+ * needed to open them into account.
+ *
+ * Searching tile by tile for every combination of keys would be slow, so the
+ * map is first compressed into regions: connected areas of passable tiles
+ * (see Reachability) that contain no locked door. Regions are linked by
+ * edges:
+ *
+ * * locked doors connect the regions next to them, but can only be passed
+ *   with the matching key,
+ * * transporter pads with coordinates lead to the region of their
+ *   destination,
+ * * elevators connect the regions of all elevators.
+ *
+ * A key can be picked up from every region it's in or next to. As keys are
+ * never lost, entering a region always picks up all of its keys. The solver
+ * then does a breadth-first search over (region, keys held) states, of
+ * which there are only eight per region.
+ *
+ * Like Reachability, the result is optimistic in that it doesn't consider
+ * robots, hazards or transporter pads that are only activated once all robots
+ * are destroyed.
+ */
+
+
+/** Prepare solving the level in \a map. */
+ProgressionSolver::ProgressionSolver(const Map &map, const Tileset &tileset)
+    : _map(map), _width(map.width()), _height(map.height()), _passable(_width * _height),
+      _gate(_width * _height, -1), _region(_width * _height, NoRegion) {
+	const Reachability reachability(map, tileset);
+	const std::vector<Reachability::Row> &rows = reachability.passableRows();
+	for (int y = 0; y < _height; ++y) {
+		for (int x = 0; x < _width; ++x) {
+			const uint64_t bits = x < 64 ? rows[y].lo : rows[y].hi;
+			_passable[x + _width * y] = (bits >> (x % 64)) & 1;
+		}
+	}
+
+	makeRegions();
+	makeKeys();
+	makeEdges();
+}
+
+
+/** Search for a way from the player to the level exit. Returns whether one
+ * was found; the route is available from #steps() afterwards.
+ */
+bool ProgressionSolver::solve() {
+	_solvable = false;
+	_reachableKeys = 0;
+	_blockingLocks = 0;
+	_steps.clear();
+
+	const MapObject &player = _map.object(MapObject::IdPlayer);
+	if (player.unitType != MapObject::UnitType::Player) { return false; }
+	const uint16_t start = regionAt(player.pos());
+	if (start == NoRegion) { return false; }
+
+	std::vector<MapObject::id_t> exitIds(_regionCount, MapObject::IdNone);
+	for (MapObject::id_t id = MapObject::IdMapFeatureMin; id <= MapObject::IdMapFeatureMax; ++id) {
+		const MapObject &object = _map.object(id);
+		if (object.unitType == MapObject::UnitType::TransporterPad and object.b == 0) {
+			const uint16_t region = regionAt(object.pos());
+			if (region != NoRegion) { exitIds[region] = id; }
+		}
+	}
+
+	std::vector<Parent> parents(_regionCount * KeyStates, Parent{ -2, -1 });
+	std::vector<int> queue;
+	queue.reserve(parents.size());
+	const int startState = start * KeyStates + _regionKeys[start];
+	parents[startState] = Parent{ -1, -1 };
+	queue.push_back(startState);
+
+	keyMask_t encounteredLocks = 0;
+	int goal = -1;
+	for (size_t head = 0; head < queue.size(); ++head) {
+		const int state = queue[head];
+		const uint16_t region = state / KeyStates;
+		const keyMask_t keys = state % KeyStates;
+		_reachableKeys |= keys;
+		if (exitIds[region] != MapObject::IdNone) {
+			goal = state;
+			break;
+		}
+
+		for (int e = _firstEdge[region]; e < _firstEdge[region + 1]; ++e) {
+			const Edge &edge = _edges[e];
+			if ((edge.lock & keys) != edge.lock) {
+				encounteredLocks |= edge.lock;
+				continue;
+			}
+			const int next = edge.target * KeyStates + (keys | _regionKeys[edge.target]);
+			if (parents[next].state == -2) {
+				parents[next] = Parent{ state, e };
+				queue.push_back(next);
+			}
+		}
+	}
+
+	if (goal == -1) {
+		_blockingLocks = encounteredLocks & ~_reachableKeys;
+		return false;
+	}
+
+	std::vector<int> path;
+	for (int state = goal; state != -1; state = parents[state].state) {
+		path.push_back(state);
+	}
+	std::reverse(path.begin(), path.end());
+
+	appendKeySteps(start, path.front() % KeyStates);
+	for (size_t i = 1; i < path.size(); ++i) {
+		const Edge &edge = _edges[parents[path[i]].edge];
+		_steps.push_back(Step{ edge.kind, edge.objectId, _map.object(edge.objectId).pos(), edge.lock });
+		appendKeySteps(path[i] / KeyStates, (path[i] % KeyStates) & ~(path[i - 1] % KeyStates));
+	}
+	const MapObject::id_t exitId = exitIds[goal / KeyStates];
+	_steps.push_back(Step{ Step::Kind::Exit, exitId, _map.object(exitId).pos(), 0 });
+
+	_solvable = true;
+	return true;
+}
+
+
+/** Whether the last call to #solve() found a way to the exit. */
+bool ProgressionSolver::isSolvable() const {
+	return _solvable;
+}
+
+
+/** The route to the exit found by #solve(), from the player's point of view.
+ * Walking within a region isn't listed, only picking up keys and passing from
+ * one region to another.
+ */
+const std::vector<ProgressionSolver::Step> &ProgressionSolver::steps() const {
+	return _steps;
+}
+
+
+/** The ids of the keys in the order in which they're picked up. */
+std::vector<MapObject::id_t> ProgressionSolver::keyOrder() const {
+	std::vector<MapObject::id_t> result;
+	for (const Step &step : _steps) {
+		if (step.kind == Step::Kind::PickUpKey) { result.push_back(step.objectId); }
+	}
+	return result;
+}
+
+
+/** The keys that the player can get hold of, as a mask of #KeyBit. If the
+ * level is solvable, this only includes the keys found up to the point when
+ * the exit was reached.
+ */
+ProgressionSolver::keyMask_t ProgressionSolver::reachableKeys() const {
+	return _reachableKeys;
+}
+
+
+/** If the level isn't solvable, the locks of the doors the player ran into
+ * without having the key for them, as a mask of #KeyBit.
+ */
+ProgressionSolver::keyMask_t ProgressionSolver::blockingLocks() const {
+	return _blockingLocks;
+}
+
+
+int ProgressionSolver::regionCount() const {
+	return _regionCount;
+}
+
+
+QStringList ProgressionSolver::describeSteps() const {
+	QStringList result;
+	for (const Step &step : _steps) {
+		result.append(toString(step));
+	}
+	return result;
+}
+
+
+QString ProgressionSolver::toString(const Step &step) {
+	const QString position = QString("(%1, %2)").arg(step.position.x()).arg(step.position.y());
+	switch (step.kind) {
+	case Step::Kind::PickUpKey: return QString("pick up the %1 key at %2").arg(keyName(step.key), position);
+	case Step::Kind::UnlockDoor: return QString("open the %1 door at %2").arg(keyName(step.key), position);
+	case Step::Kind::Transporter: return QString("take the transporter pad at %1").arg(position);
+	case Step::Kind::Elevator: return QString("take the elevator at %1").arg(position);
+	case Step::Kind::Exit: return QString("reach the exit at %1").arg(position);
+	}
+	return QString();
+}
+
+
+/** The names of the keys in \a keys, e.g. "spade and star". */
+QString ProgressionSolver::keyName(keyMask_t keys) {
+	QStringList names;
+	if (keys & Spade) { names.append("spade"); }
+	if (keys & Heart) { names.append("heart"); }
+	if (keys & Star) { names.append("star"); }
+	if (names.size() > 1) {
+		const QString last = names.takeLast();
+		return names.join(", ") + " and " + last;
+	}
+	return names.value(0);
+}
+
+
+/** Mark the tiles of locked doors as gates, then label the connected areas of
+ * the remaining passable tiles.
+ */
+void ProgressionSolver::makeRegions() {
+	for (MapObject::id_t id = MapObject::IdMapFeatureMin; id <= MapObject::IdMapFeatureMax; ++id) {
+		const MapObject &door = _map.object(id);
+		if (door.unitType != MapObject::UnitType::Door or door.c < 1 or door.c > 3) { continue; }
+		const int8_t gate = _gateDoors.size();
+		_gateDoors.push_back(id);
+		_gateCells.emplace_back();
+		const QPoint step = door.a == 0 ? QPoint(1, 0) : QPoint(0, 1);
+		for (const QPoint &p : { door.pos() - step, door.pos(), door.pos() + step }) {
+			if (_map.rect().contains(p)) {
+				_gate[p.x() + _width * p.y()] = gate;
+				_gateCells.back().push_back(p);
+			}
+		}
+	}
+
+	std::vector<int> stack;
+	for (int i = 0; i < _width * _height; ++i) {
+		if (not _passable[i] or _gate[i] != -1 or _region[i] != NoRegion) { continue; }
+		const uint16_t region = _regionCount++;
+		_region[i] = region;
+		stack.push_back(i);
+		while (not stack.empty()) {
+			const int current = stack.back();
+			stack.pop_back();
+			const int x = current % _width;
+			const int y = current / _width;
+			for (int neighbor : { x > 0 ? current - 1 : -1, x < _width - 1 ? current + 1 : -1,
+			                      y > 0 ? current - _width : -1, y < _height - 1 ? current + _width : -1 }) {
+				if (neighbor != -1 and _passable[neighbor] and _gate[neighbor] == -1
+				        and _region[neighbor] == NoRegion) {
+					_region[neighbor] = region;
+					stack.push_back(neighbor);
+				}
+			}
+		}
+	}
+}
+
+
+/** Assign every key to the regions from which it can be picked up. */
+void ProgressionSolver::makeKeys() {
+	_regionKeys.assign(_regionCount, 0);
+	_regionKeyIds.assign(_regionCount * 3, MapObject::IdNone);
+
+	for (MapObject::id_t id = MapObject::IdHiddenMin; id <= MapObject::IdHiddenMax; ++id) {
+		const MapObject &key = _map.object(id);
+		if (key.unitType != MapObject::UnitType::Key or key.a > 2) { continue; }
+		for (const QPoint &offset : { QPoint(0, 0), QPoint(-1, 0), QPoint(1, 0), QPoint(0, -1), QPoint(0, 1) }) {
+			const uint16_t region = regionAt(key.pos() + offset);
+			if (region == NoRegion) { continue; }
+			_regionKeys[region] |= 1 << key.a;
+			if (_regionKeyIds[region * 3 + key.a] == MapObject::IdNone) {
+				_regionKeyIds[region * 3 + key.a] = id;
+			}
+		}
+	}
+}
+
+
+void ProgressionSolver::makeEdges() {
+	// locked doors
+	for (size_t gate = 0; gate < _gateDoors.size(); ++gate) {
+		const MapObject &door = _map.object(_gateDoors[gate]);
+		std::vector<uint16_t> regions;
+		for (const QPoint &p : _gateCells[gate]) {
+			for (const QPoint &offset : { QPoint(-1, 0), QPoint(1, 0), QPoint(0, -1), QPoint(0, 1) }) {
+				const uint16_t region = regionAt(p + offset);
+				if (region != NoRegion and std::find(regions.begin(), regions.end(), region) == regions.end()) {
+					regions.push_back(region);
+				}
+			}
+		}
+		const keyMask_t lock = 1 << (door.c - 1);
+		for (uint16_t source : regions) {
+			for (uint16_t target : regions) {
+				if (source != target) {
+					addEdge(source, Edge{ target, lock, Step::Kind::UnlockDoor, _gateDoors[gate] });
+				}
+			}
+		}
+	}
+
+	// transporter pads and elevators
+	std::vector<std::pair<uint16_t, MapObject::id_t>> elevators;
+	for (MapObject::id_t id = MapObject::IdMapFeatureMin; id <= MapObject::IdMapFeatureMax; ++id) {
+		const MapObject &object = _map.object(id);
+		if (object.unitType == MapObject::UnitType::TransporterPad and object.b == 1) {
+			const uint16_t source = regionAt(object.pos());
+			const uint16_t target = regionAt(QPoint(object.c, object.d));
+			if (source != NoRegion and target != NoRegion and source != target) {
+				addEdge(source, Edge{ target, 0, Step::Kind::Transporter, id });
+			}
+		} else if (object.unitType == MapObject::UnitType::Elevator) {
+			const uint16_t region = regionAt(object.pos());
+			if (region != NoRegion) { elevators.push_back({ region, id }); }
+		}
+	}
+	for (const auto &source : elevators) {
+		for (const auto &target : elevators) {
+			if (source.first != target.first) {
+				addEdge(source.first, Edge{ target.first, 0, Step::Kind::Elevator, source.second });
+			}
+		}
+	}
+
+	// store the edges sorted by source region for fast lookup
+	std::stable_sort(_edgeList.begin(), _edgeList.end(), [](const auto &a, const auto &b) {
+		return a.first < b.first;
+	});
+	_firstEdge.assign(_regionCount + 1, 0);
+	_edges.reserve(_edgeList.size());
+	for (const auto &entry : _edgeList) {
+		++_firstEdge[entry.first + 1];
+		_edges.push_back(entry.second);
+	}
+	for (int region = 0; region < _regionCount; ++region) {
+		_firstEdge[region + 1] += _firstEdge[region];
+	}
+	_edgeList.clear();
+	_edgeList.shrink_to_fit();
+}
+
+
+void ProgressionSolver::addEdge(uint16_t source, const Edge &edge) {
+	_edgeList.push_back({ source, edge });
+}
+
+
+uint16_t ProgressionSolver::regionAt(const QPoint &position) const {
+	if (not _map.rect().contains(position)) { return NoRegion; }
+	return _region[position.x() + _width * position.y()];
+}
+
+
+void ProgressionSolver::appendKeySteps(uint16_t region, keyMask_t newKeys) {
+	for (int bit = 0; bit < 3; ++bit) {
+		if (not (newKeys & (1 << bit))) { continue; }
+		const MapObject::id_t id = _regionKeyIds[region * 3 + bit];
+		_steps.push_back(Step{ Step::Kind::PickUpKey, id, _map.object(id).pos(), keyMask_t(1 << bit) });
+	}
+}
@@ -0,0 +1,91 @@
+#ifndef PROGRESSIONSOLVER_H
+#define PROGRESSIONSOLVER_H
+
+#include <QPoint>
+#include <QString>
+#include <QStringList>
+#include <cstdint>
+#include <vector>
+#include "mapobject.h"
+
+class Map;
+class Tileset;
+
+
+class ProgressionSolver {
+public:
+	typedef uint8_t keyMask_t;
+
+	/** Keys as bits of a key mask. A door with lock C needs key 1 << (C - 1). */
+	enum KeyBit : keyMask_t {
+		Spade = 1, Heart = 2, Star = 4, AllKeys = 7
+	};
+
+	struct Step {
+		enum class Kind { PickUpKey, UnlockDoor, Transporter, Elevator, Exit };
+		Kind kind;
+		MapObject::id_t objectId;
+		QPoint position;
+		keyMask_t key; ///< the key picked up or needed to open the door
+	};
+
+	ProgressionSolver(const Map &map, const Tileset &tileset);
+
+	bool solve();
+
+	bool isSolvable() const;
+	const std::vector<Step> &steps() const;
+	std::vector<MapObject::id_t> keyOrder() const;
+	keyMask_t reachableKeys() const;
+	keyMask_t blockingLocks() const;
+	int regionCount() const;
+
+	QStringList describeSteps() const;
+	static QString toString(const Step &step);
+	static QString keyName(keyMask_t key);
+
+private:
+	static constexpr uint16_t NoRegion = 0xFFFF;
+	static constexpr int KeyStates = AllKeys + 1;
+
+	struct Edge {
+		uint16_t target;
+		keyMask_t lock;
+		Step::Kind kind;
+		MapObject::id_t objectId;
+	};
+
+	struct Parent {
+		int state;
+		int edge;
+	};
+
+	void makeRegions();
+	void makeKeys();
+	void makeEdges();
+	void addEdge(uint16_t source, const Edge &edge);
+	uint16_t regionAt(const QPoint &position) const;
+	void appendKeySteps(uint16_t region, keyMask_t newKeys);
+
+	const Map &_map;
+	const int _width;
+	const int _height;
+	std::vector<bool> _passable;
+	std::vector<int8_t> _gate;
+	std::vector<uint16_t> _region;
+	int _regionCount = 0;
+	std::vector<keyMask_t> _regionKeys;
+	std::vector<MapObject::id_t> _regionKeyIds;
+	std::vector<int> _firstEdge;
+	std::vector<std::pair<uint16_t, Edge>> _edgeList;
+	std::vector<Edge> _edges;
+	std::vector<MapObject::id_t> _gateDoors;
+	std::vector<std::vector<QPoint>> _gateCells;
+
+	bool _solvable = false;
+	keyMask_t _reachableKeys = 0;
+	keyMask_t _blockingLocks = 0;
+	std::vector<Step> _steps;
+};
+
+#endif // PROGRESSIONSOLVER_H
@@ -0,0 +1,266 @@
+#include "reachability.h"
+#include <QtAlgorithms>
+#include <algorithm>
+#include "map.h"
+#include "mapobject.h"
+#include "tile.h"
+#include "tileset.h"
+
+
+/** @class Reachability
+ * Computes which tiles can be reached from a starting point, and how many
+ * steps it takes to get there.
+ *
+ * The map is represented as one 128 bit mask per row, so that a whole
+ * breadth-first search step, i.e. growing the set of reached tiles by one
+ * tile in every direction, consists of a few shifts and logical operations
+ * per row. The search runs layer by layer, every tile that is newly reached
+ * in layer *n* has a distance of *n* from the starting point.
+ *
+ * A tile is passable if it has the #Tile::Walkable attribute (or
+ * #Tile::Hoverable for #Mover::Hoverbot). In addition, for the player:
+ *
+ * * tiles too close to the map border are never passable, see
+ *   #walkableRect(),
+ * * door and elevator tiles are passable, regardless of whether the door is
+ *   locked,
+ * * reaching a transporter pad with coordinates leads to its destination,
+ * * reaching an elevator leads to all other elevators.
+ *
+ * This makes the result optimistic: a tile that isn't reachable can't be
+ * reached in the game either, but a reachable tile might require keys.
+ */
+
+
+static_assert(sizeof(Reachability::Row) * 8 == 128, "a row must hold 128 bits");
+
+
+/** Prepare a reachability analysis of \a map for \a mover. Call #compute()
+ * to run it.
+ */
+Reachability::Reachability(const Map &map, const Tileset &tileset, Mover mover)
+    : _width(map.width()), _height(map.height()), _mover(mover), _passable(_height),
+      _reachable(_height), _distance(_width * _height, Unreachable) {
+	Q_ASSERT(_width <= 128);
+	makePassable(map, tileset);
+	if (_mover == Mover::Player) {
+		makeLinks(map);
+	}
+}
+
+
+/** Compute the reachable tiles and their distances from \a start. The
+ * starting tile itself is always reachable, even if it isn't passable.
+ */
+void Reachability::compute(const QPoint &start) {
+	std::fill(_reachable.begin(), _reachable.end(), Row());
+	std::fill(_distance.begin(), _distance.end(), Unreachable);
+	_maxDistance = Unreachable;
+	_reachableCount = 0;
+	if (not (0 <= start.x() and start.x() < _width and 0 <= start.y() and start.y() < _height)) {
+		return;
+	}
+
+	std::vector<Row> frontier(_height);
+	std::vector<Row> next(_height);
+	std::vector<bool> linkUsed(_links.size(), false);
+	setBit(frontier[start.y()], start.x());
+
+	for (int d = 0; ; ++d) {
+		// record the tiles reached in this layer
+		bool reachedAny = false;
+		for (int y = 0; y < _height; ++y) {
+			const Row &f = frontier[y];
+			if ((f.lo | f.hi) == 0) { continue; }
+			reachedAny = true;
+			_reachable[y].lo |= f.lo;
+			_reachable[y].hi |= f.hi;
+			for (int half = 0; half < 2; ++half) {
+				uint64_t bits = half ? f.hi : f.lo;
+				_reachableCount += qPopulationCount(quint64(bits));
+				while (bits) {
+					const int x = qCountTrailingZeroBits(quint64(bits)) + 64 * half;
+					_distance[x + _width * y] = d;
+					bits &= bits - 1;
+				}
+			}
+		}
+		if (not reachedAny) { break; }
+		_maxDistance = d;
+
+		// grow the frontier by one tile in each direction
+		for (int y = 0; y < _height; ++y) {
+			const Row &f = frontier[y];
+			Row n;
+			n.lo = (f.lo << 1) | (f.lo >> 1) | (f.hi << 63);
+			n.hi = (f.hi << 1) | (f.hi >> 1) | (f.lo >> 63);
+			if (y > 0) {
+				n.lo |= frontier[y - 1].lo;
+				n.hi |= frontier[y - 1].hi;
+			}
+			if (y < _height - 1) {
+				n.lo |= frontier[y + 1].lo;
+				n.hi |= frontier[y + 1].hi;
+			}
+			next[y].lo = n.lo & _passable[y].lo & ~_reachable[y].lo;
+			next[y].hi = n.hi & _passable[y].hi & ~_reachable[y].hi;
+		}
+
+		// follow transporter pads and elevators
+		for (size_t i = 0; i < _links.size(); ++i) {
+			const Link &link = _links[i];
+			if (linkUsed[i] or not testBit(frontier[link.source.y()], link.source.x())) { continue; }
+			linkUsed[i] = true;
+			for (const QPoint &target : link.targets) {
+				if (not testBit(_reachable[target.y()], target.x())) {
+					setBit(next[target.y()], target.x());
+				}
+			}
+		}
+
+		frontier.swap(next);
+	}
+}
+
+
+bool Reachability::isPassable(const QPoint &position) const {
+	return testBit(_passable.at(position.y()), position.x());
+}
+
+
+bool Reachability::isReachable(const QPoint &position) const {
+	return testBit(_reachable.at(position.y()), position.x());
+}
+
+
+/** Whether \a position or one of its four neighbours is reachable. This is
+ * what matters for hidden items, which are found by searching a tile next
+ * to the player.
+ */
+bool Reachability::isReachableOrAdjacent(const QPoint &position) const {
+	for (const QPoint &offset : { QPoint(0, 0), QPoint(-1, 0), QPoint(1, 0), QPoint(0, -1), QPoint(0, 1) }) {
+		const QPoint p = position + offset;
+		if (0 <= p.x() and p.x() < _width and 0 <= p.y() and p.y() < _height and isReachable(p)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/** The number of steps from the starting point to \a position, or
+ * #Unreachable.
+ */
+int Reachability::distance(const QPoint &position) const {
+	return _distance.at(position.x() + _width * position.y());
+}
+
+
+/** The largest distance of any reachable tile, or #Unreachable if
+ * #compute() hasn't been called.
+ */
+int Reachability::maxDistance() const {
+	return _maxDistance;
+}
+
+
+int Reachability::reachableCount() const {
+	return _reachableCount;
+}
+
+
+const std::vector<Reachability::Row> &Reachability::passableRows() const {
+	return _passable;
+}
+
+
+const std::vector<Reachability::Row> &Reachability::reachableRows() const {
+	return _reachable;
+}
+
+
+/** The area of the map that the player may enter. The game doesn't let the
+ * player come so close to the border that the view would extend beyond the
+ * map.
+ */
+QRect Reachability::walkableRect(const Map &map) {
+	static const int HORIZONTAL_MARGIN = 5;
+	static const int VERTICAL_MARGIN = 3;
+
+	return map.rect().adjusted(HORIZONTAL_MARGIN, VERTICAL_MARGIN,
+	                           -HORIZONTAL_MARGIN, -VERTICAL_MARGIN);
+}
+
+
+void Reachability::makePassable(const Map &map, const Tileset &tileset) {
+	const Tile::Attribute attribute = _mover == Mover::Player ? Tile::Walkable : Tile::Hoverable;
+	bool passableTile[256];
+	for (int tileNo = 0; tileNo < 256; ++tileNo) {
+		passableTile[tileNo] = tileset.tile(tileNo).attributes().testFlag(attribute);
+	}
+
+	const QRect area = _mover == Mover::Player ? walkableRect(map) : map.rect();
+	const uint8_t *tiles = map.tiles();
+	for (int y = area.top(); y <= area.bottom(); ++y) {
+		for (int x = area.left(); x <= area.right(); ++x) {
+			if (passableTile[tiles[x + _width * y]]) {
+				setBit(_passable[y], x);
+			}
+		}
+	}
+
+	if (_mover != Mover::Player) { return; }
+
+	for (MapObject::id_t id = MapObject::IdMapFeatureMin; id <= MapObject::IdMapFeatureMax; ++id) {
+		const MapObject &object = map.object(id);
+		const bool isDoor = object.unitType == MapObject::UnitType::Door;
+		if (not (isDoor or object.unitType == MapObject::UnitType::Elevator)) { continue; }
+		// elevators are always horizontal doors
+		const QPoint step = isDoor and object.a != 0 ? QPoint(0, 1) : QPoint(1, 0);
+		for (const QPoint &p : { object.pos() - step, object.pos(), object.pos() + step }) {
+			if (area.contains(p)) {
+				setBit(_passable[p.y()], p.x());
+			}
+		}
+	}
+}
+
+
+void Reachability::makeLinks(const Map &map) {
+	std::vector<QPoint> elevators;
+	for (MapObject::id_t id = MapObject::IdMapFeatureMin; id <= MapObject::IdMapFeatureMax; ++id) {
+		const MapObject &object = map.object(id);
+		if (object.unitType == MapObject::UnitType::TransporterPad and object.b == 1) {
+			const QPoint destination(object.c, object.d);
+			if (map.rect().contains(destination)) {
+				_links.push_back(Link{ object.pos(), { destination } });
+			}
+		} else if (object.unitType == MapObject::UnitType::Elevator) {
+			elevators.push_back(object.pos());
+		}
+	}
+
+	for (const QPoint &elevator : elevators) {
+		Link link{ elevator, {} };
+		for (const QPoint &other : elevators) {
+			if (other != elevator) { link.targets.push_back(other); }
+		}
+		if (not link.targets.empty()) {
+			_links.push_back(link);
+		}
+	}
+}
+
+
+bool Reachability::testBit(const Row &row, int x) {
+	return x < 64 ? (row.lo >> x) & 1 : (row.hi >> (x - 64)) & 1;
+}
+
+
+void Reachability::setBit(Row &row, int x) {
+	if (x < 64) {
+		row.lo |= uint64_t(1) << x;
+	} else {
+		row.hi |= uint64_t(1) << (x - 64);
+	}
+}
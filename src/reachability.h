@@ -0,0 +1,63 @@
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <QPoint>
+#include <QRect>
+#include <cstdint>
+#include <vector>
+
+class Map;
+class Tileset;
+
+
+class Reachability {
+public:
+	enum class Mover { Player, Hoverbot };
+
+	/** A map row as a bitmask, bit x is set for column x. */
+	struct Row {
+		uint64_t lo = 0; ///< columns 0–63
+		uint64_t hi = 0; ///< columns 64–127
+	};
+
+	static constexpr int Unreachable = -1;
+
+	Reachability(const Map &map, const Tileset &tileset, Mover mover = Mover::Player);
+
+	void compute(const QPoint &start);
+
+	bool isPassable(const QPoint &position) const;
+	bool isReachable(const QPoint &position) const;
+	bool isReachableOrAdjacent(const QPoint &position) const;
+	int distance(const QPoint &position) const;
+	int maxDistance() const;
+	int reachableCount() const;
+
+	const std::vector<Row> &passableRows() const;
+	const std::vector<Row> &reachableRows() const;
+
+	static QRect walkableRect(const Map &map);
+
+private:
+	struct Link {
+		QPoint source;
+		std::vector<QPoint> targets;
+	};
+
+	void makePassable(const Map &map, const Tileset &tileset);
+	void makeLinks(const Map &map);
+	static bool testBit(const Row &row, int x);
+	static void setBit(Row &row, int x);
+
+	const int _width;
+	const int _height;
+	const Mover _mover;
+	std::vector<Row> _passable;
+	std::vector<Row> _reachable;
+	std::vector<int16_t> _distance;
+	std::vector<Link> _links;
+	int _maxDistance = Unreachable;
+	int _reachableCount = 0;
+};
+
+#endif // REACHABILITY_H
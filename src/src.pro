@@ -1,5 +1,5 @@
 TEMPLATE = app
-QT       += core gui svg widgets
+QT       += concurrent core gui svg widgets
 CONFIG += c++17
 CONFIG -= debug_and_release_target
 GITREV = $$system(git --git-dir=$$PWD/../.git describe --always --abbrev=0)
@@ -20,52 +20,104 @@ QMAKE_TARGET_BUNDLE_PREFIX = com.maxlor
 
 DEFINES += APP_VERSION=$${APP_VERSION} GITREV=$${GITREV}
 
+# qmake CONFIG+=tracing instruments the editor with TRACE_SCOPE(), see trace.cpp
+tracing {
+    DEFINES += ENABLE_TRACING
+}
+
 SOURCES += \
     abstracttilewidget.cpp \
+    batchvalidator.cpp \
     constants.cpp \
     coordinatewidget.cpp \
+    gamesimulator.cpp \
     iconfactory.cpp \
+    lineofsight.cpp \
     main.cpp \
     mainwindow.cpp \
     map.cpp \
+    maparchive.cpp \
+    maparchivetool.cpp \
     mapcheck.cpp \
+    mapclipboard.cpp \
     mapcommands.cpp \
+    mapcompositor.cpp \
     mapcontroller.cpp \
+    mapdiff.cpp \
+    mapdifftool.cpp \
+    mapindex.cpp \
+    mapindextool.cpp \
+    mapindexwidget.cpp \
     mapobject.cpp \
     mapwidget.cpp \
     multisignalblocker.cpp \
     objecteditwidget.cpp \
+    objectindex.cpp \
+    patternsearch.cpp \
+    progressionsolver.cpp \
+    reachability.cpp \
     scrollarea.cpp \
+    statisticswidget.cpp \
+    texticonengine.cpp \
     tile.cpp \
+    tileblitter.cpp \
+    tileindex.cpp \
     tileset.cpp \
     tilewidget.cpp \
+    trace.cpp \
     util.cpp \
-    validationdialog.cpp
+    validationdialog.cpp \
+    wallengine.cpp
 
 HEADERS += \
     abstracttilewidget.h \
+    batchvalidator.h \
+    characterrom.h \
     constants.h \
     coordinatewidget.h \
+    gamesimulator.h \
     iconfactory.h \
+    lineofsight.h \
     mainwindow.h \
     map.h \
+    maparchive.h \
+    maparchivetool.h \
     mapcheck.h \
+    mapclipboard.h \
     mapcommands.h \
+    mapcompositor.h \
     mapcontroller.h \
+    mapdiff.h \
+    mapdifftool.h \
+    mapindex.h \
+    mapindextool.h \
+    mapindexwidget.h \
     mapobject.h \
     mapwidget.h \
     multisignalblocker.h \
     objecteditwidget.h \
+    objectindex.h \
+    patternsearch.h \
+    progressionsolver.h \
+    reachability.h \
     scrollarea.h \
+    statisticswidget.h \
+    texticonengine.h \
     tile.h \
+    tileblitter.h \
+    tileindex.h \
     tileset.h \
     tilewidget.h \
+    trace.h \
     util.h \
-    validationdialog.h
+    validationdialog.h \
+    wallengine.h
 
 FORMS += \
     mainwindow.ui \
+    mapindexwidget.ui \
     objecteditwidget.ui \
+    statisticswidget.ui \
     validationdialog.ui
     
 RESOURCES += \
@@ -0,0 +1,180 @@
+#include "statisticswidget.h"
+#include <QIcon>
+#include <QPixmap>
+#include <QSignalBlocker>
+#include <QTableWidgetItem>
+#include <QTimer>
+#include <map>
+#include <vector>
+#include "map.h"
+#include "mapobject.h"
+#include "tile.h"
+#include "tileset.h"
+
+
+/** @class StatisticsWidget
+ * Shows how often each tile is used on the map, the area covered by tiles
+ * with each attribute, and the number of objects of each type.
+ *
+ * All numbers come from the map's TileIndex and its object list, so updating
+ * them doesn't require a scan of the map. Updates are coalesced and skipped
+ * while the widget is hidden, so drawing on the map stays fast.
+ */
+
+
+StatisticsWidget::StatisticsWidget(QWidget *parent) : QWidget(parent) {
+	_ui.setupUi(this);
+	_ui.tableTiles->setColumnCount(2);
+	_ui.tableTiles->setHorizontalHeaderLabels({ "Tile", "Count" });
+	_ui.tableSummary->setColumnCount(2);
+	_ui.tableSummary->setHorizontalHeaderLabels({ "Property", "Count" });
+	_ui.buttonReplace->setEnabled(false);
+	
+	connect(_ui.tableTiles, &QTableWidget::itemSelectionChanged,
+	        this, &StatisticsWidget::onCurrentTileChanged);
+	connect(_ui.buttonMark, &QPushButton::toggled, this, &StatisticsWidget::onCurrentTileChanged);
+	connect(_ui.buttonReplace, &QPushButton::clicked, this, &StatisticsWidget::onReplaceClicked);
+}
+
+
+void StatisticsWidget::setMap(const Map *map) {
+	if (_map) { disconnect(_map, nullptr, this, nullptr); }
+	_map = map;
+	if (_map) {
+		connect(_map, &Map::tilesChanged, this, &StatisticsWidget::scheduleUpdate);
+		connect(_map, &Map::objectsChanged, this, &StatisticsWidget::scheduleUpdate);
+	}
+	scheduleUpdate();
+}
+
+
+void StatisticsWidget::setTileset(const Tileset *tileset) {
+	if (_tileset) { disconnect(_tileset, nullptr, this, nullptr); }
+	_tileset = tileset;
+	if (_tileset) {
+		connect(_tileset, &Tileset::changed, this, &StatisticsWidget::scheduleUpdate);
+		connect(_tileset, &Tileset::tilesChanged, this, &StatisticsWidget::scheduleUpdate);
+	}
+	scheduleUpdate();
+}
+
+
+/** The tile selected in the table, or -1 if there is none. */
+int StatisticsWidget::currentTile() const {
+	const QList<QTableWidgetItem*> items = _ui.tableTiles->selectedItems();
+	if (items.isEmpty()) { return -1; }
+	return _ui.tableTiles->item(items.first()->row(), 0)->data(Qt::UserRole).toInt();
+}
+
+
+void StatisticsWidget::showEvent(QShowEvent *event) {
+	QWidget::showEvent(event);
+	scheduleUpdate();
+}
+
+
+void StatisticsWidget::scheduleUpdate() {
+	if (_updatePending or not isVisible()) { return; }
+	_updatePending = true;
+	QTimer::singleShot(0, this, &StatisticsWidget::updateStatistics);
+}
+
+
+void StatisticsWidget::onCurrentTileChanged() {
+	const int tileNo = currentTile();
+	_ui.buttonReplace->setEnabled(tileNo >= 0);
+	emit markedTileChanged(_ui.buttonMark->isChecked() ? tileNo : -1);
+}
+
+
+void StatisticsWidget::onReplaceClicked() {
+	const int tileNo = currentTile();
+	if (tileNo >= 0) { emit replaceTileRequested(tileNo); }
+}
+
+
+void StatisticsWidget::updateStatistics() {
+	_updatePending = false;
+	if (not _map) { return; }
+	updateTiles();
+	updateSummary();
+}
+
+
+void StatisticsWidget::updateTiles() {
+	const int selectedTile = currentTile();
+	const bool haveTileset = _tileset and _tileset->isValid();
+	const TileIndex &index = _map->tileIndex();
+	
+	QSignalBlocker blocker(_ui.tableTiles);
+	_ui.tableTiles->setSortingEnabled(false);
+	_ui.tableTiles->clearContents();
+	int rowCount = 0;
+	for (int tileNo = 0; tileNo < 256; ++tileNo) {
+		if (index.count(tileNo) > 0) { ++rowCount; }
+	}
+	_ui.tableTiles->setRowCount(rowCount);
+	
+	int row = 0;
+	for (int tileNo = 0; tileNo < 256; ++tileNo) {
+		const int count = index.count(tileNo);
+		if (count == 0) { continue; }
+		QTableWidgetItem *tileItem = new QTableWidgetItem(QString("0x%1").arg(tileNo, 2, 16, QChar('0')));
+		tileItem->setData(Qt::UserRole, tileNo);
+		if (haveTileset) {
+			tileItem->setIcon(QIcon(QPixmap::fromImage(_tileset->tile(tileNo).image())));
+		}
+		QTableWidgetItem *countItem = new QTableWidgetItem();
+		countItem->setData(Qt::DisplayRole, count);
+		_ui.tableTiles->setItem(row, 0, tileItem);
+		_ui.tableTiles->setItem(row, 1, countItem);
+		if (tileNo == selectedTile) { _ui.tableTiles->selectRow(row); }
+		++row;
+	}
+	_ui.tableTiles->setSortingEnabled(true);
+	blocker.unblock();
+	
+	// the selected tile may no longer be in use
+	if (currentTile() != selectedTile) { onCurrentTileChanged(); }
+}
+
+
+void StatisticsWidget::updateSummary() {
+	static const std::pair<Tile::Attribute, QString> attributes[] = {
+	    { Tile::Walkable, "Walkable" }, { Tile::Hoverable, "Hoverable" }, { Tile::Movable, "Movable" },
+	    { Tile::Destructible, "Destructible" }, { Tile::ShootThrough, "Shoot through" },
+	    { Tile::PushOnto, "Push onto" }, { Tile::Searchable, "Searchable" }
+	};
+	
+	std::vector<std::pair<QString, int>> rows;
+	if (_tileset and _tileset->isValid()) {
+		const TileIndex &index = _map->tileIndex();
+		for (const auto &attribute : attributes) {
+			int area = 0;
+			for (int tileNo = 0; tileNo < 256; ++tileNo) {
+				if (_tileset->tile(tileNo).attributes().testFlag(attribute.first)) {
+					area += index.count(tileNo);
+				}
+			}
+			rows.push_back({ attribute.second + " tiles", area });
+		}
+	}
+	
+	std::map<MapObject::UnitType, int> objectCounts;
+	for (MapObject::id_t id = MapObject::IdMin; id <= MapObject::IdMax; ++id) {
+		const MapObject &object = _map->object(id);
+		if (object.unitType != MapObject::UnitType::None) { ++objectCounts[object.unitType]; }
+	}
+	for (const auto &objectCount : objectCounts) {
+		rows.push_back({ MapObject::toString(objectCount.first), objectCount.second });
+	}
+	
+	_ui.tableSummary->clearContents();
+	_ui.tableSummary->setRowCount(rows.size());
+	for (size_t row = 0; row < rows.size(); ++row) {
+		QTableWidgetItem *countItem = new QTableWidgetItem();
+		countItem->setData(Qt::DisplayRole, rows[row].second);
+		_ui.tableSummary->setItem(row, 0, new QTableWidgetItem(rows[row].first));
+		_ui.tableSummary->setItem(row, 1, countItem);
+	}
+}
@@ -0,0 +1,45 @@
+#ifndef STATISTICSWIDGET_H
+#define STATISTICSWIDGET_H
+
+#include "ui_statisticswidget.h"
+#include <QWidget>
+#include <cstdint>
+
+class Map;
+class Tileset;
+
+
+class StatisticsWidget : public QWidget {
+	Q_OBJECT
+public:
+	explicit StatisticsWidget(QWidget *parent = nullptr);
+	
+	void setMap(const Map *map);
+	void setTileset(const Tileset *tileset);
+	
+	int currentTile() const;
+	
+signals:
+	void markedTileChanged(int tileNo);
+	void replaceTileRequested(uint8_t tileNo);
+	
+protected:
+	void showEvent(QShowEvent *event) override;
+	
+private slots:
+	void scheduleUpdate();
+	void onCurrentTileChanged();
+	void onReplaceClicked();
+	
+private:
+	void updateStatistics();
+	void updateTiles();
+	void updateSummary();
+	
+	Ui::StatisticsWidget _ui;
+	const Map *_map = nullptr;
+	const Tileset *_tileset = nullptr;
+	bool _updatePending = false;
+};
+
+#endif // STATISTICSWIDGET_H
@@ -0,0 +1,78 @@
+#include "texticonengine.h"
+#include <QFont>
+#include <QPainter>
+#include <QPen>
+#include <QRectF>
+
+
+/** @class TextIconEngine
+ * Draws the icons made by IconFactory: a circle with a little bit of text in
+ * it. The icon is drawn directly at whatever size is requested, and the
+ * pixmaps are cached per size and mode.
+ */
+
+
+/** The icon is laid out on a square of this size, and scaled to fit. */
+static constexpr qreal DESIGN_SIZE = 128;
+
+
+TextIconEngine::TextIconEngine(const QString &text) : _text(text) {}
+
+
+void TextIconEngine::paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state) {
+	Q_UNUSED(state);
+	const qreal side = qMin(rect.width(), rect.height());
+	painter->save();
+	painter->setRenderHint(QPainter::Antialiasing);
+	painter->setRenderHint(QPainter::TextAntialiasing);
+	painter->translate(rect.left() + (rect.width() - side) / 2, rect.top() + (rect.height() - side) / 2);
+	painter->scale(side / DESIGN_SIZE, side / DESIGN_SIZE);
+	
+	static const QRectF r(8, 8, 112, 112);
+	
+	painter->setPen(QPen(mode == QIcon::Disabled ? Qt::gray : Qt::black, 8));
+	painter->setBrush(Qt::NoBrush);
+	painter->drawEllipse(r);
+	
+	QFont font("Nimbus Sans Narrow", -1, QFont::Bold);
+	font.setPixelSize(56);
+	painter->setFont(font);
+	painter->drawText(r, Qt::AlignCenter, _text);
+	painter->restore();
+}
+
+
+QPixmap TextIconEngine::pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) {
+	const quint64 key = quint64(size.width()) << 32 | quint64(size.height()) << 8 | quint64(mode) << 1
+	        | quint64(state);
+	const auto it = _pixmaps.constFind(key);
+	if (it != _pixmaps.constEnd()) {
+		return *it;
+	}
+	
+	QPixmap pixmap(size);
+	pixmap.fill(Qt::transparent);
+	QPainter painter(&pixmap);
+	paint(&painter, QRect(QPoint(0, 0), size), mode, state);
+	painter.end();
+	_pixmaps.insert(key, pixmap);
+	return pixmap;
+}
+
+
+/** The icon scales to any size. */
+QSize TextIconEngine::actualSize(const QSize &size, QIcon::Mode mode, QIcon::State state) {
+	Q_UNUSED(mode);
+	Q_UNUSED(state);
+	return size;
+}
+
+
+QIconEngine *TextIconEngine::clone() const {
+	return new TextIconEngine(_text);
+}
+
+
+QString TextIconEngine::key() const {
+	return QStringLiteral("TextIconEngine");
+}
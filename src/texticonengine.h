@@ -0,0 +1,26 @@
+#ifndef TEXTICONENGINE_H
+#define TEXTICONENGINE_H
+
+#include <QHash>
+#include <QIcon>
+#include <QIconEngine>
+#include <QPixmap>
+#include <QString>
+
+
+class TextIconEngine : public QIconEngine {
+public:
+	explicit TextIconEngine(const QString &text);
+	
+	void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state) override;
+	QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) override;
+	QSize actualSize(const QSize &size, QIcon::Mode mode, QIcon::State state) override;
+	QIconEngine *clone() const override;
+	QString key() const override;
+	
+private:
+	const QString _text;
+	QHash<quint64, QPixmap> _pixmaps;
+};
+
+#endif // TEXTICONENGINE_H
@@ -0,0 +1,227 @@
+#include "tileblitter.h"
+#include <QImage>
+#include <cstring>
+#include <vector>
+#include "map.h"
+#include "tile.h"
+#include "tileset.h"
+#include "trace.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define TILEBLITTER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(TILEBLITTER_X86) && defined(__GNUC__)
+#define TARGET(features) __attribute__((target(features)))
+#else
+#define TARGET(features)
+#endif
+
+
+/** @class TileBlitter
+ * Composes the image of a whole map from the tile images.
+ *
+ * The image is written one scanline at a time: each scanline of the target
+ * is assembled from the same pixel row of every tile in a map row, so the
+ * target is written strictly sequentially while the source rows, 256 tiles
+ * of a few kilobytes each, stay in the cache.
+ *
+ * The rows are copied by one of several implementations. By default the
+ * fastest one the CPU supports is picked at runtime: AVX2 or SSE2 on x86,
+ * plain memcpy() elsewhere. The benchmarks construct each one explicitly to
+ * compare them.
+ */
+
+
+static void copyRowScalar(uchar *dst, const uchar *const *sources, const uint8_t *tiles,
+                          int count, int rowBytes) {
+	for (int i = 0; i < count; ++i) {
+		memcpy(dst, sources[tiles[i]], rowBytes);
+		dst += rowBytes;
+	}
+}
+
+
+#ifdef TILEBLITTER_X86
+TARGET("sse2")
+static void copyRowSSE2(uchar *dst, const uchar *const *sources, const uint8_t *tiles,
+                        int count, int rowBytes) {
+	const int vectorBytes = rowBytes & ~15;
+	for (int i = 0; i < count; ++i) {
+		const uchar *src = sources[tiles[i]];
+		int offset = 0;
+		for (; offset < vectorBytes; offset += 16) {
+			const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), pixels);
+		}
+		memcpy(dst + offset, src + offset, rowBytes - offset);
+		dst += rowBytes;
+	}
+}
+
+
+TARGET("avx2")
+static void copyRowAVX2(uchar *dst, const uchar *const *sources, const uint8_t *tiles,
+                        int count, int rowBytes) {
+	const int vectorBytes = rowBytes & ~31;
+	for (int i = 0; i < count; ++i) {
+		const uchar *src = sources[tiles[i]];
+		int offset = 0;
+		for (; offset < vectorBytes; offset += 32) {
+			const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + offset));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + offset), pixels);
+		}
+		memcpy(dst + offset, src + offset, rowBytes - offset);
+		dst += rowBytes;
+	}
+	_mm256_zeroupper();
+}
+#endif
+
+
+TileBlitter::TileBlitter() : TileBlitter(best()) {}
+
+
+TileBlitter::TileBlitter(Implementation implementation) :
+        _implementation(implementation), _copyRow(rowFunction(implementation)) {
+	Q_ASSERT(isSupported(implementation));
+}
+
+
+TileBlitter::Implementation TileBlitter::implementation() const {
+	return _implementation;
+}
+
+
+/** Draws the tiles of \a map into \a target, which must be at least as large
+ * as the map in pixels, and have the same format as the tile images.
+ */
+void TileBlitter::blit(QImage *target, const Map &map, const Tileset &tileset) const {
+	TRACE_SCOPE("TileBlitter::blit");
+	Q_ASSERT(target->width() >= map.width() * tileset.tileSize().width()
+	         and target->height() >= map.height() * tileset.tileSize().height());
+	const std::vector<QImage> images = tileImages(tileset);
+	Q_ASSERT(images[0].format() == target->format());
+	blit(target->bits(), target->bytesPerLine(), map.tiles(), map.width(), 0, map.height(), images);
+}
+
+
+/** Draws the map rows \a firstRow to \a firstRow + \a rowCount - 1 of the
+ * \a width tiles wide map \a tiles into the image data at \a target.
+ *
+ * Only reads \a images and writes the part of \a target that belongs to
+ * those rows, so several threads can draw different rows of the same image
+ * at the same time.
+ */
+void TileBlitter::blit(uchar *target, int bytesPerLine, const uint8_t *tiles, int width,
+                       int firstRow, int rowCount, const std::vector<QImage> &images) const {
+	const int tileHeight = images[0].height();
+	const int sourceBytesPerLine = images[0].bytesPerLine();
+	const int rowBytes = images[0].width() * images[0].depth() / 8;
+	const size_t tileCount = images.size();
+	// for each pixel row py of the tiles, the start of that row in every tile
+	std::vector<const uchar*> sources(tileHeight * tileCount);
+	for (size_t tileNo = 0; tileNo < tileCount; ++tileNo) {
+		const uchar *bits = images[tileNo].constBits();
+		for (int py = 0; py < tileHeight; ++py) {
+			sources[py * tileCount + tileNo] = bits + py * sourceBytesPerLine;
+		}
+	}
+	for (int y = firstRow; y < firstRow + rowCount; ++y) {
+		const uint8_t *rowTiles = tiles + y * width;
+		for (int py = 0; py < tileHeight; ++py) {
+			_copyRow(target + (y * tileHeight + py) * bytesPerLine, &sources[py * tileCount], rowTiles,
+			         width, rowBytes);
+		}
+	}
+}
+
+
+/** The images of all tiles of \a tileset, for #blit(). */
+std::vector<QImage> TileBlitter::tileImages(const Tileset &tileset) {
+	std::vector<QImage> images(tileset.tileCount());
+	for (size_t tileNo = 0; tileNo < images.size(); ++tileNo) {
+		images[tileNo] = tileset.tile(tileNo).image();
+		Q_ASSERT(images[tileNo].format() == images[0].format());
+		Q_ASSERT(images[tileNo].size() == tileset.tileSize());
+	}
+	return images;
+}
+
+
+/** The fastest implementation this CPU supports. */
+TileBlitter::Implementation TileBlitter::best() {
+	static const Implementation implementation = isSupported(Implementation::AVX2) ? Implementation::AVX2
+	        : isSupported(Implementation::SSE2) ? Implementation::SSE2 : Implementation::Scalar;
+	return implementation;
+}
+
+
+bool TileBlitter::isSupported(Implementation implementation) {
+	switch (implementation) {
+	case Implementation::Scalar:
+		return true;
+#if defined(TILEBLITTER_X86) && defined(__GNUC__)
+	case Implementation::SSE2:
+		return __builtin_cpu_supports("sse2");
+	case Implementation::AVX2:
+		return __builtin_cpu_supports("avx2");
+#elif defined(TILEBLITTER_X86) && defined(_MSC_VER)
+	case Implementation::SSE2: {
+		int info[4];
+		__cpuid(info, 1);
+		return info[3] & (1 << 26);
+	}
+	case Implementation::AVX2: {
+		// the OS must save the AVX registers as well
+		int info[4];
+		__cpuid(info, 1);
+		const bool osxsave = info[2] & (1 << 27);
+		if (not osxsave or (_xgetbv(0) & 0x6) != 0x6) { return false; }
+		__cpuidex(info, 7, 0);
+		return info[1] & (1 << 5);
+	}
+#else
+	case Implementation::SSE2:
+	case Implementation::AVX2:
+		return false;
+#endif
+	}
+	return false;
+}
+
+
+/** All implementations, including the ones this CPU doesn't support. */
+std::forward_list<TileBlitter::Implementation> TileBlitter::implementations() {
+	return { Implementation::Scalar, Implementation::SSE2, Implementation::AVX2 };
+}
+
+
+QString TileBlitter::toString(Implementation implementation) {
+	switch (implementation) {
+	case Implementation::Scalar: return "scalar";
+	case Implementation::SSE2: return "SSE2";
+	case Implementation::AVX2: return "AVX2";
+	}
+	return QString();
+}
+
+
+TileBlitter::RowFunction TileBlitter::rowFunction(Implementation implementation) {
+	switch (implementation) {
+	case Implementation::Scalar: return &copyRowScalar;
+#ifdef TILEBLITTER_X86
+	case Implementation::SSE2: return &copyRowSSE2;
+	case Implementation::AVX2: return &copyRowAVX2;
+#else
+	case Implementation::SSE2:
+	case Implementation::AVX2:
+		break;
+#endif
+	}
+	return &copyRowScalar;
+}
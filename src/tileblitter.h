@@ -0,0 +1,43 @@
+#ifndef TILEBLITTER_H
+#define TILEBLITTER_H
+
+#include <QImage>
+#include <QString>
+#include <cstdint>
+#include <forward_list>
+#include <vector>
+
+class Map;
+class Tileset;
+
+
+class TileBlitter {
+public:
+	enum class Implementation { Scalar, SSE2, AVX2 };
+
+	TileBlitter();
+	explicit TileBlitter(Implementation implementation);
+
+	Implementation implementation() const;
+	void blit(QImage *target, const Map &map, const Tileset &tileset) const;
+	void blit(uchar *target, int bytesPerLine, const uint8_t *tiles, int width,
+	          int firstRow, int rowCount, const std::vector<QImage> &images) const;
+
+	static std::vector<QImage> tileImages(const Tileset &tileset);
+
+	static Implementation best();
+	static bool isSupported(Implementation implementation);
+	static std::forward_list<Implementation> implementations();
+	static QString toString(Implementation implementation);
+
+private:
+	typedef void (*RowFunction)(uchar *dst, const uchar *const *sources, const uint8_t *tiles,
+	                            int count, int rowBytes);
+
+	static RowFunction rowFunction(Implementation implementation);
+
+	Implementation _implementation;
+	RowFunction _copyRow;
+};
+
+#endif // TILEBLITTER_H
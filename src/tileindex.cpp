@@ -0,0 +1,79 @@
+#include "tileindex.h"
+#include <QtAlgorithms>
+#include <algorithm>
+
+
+/** @class TileIndex
+ * Keeps track of how often and where each tile number is used on a map.
+ *
+ * For every tile number there is a count and a bitset with one bit per map
+ * position. Changing a tile updates both in constant time, so the map can
+ * keep the index current on every modification, and questions like "where
+ * is tile 0x49 used" don't need a scan of the map. Enumerating the positions
+ * of a tile skips over empty 64 bit words, so rare tiles are found quickly.
+ */
+
+
+TileIndex::TileIndex() {
+	std::fill(std::begin(_counts), std::end(_counts), 0);
+}
+
+
+/** Rebuild the index from the row by row buffer \a tiles of size \a width ×
+ * \a height.
+ */
+void TileIndex::reset(const uint8_t *tiles, int width, int height) {
+	const int size = width * height;
+	_width = width;
+	_words = (size + 63) / 64;
+	_bits.assign(256 * _words, 0);
+	std::fill(std::begin(_counts), std::end(_counts), 0);
+	for (int i = 0; i < size; ++i) {
+		++_counts[tiles[i]];
+		_bits[tiles[i] * _words + i / 64] |= uint64_t(1) << (i % 64);
+	}
+}
+
+
+/** Record that the tile at \a index (that is, x + width * y) changed from
+ * \a oldTileNo to \a newTileNo.
+ */
+void TileIndex::change(int index, uint8_t oldTileNo, uint8_t newTileNo) {
+	if (oldTileNo == newTileNo) { return; }
+	const uint64_t bit = uint64_t(1) << (index % 64);
+	Q_ASSERT(_bits[oldTileNo * _words + index / 64] & bit);
+	--_counts[oldTileNo];
+	++_counts[newTileNo];
+	_bits[oldTileNo * _words + index / 64] &= ~bit;
+	_bits[newTileNo * _words + index / 64] |= bit;
+}
+
+
+/** How many times \a tileNo is used. */
+int TileIndex::count(uint8_t tileNo) const {
+	return _counts[tileNo];
+}
+
+
+/** Whether \a tileNo is the tile at \a position. */
+bool TileIndex::contains(uint8_t tileNo, const QPoint &position) const {
+	const int index = position.x() + _width * position.y();
+	return _bits[tileNo * _words + index / 64] & (uint64_t(1) << (index % 64));
+}
+
+
+/** All positions where \a tileNo is used, in row order. */
+std::vector<QPoint> TileIndex::positions(uint8_t tileNo) const {
+	std::vector<QPoint> result;
+	result.reserve(_counts[tileNo]);
+	const uint64_t *words = &_bits[tileNo * _words];
+	for (int w = 0; w < _words and int(result.size()) < _counts[tileNo]; ++w) {
+		quint64 bits = words[w];
+		while (bits) {
+			const int index = 64 * w + qCountTrailingZeroBits(bits);
+			result.push_back(QPoint(index % _width, index / _width));
+			bits &= bits - 1;
+		}
+	}
+	return result;
+}
@@ -0,0 +1,27 @@
+#ifndef TILEINDEX_H
+#define TILEINDEX_H
+
+#include <QPoint>
+#include <cstdint>
+#include <vector>
+
+
+class TileIndex {
+public:
+	TileIndex();
+	
+	void reset(const uint8_t *tiles, int width, int height);
+	void change(int index, uint8_t oldTileNo, uint8_t newTileNo);
+	
+	int count(uint8_t tileNo) const;
+	bool contains(uint8_t tileNo, const QPoint &position) const;
+	std::vector<QPoint> positions(uint8_t tileNo) const;
+	
+private:
+	int _width = 0;
+	int _words = 0;
+	int _counts[256];
+	std::vector<uint64_t> _bits;
+};
+
+#endif // TILEINDEX_H
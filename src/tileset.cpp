@@ -1,10 +1,17 @@
 #include "tileset.h"
 #include <QByteArray>
+#include <QCoreApplication>
 #include <QFile>
-#include <QPainter>
-#include <cstring>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QStringList>
+#include <QTimer>
+#include <QtConcurrent>
+#include "characterrom.h"
 #include "constants.h"
 #include "tile.h"
+#include "trace.h"
 
 
 static constexpr size_t TILE_COUNT(256);
@@ -15,6 +22,8 @@ static constexpr size_t GLYPH_HEIGHT(8);
 static constexpr size_t TILESET_PET_SIZE = 2817;
 static constexpr size_t TILESET_C64_SIZE = 5121;
 static constexpr char TILESET_PET_MAGIC[2] = { 0x00, 0x49 };
+static constexpr size_t ATTRIBUTES_OFFSET = 0x102;
+static constexpr int RELOAD_DELAY = 100; // ms
 static constexpr Tile::Attribute TILE_ATTRIBUTES[] = {
     Tile::Walkable, Tile::Hoverable, Tile::Movable, Tile::Destructible,
     Tile::ShootThrough, Tile::PushOnto, Tile::Searchable
@@ -33,37 +42,124 @@ static const QRgb COLORS_RGB[16] = { // RGB
 };
 
 
-Tileset::Tileset(QObject *parent) : QObject(parent), _tiles(TILE_COUNT) {
-	readCharacters();
-	_tilesetSize = TILESET_PET_SIZE;
-	_tileset = new uint8_t[_tilesetSize];
-	memset(_tileset, '#', _tilesetSize);
-	createTileImage(0);
+/** The offset of the character in \a row and \a col of tile \a tileNo. */
+static size_t glyphOffset(size_t row, size_t col, uint8_t tileNo) {
+	return 0x202 + col * 0x100 + row * 0x300 + tileNo;
 }
 
 
-Tileset::~Tileset() {
-	for (size_t i = 0; i < _tiles.size(); ++i) {
-		delete _tiles.at(i);
-		_tiles.at(i) = nullptr;
-	}
-	delete[] _tileset;
+/** The offset of the color of the character in \a row and \a col of tile
+ * \a tileNo, in color tilesets.
+ */
+static size_t colorOffset(size_t row, size_t col, uint8_t tileNo) {
+	return TILESET_PET_SIZE + (3 * 256) * row + 256 * col + tileNo + 1;
+}
+
+
+Tileset::Tileset(QObject *parent) : QObject(parent), _tileset(TILESET_PET_SIZE, '#'), _tiles(TILE_COUNT) {
+	_tiles[0] = makeTileImage(_tileset, _palette, 0);
 }
 
 
+Tileset::~Tileset() {}
+
+
+/** Loads the tileset at \a path right away, discarding any #loadAsync() in
+ * progress.
+ */
 QString Tileset::load(const QString &path) {
-	size_t tilesetSize;
+	TRACE_SCOPE("Tileset::load");
+	++_loadGeneration;
+	_loading = false;
+	Decoded decoded = decode(path, _palette);
+	if (decoded.error.isNull()) {
+		apply(decoded);
+	}
+	return decoded.error;
+}
+
+
+/** Loads the tileset from the contents of a tileset file in \a data, e.g.
+ * one bundled in a MapArchive, discarding any #loadAsync() in progress.
+ * Since there is no file, the tileset isn't watched until the next #load().
+ * @return a null string on success, an error message otherwise
+ */
+QString Tileset::loadData(const QByteArray &data) {
+	TRACE_SCOPE("Tileset::loadData");
+	++_loadGeneration;
+	_loading = false;
+	Decoded decoded;
+	decoded.palette = _palette;
+	decoded.error = parse(data, "the tileset", &decoded.tileset);
+	if (not decoded.error.isNull()) { return decoded.error; }
+	
+	decoded.images.resize(TILE_COUNT);
+	for (size_t i = 0; i < TILE_COUNT; ++i) {
+		decoded.images[i] = makeTileImage(decoded.tileset, _palette, i);
+	}
+	apply(decoded);
+	return QString();
+}
+
+
+/** Starts loading the tileset at \a path in the background. #loaded() is
+ * emitted when it's done. If another load is started before that, this one
+ * is discarded.
+ */
+void Tileset::loadAsync(const QString &path) {
+	const int generation = ++_loadGeneration;
+	_loading = true;
+	QFutureWatcher<Decoded> *watcher = new QFutureWatcher<Decoded>(this);
+	connect(watcher, &QFutureWatcher<Decoded>::finished, this, [this, watcher, generation, path]() {
+		watcher->deleteLater();
+		if (generation != _loadGeneration) { return; }
+		Decoded decoded = watcher->result();
+		if (decoded.error.isNull()) {
+			apply(decoded);
+		}
+		_loading = false;
+		emit loaded(path, decoded.error);
+	});
+	watcher->setFuture(QtConcurrent::run(&Tileset::decode, path, _palette));
+}
+
+
+/** Whether a #loadAsync() is in progress. */
+bool Tileset::isLoading() const {
+	return _loading;
+}
+
+
+/** Reads the tileset at \a path and draws its tiles in \a palette. This
+ * doesn't touch any Tileset, so it can run on any thread.
+ */
+Tileset::Decoded Tileset::decode(const QString &path, Palette palette) {
+	TRACE_SCOPE("Tileset::decode");
+	Decoded decoded;
+	decoded.path = path;
+	decoded.palette = palette;
+	
+	decoded.error = read(path, &decoded.tileset);
+	if (not decoded.error.isNull()) { return decoded; }
 	
+	decoded.images.resize(TILE_COUNT);
+	for (size_t i = 0; i < TILE_COUNT; ++i) {
+		decoded.images[i] = makeTileImage(decoded.tileset, palette, i);
+	}
+	return decoded;
+}
+
+
+/** Reads the tileset file at \a path into \a tileset.
+ * @return a null string on success, an error message otherwise
+ */
+QString Tileset::read(const QString &path, std::vector<uint8_t> *tileset) {
 	QFile file(path);
 	if (not file.exists()) {
 		return QString("file \"%1\" does not exist").arg(path);
 	}
 	
-	if (file.size() == TILESET_PET_SIZE) {
-		tilesetSize = TILESET_PET_SIZE;
-	} else if (file.size() == TILESET_C64_SIZE) {
-		tilesetSize = TILESET_C64_SIZE;
-	} else {
+	if (file.size() != TILESET_PET_SIZE and file.size() != TILESET_C64_SIZE) {
 		return QString("file %1 has size %2 but was expected to be size %3 or %4")
 		        .arg(path).arg(file.size()).arg(TILESET_PET_SIZE).arg(TILESET_C64_SIZE);
 	}
@@ -72,55 +168,143 @@ QString Tileset::load(const QString &path) {
 		return QString("can't read file \"%1\": %2").arg(path, file.errorString());
 	}
 	
-	char magicBuffer[sizeof(TILESET_PET_MAGIC)];
-	qint64 bytesRead = file.read(magicBuffer, sizeof(magicBuffer));
-	if (bytesRead != sizeof(magicBuffer)) {
-		return QString("can't read magic of file \"%1\": got only %2 bytes but had requested %3")
-		        .arg(path).arg(bytesRead).arg(sizeof(magicBuffer));
+	const QByteArray data = file.read(TILESET_C64_SIZE);
+	if (data.size() != file.size()) {
+		return QString("can't read file \"%1\": got only %2 bytes but had requested %3")
+		        .arg(path).arg(data.size()).arg(file.size());
+	}
+	return parse(data, QString("file \"%1\"").arg(path), tileset);
+}
+
+
+/** Checks the size and magic of the tileset in \a data, and copies it into
+ * \a tileset. \a what names the source of the data in error messages.
+ * @return a null string on success, an error message otherwise
+ */
+QString Tileset::parse(const QByteArray &data, const QString &what, std::vector<uint8_t> *tileset) {
+	if (size_t(data.size()) != TILESET_PET_SIZE and size_t(data.size()) != TILESET_C64_SIZE) {
+		return QString("%1 has size %2 but was expected to be size %3 or %4")
+		        .arg(what).arg(data.size()).arg(TILESET_PET_SIZE).arg(TILESET_C64_SIZE);
 	}
 	
+	tileset->assign(data.constBegin(), data.constEnd());
 	for (size_t i = 0; i < sizeof(TILESET_PET_MAGIC); ++i) {
-		if (magicBuffer[i] != TILESET_PET_MAGIC[i]) {
-			return QString("file \"%1\" is invalid because its magic (0x%2%3) is wrong "
-                           "(it should be 0x%4%5)")
-			        .arg(path)
-			        .arg(static_cast<unsigned int>(magicBuffer[0]) & 0xFF, 2, 16, QChar('0'))
-			        .arg(static_cast<unsigned int>(magicBuffer[1]) & 0xFF, 2, 16, QChar('0'))
+		if ((*tileset)[i] != uint8_t(TILESET_PET_MAGIC[i])) {
+			return QString("%1 is invalid because its magic (0x%2%3) is wrong "
+			                        "(it should be 0x%4%5)")
+			        .arg(what)
+			        .arg((*tileset)[0], 2, 16, QChar('0'))
+			        .arg((*tileset)[1], 2, 16, QChar('0'))
 			        .arg(static_cast<unsigned int>(TILESET_PET_MAGIC[0]) & 0xFF, 2, 16, QChar('0'))
 			        .arg(static_cast<unsigned int>(TILESET_PET_MAGIC[1]) & 0xFF, 2, 16, QChar('0'));
 		}
 	}
-	
-	const size_t restBufferSize = tilesetSize - sizeof(TILESET_PET_MAGIC);
-	uint8_t *restBuffer = new uint8_t[restBufferSize];
-	bytesRead = file.read(reinterpret_cast<char*>(restBuffer), restBufferSize);
-	if (bytesRead != qint64(restBufferSize)) {
-		delete[] restBuffer;
-		return QString("can't read rest of file \"%1\": got only %2 bytes but had requested %3")
-		        .arg(path).arg(bytesRead).arg(restBufferSize);
+	return QString();
+}
+
+
+/** Replaces the tileset with \a decoded. */
+void Tileset::apply(Decoded &decoded) {
+	watch(decoded.path);
+	_tileset.swap(decoded.tileset);
+	_tiles.swap(decoded.images);
+	if (decoded.palette != _palette and haveColor()) {
+		// the palette was changed while the tileset was loading
+		for (size_t i = 0; i < TILE_COUNT; ++i) {
+			_tiles[i] = makeTileImage(_tileset, _palette, i);
+		}
+	}
+	emit changed();
+}
+
+
+/** Watches \a path for changes, unless it is empty, and stops watching the
+ * previous file.
+ */
+void Tileset::watch(const QString &path) {
+	if (_watcher == nullptr) {
+		_watcher = new QFileSystemWatcher(this);
+		_reloadTimer = new QTimer(this);
+		_reloadTimer->setSingleShot(true);
+		_reloadTimer->setInterval(RELOAD_DELAY);
+		connect(_watcher, &QFileSystemWatcher::fileChanged, _reloadTimer, [this]() { _reloadTimer->start(); });
+		connect(_reloadTimer, &QTimer::timeout, this, &Tileset::reload);
+	}
+	if (not _path.isEmpty()) {
+		_watcher->removePath(_path);
+	}
+	_path = path;
+	if (not _path.isEmpty()) {
+		_watcher->addPath(_path);
+	}
+}
+
+
+/** Rereads the tileset file after it changed on disk. Only the tiles whose
+ * attributes, characters or colors differ are redrawn, and #tilesChanged() is
+ * emitted with their numbers. If the file changed between the PET and the
+ * C64 format, the whole tileset is replaced instead.
+ *
+ * Editors often save by replacing the file, after which the watcher no longer
+ * follows it, so the path is added again.
+ */
+void Tileset::reload() {
+	TRACE_SCOPE("Tileset::reload");
+	if (_path.isEmpty() or isLoading()) { return; }
+	if (not _watcher->files().contains(_path) and QFile::exists(_path)) {
+		_watcher->addPath(_path);
 	}
 	
-	if (tilesetSize != _tilesetSize) {
-		delete[] _tileset;
-		_tileset = new uint8_t[tilesetSize];
-		_tilesetSize = tilesetSize;
+	std::vector<uint8_t> tileset;
+	const QString error = read(_path, &tileset);
+	if (not error.isNull()) {
+		qWarning("Can't reload tileset: %s", qPrintable(error));
+		return;
+	}
+	if (tileset.size() != _tileset.size()) {
+		Decoded decoded = decode(_path, _palette);
+		if (decoded.error.isNull()) { apply(decoded); }
+		return;
 	}
-	memcpy(_tileset, magicBuffer, sizeof(magicBuffer));
-	memcpy(&_tileset[sizeof(magicBuffer)], restBuffer, restBufferSize);
 	
-	for (size_t i = 0; i < TILE_COUNT; ++i) {
-		createTileImage(i);
+	std::vector<uint8_t> tileNos;
+	for (size_t tileNo = 0; tileNo < TILE_COUNT; ++tileNo) {
+		if (tileDiffers(_tileset, tileset, tileNo)) {
+			tileNos.push_back(tileNo);
+		}
 	}
+	if (tileNos.empty()) { return; }
 	
-	emit changed();
-	delete[] restBuffer;
-	return QString();
+	_tileset.swap(tileset);
+	for (uint8_t tileNo : tileNos) {
+		_tiles[tileNo] = makeTileImage(_tileset, _palette, tileNo);
+	}
+	emit tilesChanged(tileNos);
+}
+
+
+/** Whether tile \a tileNo has different attributes, characters or colors in
+ * \a a and \a b, which must be of the same size.
+ */
+bool Tileset::tileDiffers(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b, uint8_t tileNo) {
+	Q_ASSERT(a.size() == b.size());
+	const size_t offset = ATTRIBUTES_OFFSET + tileNo;
+	if (a[offset] != b[offset]) { return true; }
+	for (size_t row = 0; row < TILE_HEIGHT; ++row) {
+		for (size_t col = 0; col < TILE_WIDTH; ++col) {
+			const size_t glyph = glyphOffset(row, col, tileNo);
+			if (a[glyph] != b[glyph]) { return true; }
+			const size_t color = colorOffset(row, col, tileNo);
+			if (color < a.size() and a[color] != b[color]) { return true; }
+		}
+	}
+	return false;
 }
 
 
 Tile Tileset::tile(uint8_t tileNo) const {
 	QFlags<Tile::Attribute> flags;
-	uint8_t f = _tileset[0x102 + tileNo];
+	uint8_t f = _tileset[ATTRIBUTES_OFFSET + tileNo];
 	for (Tile::Attribute attribute : TILE_ATTRIBUTES) {
 		flags.setFlag(attribute, f & attribute);
 	}
@@ -140,7 +324,7 @@ QSize Tileset::tileSize() const {
 
 
 bool Tileset::haveColor() const {
-	return _tilesetSize == TILESET_C64_SIZE;
+	return _tileset.size() == TILESET_C64_SIZE;
 }
 
 
@@ -155,12 +339,13 @@ Tileset::Palette Tileset::palette() const {
 
 
 void Tileset::setPalette(Tileset::Palette palette) {
+	TRACE_SCOPE("Tileset::setPalette");
 	if (palette != _palette) {
 		_palette = palette;
 		
 		if (haveColor()) {
 			for (size_t i = 0; i < TILE_COUNT; ++i) {
-				createTileImage(i);
+				_tiles[i] = makeTileImage(_tileset, _palette, i);
 			}
 			
 			emit changed();
@@ -169,6 +354,29 @@ void Tileset::setPalette(Tileset::Palette palette) {
 }
 
 
+/** The path of the tileset bundled with the application, either the PET
+ * (`tileset.pet`) or the color PETSCII one (`tileset.c64`). Returns a null
+ * string if it can't be found.
+ */
+QString Tileset::bundledPath(bool color) {
+	QStringList directories = {
+#ifdef Q_OS_UNIX
+		QString("%1/../share/%2").arg(QCoreApplication::applicationDirPath(),
+		                              QFileInfo(QCoreApplication::applicationFilePath()).baseName()),
+	    QString("%1/../share").arg(QCoreApplication::applicationDirPath()),
+#endif
+		QCoreApplication::applicationDirPath(),
+	};
+	for (const QString &dir : directories) {
+		const QString path = dir + "/tileset." + (color ? "c64" : "pet");
+		if (QFile::exists(path)) {
+			return path;
+		}
+	}
+	return QString();
+}
+
+
 Tileset::Palette Tileset::paletteFromInt(int value) {
 	switch (value) {
 	case int(Palette::CoCo): return Palette::CoCo;
@@ -193,8 +401,8 @@ QString Tileset::toString(Tileset::Palette palette) {
 }
 
 
-const QRgb *Tileset::colors() const {
-	switch (_palette) {
+const QRgb *Tileset::colors(Palette palette) {
+	switch (palette) {
 	case Palette::CoCo: return COLORS_COCO;
 	case Palette::Colodore: return COLORS_COLODORE;
 	case Palette::RGB: return COLORS_RGB;
@@ -202,78 +410,42 @@ const QRgb *Tileset::colors() const {
 }
 
 
-QImage Tileset::characterImage(uint8_t c) const {
-	bool invert = c & 0x80;
-	bool shift8 = (c & 0xC0) == 0x40;
-	bool shift4 = (c & 0xE0) == 0x00;
-	bool sub4 = (c & 0xC0) == 0x80;
-	if (c == '\0') { c = '@'; }
-	else if (shift8) { c ^= 0x80; }
-	else if (shift4) { c ^= 0x40; }
-	else if (sub4) { c -= 0x40; }
-
-	int row = (0xFF & c) / 16;
-	int col = (0xFF & c) % 16;
-	QImage image = _characters.copy(col * GLYPH_WIDTH, row * GLYPH_HEIGHT,
-	                                GLYPH_WIDTH, GLYPH_HEIGHT);
-
-	if (invert) {  image.invertPixels(); }
-	return image;
-}
-
-
-void Tileset::readCharacters() {
-	static const QString filename = ":/characters.png";
-	
-	QFile file(filename);
-	if (not file.exists()) {
-		qWarning("file \"%s\" does not exist", filename.toUtf8().constData());
-		return;
-	}
-
-	if (_characters.load(&file, nullptr)) {
-		_characters = _characters.convertToFormat(IMAGE_FORMAT);
-	} else {
-		qWarning("cannot load file \"%s\"", filename.toUtf8().constData());
-	}
-}
-
-
-void Tileset::createTileImage(uint8_t tileNo) {
-	QImage *image = new QImage(tileSize(), IMAGE_FORMAT);
-	_tiles.at(tileNo) = image;
-	
-	QPainter painter(image);
+/** Draws tile \a tileNo of \a tileset from the glyphs in CharacterRom, in
+ * white or in its color if the tileset has colors, on black.
+ */
+QImage Tileset::makeTileImage(const std::vector<uint8_t> &tileset, Palette palette, uint8_t tileNo) {
+	QImage image(GLYPH_WIDTH * TILE_WIDTH, GLYPH_HEIGHT * TILE_HEIGHT, IMAGE_FORMAT);
+	const bool haveColor = tileset.size() == TILESET_C64_SIZE;
 	for (size_t row = 0; row < TILE_HEIGHT; ++row) {
 		for (size_t col = 0; col < TILE_WIDTH; ++col) {
 			Q_ASSERT(TILE_WIDTH == 3 and TILE_HEIGHT == 3);
-			const size_t index = 0x202 + col * 0x100 + row * 0x300 + tileNo;
-			const uint8_t c = index < _tilesetSize ? _tileset[index] : ' ';
-			QImage image = characterImage(c);
-			if (haveColor()) {
-				constexpr size_t colorBaseOffset = TILESET_PET_SIZE;
-				const size_t offset = colorBaseOffset + (3 * 256) * row + 256 * col + tileNo + 1;
-				if (offset < _tilesetSize) {
-					const uint8_t fgColorNum = _tileset[offset] & 0x0F;
-					const QRgb fg = colors()[fgColorNum];
-					const QRgb bg = 0xFF000000;
-					for (int y = 0; y < image.width(); ++y) {
-						for (int x = 0; x < image.height(); ++x) {
-							image.setPixel(x, y, image.pixel(x, y) == 0xFFFFFFFF ? fg : bg);
-						}
-					}
+			const size_t index = glyphOffset(row, col, tileNo);
+			const uint8_t c = index < tileset.size() ? tileset[index] : ' ';
+			QRgb fg = 0xFFFFFFFF;
+			const QRgb bg = 0xFF000000;
+			if (haveColor) {
+				const size_t offset = colorOffset(row, col, tileNo);
+				if (offset < tileset.size()) {
+					fg = colors(palette)[tileset[offset] & 0x0F];
+				}
+			}
+			const uint8_t *glyph = CharacterRom::GLYPHS[CharacterRom::Upper][c];
+			for (size_t y = 0; y < GLYPH_HEIGHT; ++y) {
+				QRgb *pixel = reinterpret_cast<QRgb*>(image.scanLine(row * GLYPH_HEIGHT + y)) + col * GLYPH_WIDTH;
+				for (size_t x = 0; x < GLYPH_WIDTH; ++x) {
+					pixel[x] = glyph[y] & (0x80 >> x) ? fg : bg;
 				}
 			}
-			painter.drawImage(col * GLYPH_WIDTH, row * GLYPH_HEIGHT, image);
 		}
 	}
+	return image;
 }
 
 
 const QImage &Tileset::tileImage(uint8_t tileNo) const {
-	const QImage *pImage = _tiles.at(tileNo);
-	if (pImage) {
-		return *pImage;
+	const QImage &image = _tiles.at(tileNo);
+	if (not image.isNull()) {
+		return image;
 	}
-	return *_tiles.at(0); // first image is created in the constructor and always exists
+	return _tiles.at(0); // the first image is created in the constructor and always exists
 }
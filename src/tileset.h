@@ -1,20 +1,31 @@
 #ifndef TILESET_H
 #define TILESET_H
 
+#include <QByteArray>
 #include <QImage>
 #include <QObject>
 #include <QSize>
 #include <QString>
+#include <cstdint>
 #include <forward_list>
 #include <vector>
 
+class QFileSystemWatcher;
+class QTimer;
 class Tile;
 
 
 /**
  * A tile set of 256 3x3 character tiles.
  * 
- * Should be loaded from `tileset.pet`.
+ * Should be loaded from `tileset.pet`, either synchronously with #load(), or
+ * with #loadAsync(), which reads the file and draws the tiles on a worker
+ * thread. Either way, all tiles are replaced at once, and #changed() is
+ * emitted. #isValid() is false until a tileset has been loaded.
+ *
+ * The loaded file is watched, and reloaded when it changes on disk. A reload
+ * compares the new file to the old one tile by tile, redraws only the tiles
+ * that differ, and emits #tilesChanged() with their numbers.
  */
 class Tileset : public QObject {
 	Q_OBJECT
@@ -29,6 +40,9 @@ public:
 	 *  @return a null string on success, an error message otherwise.
 	 */
 	QString load(const QString &path);
+	QString loadData(const QByteArray &data);
+	void loadAsync(const QString &path);
+	bool isLoading() const;
 	Tile tile(uint8_t tileNo) const;
 	
 	size_t tileCount() const;
@@ -40,26 +54,46 @@ public:
 	Palette palette() const;
 	void setPalette(Palette palette);
 	
+	static QString bundledPath(bool color);
 	static Palette paletteFromInt(int value);
 	static std::forward_list<Palette> palettes();
 	static QString toString(Palette palette);
 	
 signals:
 	void changed();
+	void loaded(const QString &path, const QString &error);
+	void tilesChanged(const std::vector<uint8_t> &tileNos);
 	
 private:
-	const QRgb *colors() const;
+	/** A tileset read from a file, with its tile images. */
+	struct Decoded {
+		QString error;
+		QString path;
+		std::vector<uint8_t> tileset;
+		std::vector<QImage> images;
+		Palette palette;
+	};
 	
-	QImage characterImage(uint8_t c) const;
-	void readCharacters();
-	void createTileImage(uint8_t tileNo);
+	static Decoded decode(const QString &path, Palette palette);
+	static QString read(const QString &path, std::vector<uint8_t> *tileset);
+	static QString parse(const QByteArray &data, const QString &what, std::vector<uint8_t> *tileset);
+	void apply(Decoded &decoded);
+	void watch(const QString &path);
+	void reload();
+	static bool tileDiffers(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b, uint8_t tileNo);
+	
+	static const QRgb *colors(Palette palette);
+	static QImage makeTileImage(const std::vector<uint8_t> &tileset, Palette palette, uint8_t tileNo);
 	const QImage &tileImage(uint8_t tileNo) const;
 	
-	QImage _characters;
-	uint8_t *_tileset = nullptr;
-	size_t _tilesetSize;
-	std::vector<const QImage*> _tiles;
+	std::vector<uint8_t> _tileset;
+	std::vector<QImage> _tiles;
 	Palette _palette = Palette::CoCo;
+	int _loadGeneration = 0;
+	bool _loading = false;
+	QString _path;
+	QFileSystemWatcher *_watcher = nullptr;
+	QTimer *_reloadTimer = nullptr;
 };
 
 #endif // TILESET_H
@@ -55,7 +55,7 @@ void TileWidget::mousePressEvent(QMouseEvent *event) {
 
 void TileWidget::paintEvent(QPaintEvent *event) {
 	Q_UNUSED(event);
-	if (tileset() == nullptr) { return; }
+	if (tileset() == nullptr or drawPlaceholder()) { return; }
 	QPainter painter(this);
 	
 	// draw tiles
@@ -105,6 +105,21 @@ void TileWidget::tilesetChanged() {
 }
 
 
+void TileWidget::tilesChanged(const std::vector<uint8_t> &tileNos) {
+	if (_image == nullptr) {
+		makeImage();
+	} else {
+		QPainter painter(_image);
+		painter.setPen(Qt::NoPen);
+		painter.setBrush(Qt::darkGray);
+		for (uint8_t tileNo : tileNos) {
+			drawTile(painter, tileNo);
+		}
+	}
+	update();
+}
+
+
 QSize TileWidget::tileSize() const {
 	return tileset()->tileSize() + QSize(2 * TILE_MARGIN, 2 * TILE_MARGIN);
 }
@@ -125,14 +140,19 @@ void TileWidget::makeImage() {
 	painter.setBrush(Qt::darkGray);
 	
 	for (int tileNo = 0; tileNo < 256; ++tileNo) {
-		const Tile tile = tileset()->tile(tileNo);
-		const QRect r = tileRect(tileNo, false);
-		drawMargin(painter, r, TILE_MARGIN);
-		painter.drawImage(r.topLeft(), tile.image());
+		drawTile(painter, tileNo);
 	}
 }
 
 
+void TileWidget::drawTile(QPainter &painter, uint8_t tileNo) {
+	const Tile tile = tileset()->tile(tileNo);
+	const QRect r = tileRect(tileNo, false);
+	drawMargin(painter, r, TILE_MARGIN);
+	painter.drawImage(r.topLeft(), tile.image());
+}
+
+
 int TileWidget::tileColumns() const {
 	return 2 / scale();
 }
@@ -8,6 +8,7 @@
 #include "abstracttilewidget.h"
 
 class QImage;
+class QPainter;
 class Tileset;
 
 
@@ -31,11 +32,13 @@ protected:
 	void highlightAttributeChanged() override;
 	void scaleChanged() override;
 	void tilesetChanged() override;
+	void tilesChanged(const std::vector<uint8_t> &tileNos) override;
 	
 private:
 	QSize tileSize() const;
 	QSize imageSize() const;
 	void makeImage();
+	void drawTile(QPainter &painter, uint8_t tileNo);
 	int tileColumns() const;
 	int rowsPerColumn() const;
 	QRect tileRect(uint8_t tileNo, bool withMargin = true) const;
@@ -0,0 +1,205 @@
+#include "trace.h"
+
+#ifdef ENABLE_TRACING
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+
+/** @class Trace
+ * Collects timings of code sections and values of counters, and writes them
+ * as a trace in Chrome's JSON trace event format, which can be viewed with
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing is only compiled in when ENABLE_TRACING is defined, which
+ * `qmake CONFIG+=tracing` does. Code is instrumented with the TRACE_SCOPE()
+ * and TRACE_COUNTER() macros, which expand to nothing otherwise:
+ *
+ *     void Map::floodFill(const QPoint &position, uint8_t tileNo) {
+ *         TRACE_SCOPE("Map::floodFill");
+ *         ...
+ *     }
+ *
+ * Scope names are string literals of the form `Class::function`; the part
+ * before `::` becomes the event category. Events are recorded from the start
+ * of the program until MAX_EVENTS is reached, or until recording is turned
+ * off. Independently of that, the durations of the last RECENT_COUNT runs of
+ * each scope and the last value of each counter are kept for
+ * #statistics() and #counterValue(), which the performance overlay shows.
+ */
+
+
+namespace {
+
+static constexpr size_t MAX_EVENTS = 1000000;
+static constexpr int RECENT_COUNT = 60;
+
+struct Event {
+	const char *name;
+	qint64 start; ///< nanoseconds
+	qint64 value; ///< the duration in nanoseconds for spans, the value for counters
+	quintptr thread;
+	bool isCounter;
+};
+
+struct Recent {
+	std::array<qint64, RECENT_COUNT> durations = {};
+	int count = 0;
+};
+
+struct State {
+	QMutex mutex;
+	QElapsedTimer timer;
+	bool recording = true;
+	std::vector<Event> events;
+	QHash<QByteArray, Recent> recent;
+	QHash<QByteArray, qint64> counters;
+	
+	State() { timer.start(); }
+};
+
+State &state() {
+	static State state;
+	return state;
+}
+
+} // namespace
+
+
+Trace::Scope::Scope(const char *name) : _name(name), _start(now()) {}
+
+
+Trace::Scope::~Scope() {
+	addSpan(_name, _start, now());
+}
+
+
+/** Records \a value for the counter \a name. */
+void Trace::counter(const char *name, qint64 value) {
+	State &s = state();
+	const qint64 time = now();
+	QMutexLocker locker(&s.mutex);
+	s.counters[QByteArray(name)] = value;
+	if (s.recording and s.events.size() < MAX_EVENTS) {
+		s.events.push_back({ name, time, value, quintptr(QThread::currentThreadId()), true });
+	}
+}
+
+
+/** The last value recorded for the counter \a name, or 0. */
+qint64 Trace::counterValue(const char *name) {
+	State &s = state();
+	QMutexLocker locker(&s.mutex);
+	return s.counters.value(QByteArray(name));
+}
+
+
+/** Statistics over the recent runs of the scope \a name. */
+Trace::Statistics Trace::statistics(const char *name) {
+	State &s = state();
+	QMutexLocker locker(&s.mutex);
+	Statistics statistics;
+	const auto it = s.recent.constFind(QByteArray(name));
+	if (it == s.recent.constEnd() or it->count == 0) { return statistics; }
+	const int count = std::min(it->count, RECENT_COUNT);
+	qint64 sum = 0;
+	for (int i = 0; i < count; ++i) {
+		sum += it->durations[i];
+		statistics.max = std::max(statistics.max, it->durations[i]);
+	}
+	statistics.last = it->durations[(it->count - 1) % RECENT_COUNT];
+	statistics.average = sum / count;
+	return statistics;
+}
+
+
+bool Trace::isRecording() {
+	State &s = state();
+	QMutexLocker locker(&s.mutex);
+	return s.recording;
+}
+
+
+void Trace::setRecording(bool recording) {
+	State &s = state();
+	QMutexLocker locker(&s.mutex);
+	s.recording = recording;
+}
+
+
+/** Discards the recorded events. */
+void Trace::clear() {
+	State &s = state();
+	QMutexLocker locker(&s.mutex);
+	s.events.clear();
+}
+
+
+/** Writes the recorded events to \a path.
+ * @return a null string on success, an error message otherwise
+ */
+QString Trace::write(const QString &path) {
+	State &s = state();
+	QSaveFile file(path);
+	if (not file.open(QFile::WriteOnly)) {
+		return QString("cannot open \"%1\" for writing: %2").arg(path, file.errorString());
+	}
+	
+	QMutexLocker locker(&s.mutex);
+	QHash<quintptr, int> threadIds;
+	QTextStream out(&file);
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for (const Event &event : s.events) {
+		const int tid = threadIds.value(event.thread, threadIds.size() + 1);
+		threadIds.insert(event.thread, tid);
+		const QByteArray name(event.name);
+		const int separator = name.indexOf("::");
+		const QByteArray category = separator > 0 ? name.left(separator) : QByteArray("app");
+		out << (first ? "\n" : ",\n");
+		first = false;
+		out << "{\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"pid\":1,\"tid\":" << tid
+		    << ",\"ts\":" << QString::number(event.start / 1000.0, 'f', 3);
+		if (event.isCounter) {
+			out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+		} else {
+			out << ",\"ph\":\"X\",\"dur\":" << QString::number(event.value / 1000.0, 'f', 3) << "}";
+		}
+	}
+	out << "\n]}\n";
+	out.flush();
+	locker.unlock();
+	
+	if (not file.commit()) {
+		return QString("cannot write to \"%1\": %2").arg(path, file.errorString());
+	}
+	return QString();
+}
+
+
+void Trace::addSpan(const char *name, qint64 start, qint64 end) {
+	State &s = state();
+	QMutexLocker locker(&s.mutex);
+	Recent &recent = s.recent[QByteArray::fromRawData(name, qstrlen(name))];
+	recent.durations[recent.count % RECENT_COUNT] = end - start;
+	++recent.count;
+	if (s.recording and s.events.size() < MAX_EVENTS) {
+		s.events.push_back({ name, start, end - start, quintptr(QThread::currentThreadId()), false });
+	}
+}
+
+
+qint64 Trace::now() {
+	return state().timer.nsecsElapsed();
+}
+
+#endif // ENABLE_TRACING
@@ -0,0 +1,57 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifdef ENABLE_TRACING
+
+#include <QString>
+#include <QtGlobal>
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) const Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_COUNTER(name, value) Trace::counter(name, value)
+
+
+class Trace {
+public:
+	/** Records the time from its construction to its destruction. */
+	class Scope {
+	public:
+		explicit Scope(const char *name);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope &operator=(const Scope&) = delete;
+	private:
+		const char *const _name;
+		const qint64 _start;
+	};
+	
+	/** Durations of the recent runs of a scope, in nanoseconds. */
+	struct Statistics {
+		qint64 last = 0;
+		qint64 average = 0;
+		qint64 max = 0;
+	};
+	
+	static void counter(const char *name, qint64 value);
+	static qint64 counterValue(const char *name);
+	static Statistics statistics(const char *name);
+	
+	static bool isRecording();
+	static void setRecording(bool recording);
+	static void clear();
+	static QString write(const QString &path);
+	
+private:
+	static void addSpan(const char *name, qint64 start, qint64 end);
+	static qint64 now();
+};
+
+#else
+
+#define TRACE_SCOPE(name) do {} while (false)
+#define TRACE_COUNTER(name, value) do {} while (false)
+
+#endif // ENABLE_TRACING
+
+#endif // TRACE_H
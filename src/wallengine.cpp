@@ -0,0 +1,139 @@
+#include "wallengine.h"
+#include "map.h"
+
+
+/** @class WallEngine
+ * Picks the right wall tile for each wall, depending on how it connects to
+ * its neighbors. Works on a plain tile buffer, so the result can be compared
+ * to the map before committing it.
+ *
+ * A wall's shape is determined by a 6 bit attribute:
+ *
+ * | Bit | Value | Meaning                                            |
+ * |-----|-------|----------------------------------------------------|
+ * | 0   | 1     | connects to the left                               |
+ * | 1   | 2     | connects to the top                                |
+ * | 2   | 4     | connects to the right                              |
+ * | 3   | 8     | connects to the bottom                             |
+ * | 4   | 16    | the tile below connects to its right               |
+ * | 5   | 32    | the tile to the right connects to its bottom       |
+ *
+ * Each neighbor contributes a fixed set of bits depending only on its tile
+ * number and which side it is on. These contributions are precomputed from
+ * Map::wallFlags() into one 256 entry table per side, so the attribute is
+ * just four lookups.
+ *
+ * The bits a wall contributes as a neighbor never depend on its left or top
+ * neighbor. Walls are therefore updated from the bottom right to the top
+ * left, so every neighbor they depend on is already final.
+ */
+
+
+namespace {
+struct NeighborTables {
+	uint8_t left[256];   ///< bits contributed by the tile to the left
+	uint8_t top[256];    ///< bits contributed by the tile above
+	uint8_t right[256];  ///< bits contributed by the tile to the right
+	uint8_t bottom[256]; ///< bits contributed by the tile below
+	bool wall[256];      ///< whether the tile is a generic wall
+	
+	NeighborTables() {
+		typedef Map::WallFlag F;
+		for (int tileNo = 0; tileNo < 256; ++tileNo) {
+			const Map::WallFlags flags = Map::wallFlags(tileNo);
+			const bool generic = flags.testFlag(F::Generic);
+			wall[tileNo] = generic;
+			left[tileNo] = (generic or flags.testFlag(F::ConnRight)) ? 1 : 0;
+			top[tileNo] = (generic or flags.testFlag(F::ConnBottom)) ? 2 : 0;
+			right[tileNo] = ((generic or flags.testFlag(F::ConnLeft)) ? 4 : 0)
+			        | (flags.testFlag(F::ConnBottom) ? 32 : 0);
+			bottom[tileNo] = ((generic or flags.testFlag(F::ConnTop)) ? 8 : 0)
+			        | (flags.testFlag(F::ConnRight) ? 16 : 0);
+		}
+	}
+};
+} // namespace
+
+
+static const NeighborTables TABLES;
+
+static constexpr uint8_t WALL_TILE_BY_ATTRIBUTE[64] = {
+    0x04, 0x11, 0x0b, 0x13, 0x10, 0x05, 0x10, 0x05, // connect to: 0, l, t, lt, r, lr, tr, lrt,
+    0x0f, 0x0f, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, // connect to: b, lb, tb, ltb, rb, lrb, trb, lrtb,
+    
+    // same, but there is a wall going right below
+    0x1a, 0x1a, 0x0c, 0x0c, 0x10, 0x05, 0x10, 0x05, // last 4 don't fit well
+    0x1a, 0x1a, 0x0c, 0x0c, 0x04, 0x05, 0x0c, 0x04, // last 4 don't fit well
+    
+    // same, but there is a wall going to the bottom on the right
+    0x12, 0x06, 0x12, 0x06, 0x12, 0x06, 0x12, 0x06, // tile 0x12 is missing the right border
+    0x0f, 0x0f, 0x08, 0x08, 0x04, 0x04, 0x08, 0x04, // none of these fit well
+    
+    // same, but there is a wall going right below, and a wall going to the bottom on the right
+    0x1a, 0x11, 0x0b, 0x13, 0x12, 0x06, 0x12, 0x06, // none of these fit well
+    0x1a, 0x1a, 0x0c, 0x0c, 0x04, 0x06, 0x0c, 0x06, // none of these fit well
+};
+
+
+/** Operate on the row by row buffer \a tiles of size \a width × \a height. */
+WallEngine::WallEngine(uint8_t *tiles, int width, int height)
+    : _tiles(tiles), _width(width), _height(height) {}
+
+
+/** Put a wall at \a position, and adjust the walls around it so they connect
+ * to it.
+ */
+void WallEngine::drawWall(const QPoint &position) {
+	const int x = position.x();
+	const int y = position.y();
+	Q_ASSERT(0 <= x and x < _width and 0 <= y and y < _height);
+	
+	_tiles[x + _width * y] = WALL_TILE_BY_ATTRIBUTE[0];
+	
+	// bottom right to top left, see the class description
+	static const QPoint order[] = { { 0, 1 }, { 1, 0 }, { 0, 0 }, { -1, 0 }, { 0, -1 }, { -1, -1 } };
+	for (const QPoint &offset : order) {
+		const int nx = x + offset.x();
+		const int ny = y + offset.y();
+		if (0 <= nx and nx < _width and 0 <= ny and ny < _height and TABLES.wall[tileAt(nx, ny)]) {
+			updateWall(nx, ny);
+		}
+	}
+}
+
+
+/** Recompute every wall within \a rect in a single sweep. Tiles outside of
+ * \a rect are taken into account, but not modified.
+ */
+void WallEngine::rewall(const QRect &rect) {
+	const QRect r = rect & QRect(0, 0, _width, _height);
+	for (int y = r.bottom(); y >= r.top(); --y) {
+		for (int x = r.right(); x >= r.left(); --x) {
+			if (TABLES.wall[tileAt(x, y)]) {
+				updateWall(x, y);
+			}
+		}
+	}
+}
+
+
+/** Whether \a tileNo is one of the generic wall tiles that this engine
+ * manages.
+ */
+bool WallEngine::isWall(uint8_t tileNo) {
+	return TABLES.wall[tileNo];
+}
+
+
+void WallEngine::updateWall(int x, int y) {
+	const uint8_t attribute = TABLES.left[tileAt(x - 1, y)] | TABLES.top[tileAt(x, y - 1)]
+	        | TABLES.right[tileAt(x + 1, y)] | TABLES.bottom[tileAt(x, y + 1)];
+	_tiles[x + _width * y] = WALL_TILE_BY_ATTRIBUTE[attribute];
+}
+
+
+/** The tile at (\a x, \a y), or 0 if that lies outside the buffer. */
+uint8_t WallEngine::tileAt(int x, int y) const {
+	if (x < 0 or x >= _width or y < 0 or y >= _height) { return 0; }
+	return _tiles[x + _width * y];
+}
@@ -0,0 +1,27 @@
+#ifndef WALLENGINE_H
+#define WALLENGINE_H
+
+#include <QPoint>
+#include <QRect>
+#include <cstdint>
+
+
+class WallEngine {
+public:
+	WallEngine(uint8_t *tiles, int width, int height);
+	
+	void drawWall(const QPoint &position);
+	void rewall(const QRect &rect);
+	
+	static bool isWall(uint8_t tileNo);
+	
+private:
+	void updateWall(int x, int y);
+	uint8_t tileAt(int x, int y) const;
+	
+	uint8_t *const _tiles;
+	const int _width;
+	const int _height;
+};
+
+#endif // WALLENGINE_H
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+
+#
+# Creates src/characterrom.h, the PETSCII character glyphs used to draw tiles,
+# from res/characters.png and res/characters-lower.png. Run it from the
+# repository root after changing either image:
+#
+#     tools/make-character-rom.py > src/characterrom.h
+#
+# The images hold 16x16 glyphs of 8x8 pixels, ordered by PETSCII code. The
+# table is indexed by screen code instead, which is what tilesets store, so
+# the conversion and the inversion of the upper 128 screen codes happen here
+# rather than at run time.
+#
+
+import struct
+import sys
+import zlib
+
+GLYPH_SIZE = 8
+IMAGES = [("Upper", "res/characters.png"), ("Lower", "res/characters-lower.png")]
+
+
+def read_png(path):
+    """Returns the rows of a 1 bit palette PNG as lists of booleans, True
+    for pixels brighter than half."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        sys.exit("%s: not a PNG file" % path)
+    pos = 8
+    idat = b""
+    palette = []
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+            if depth != 1 or color_type != 3 or interlace != 0:
+                sys.exit("%s: expected a non-interlaced 1 bit palette image" % path)
+        elif kind == b"PLTE":
+            palette = [sum(chunk[i:i + 3]) > 3 * 127 for i in range(0, len(chunk), 3)]
+        elif kind == b"IDAT":
+            idat += chunk
+    raw = zlib.decompress(idat)
+    stride = (width + 7) // 8
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        method = raw[start]
+        line = bytearray(raw[start + 1:start + 1 + stride])
+        for i in range(stride):
+            left = line[i - 1] if i > 0 else 0
+            up = previous[i]
+            up_left = previous[i - 1] if i > 0 else 0
+            if method == 1:
+                line[i] = (line[i] + left) & 0xff
+            elif method == 2:
+                line[i] = (line[i] + up) & 0xff
+            elif method == 3:
+                line[i] = (line[i] + (left + up) // 2) & 0xff
+            elif method == 4:
+                p = left + up - up_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+                predictor = left if pa <= pb and pa <= pc else up if pb <= pc else up_left
+                line[i] = (line[i] + predictor) & 0xff
+        previous = line
+        rows.append([palette[(line[x // 8] >> (7 - x % 8)) & 1] for x in range(width)])
+    return rows
+
+
+def petscii_code(screen_code):
+    """The PETSCII code of the glyph for a screen code, and whether it is
+    inverted. Matches the layout of the character images."""
+    c = screen_code
+    invert = c & 0x80 != 0
+    if c == 0:
+        c = ord("@")
+    elif c & 0xc0 == 0x40:
+        c ^= 0x80
+    elif c & 0xe0 == 0x00:
+        c ^= 0x40
+    elif c & 0xc0 == 0x80:
+        c -= 0x40
+    return c, invert
+
+
+def glyph_rows(pixels, screen_code):
+    code, invert = petscii_code(screen_code)
+    left = (code % 16) * GLYPH_SIZE
+    top = (code // 16) * GLYPH_SIZE
+    rows = []
+    for y in range(top, top + GLYPH_SIZE):
+        byte = 0
+        for x in range(left, left + GLYPH_SIZE):
+            byte = (byte << 1) | (pixels[y][x] != invert)
+        rows.append(byte)
+    return rows
+
+
+def main():
+    out = sys.stdout
+    out.write("#ifndef CHARACTERROM_H\n#define CHARACTERROM_H\n\n")
+    out.write("// generated by tools/make-character-rom.py, do not edit\n\n")
+    out.write("#include <cstdint>\n\n")
+    out.write("/** The glyphs of the PETSCII character sets, indexed by screen code. Each\n"
+              " * glyph has eight rows of eight pixels, the most significant bit being the\n"
+              " * leftmost pixel. A set bit is a foreground pixel.\n */\n")
+    out.write("namespace CharacterRom {\n\n")
+    out.write("enum CharacterSet { %s };\n\n" % ", ".join(name for name, _ in IMAGES))
+    out.write("static constexpr uint8_t GLYPHS[%d][256][8] = {\n" % len(IMAGES))
+    for name, path in IMAGES:
+        pixels = read_png(path)
+        out.write("\t{ // %s\n" % name)
+        for screen_code in range(256):
+            rows = ", ".join("0x%02x" % row for row in glyph_rows(pixels, screen_code))
+            out.write("\t\t{ %s }, // 0x%02x\n" % (rows, screen_code))
+        out.write("\t},\n")
+    out.write("};\n\n")
+    out.write("} // namespace CharacterRom\n\n#endif // CHARACTERROM_H\n")
+
+
+if __name__ == "__main__":
+    main()